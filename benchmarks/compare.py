@@ -0,0 +1,89 @@
+"""Comparison report of ``benchmarks.suite`` results.
+
+The first file is the baseline, for the rest of them every case
+is reported with the ratio of its baseline median to its own one,
+so values above one mean speedups.
+
+Run from the project root with
+``python -m benchmarks.compare fractions.json cfractions.json fallback.json``
+(``--markdown`` formats the report as a table for pull requests).
+"""
+
+from __future__ import annotations
+
+import argparse
+import sys
+from statistics import geometric_mean
+
+import pyperf
+
+
+def to_time_string(seconds: float) -> str:
+    for unit, scale in (('s', 1.0), ('ms', 1e-3), ('us', 1e-6)):
+        if seconds >= scale:
+            return f'{seconds / scale:.2f}{unit}'
+    return f'{seconds / 1e-9:.0f}ns'
+
+
+def load_medians(path: str) -> tuple[str, dict[str, float]]:
+    suite = pyperf.BenchmarkSuite.load(path)
+    medians = {
+        benchmark.get_name(): benchmark.median()
+        for benchmark in suite.get_benchmarks()
+    }
+    return suite.get_metadata().get('fractions_implementation', path), medians
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser()
+    parser.add_argument('paths', nargs='+')
+    parser.add_argument('--markdown', action='store_true')
+    args = parser.parse_args()
+    (baseline_name, baseline), *others = map(load_medians, args.paths)
+    header = ['case', baseline_name, *(name for name, _ in others)]
+    rows = []
+    ratios: list[list[float]] = [[] for _ in others]
+    for case, baseline_median in baseline.items():
+        row = [case, to_time_string(baseline_median)]
+        for (_, medians), case_ratios in zip(others, ratios, strict=True):
+            median = medians.get(case)
+            if median is None:
+                row.append('-')
+                continue
+            ratio = baseline_median / median
+            case_ratios.append(ratio)
+            row.append(f'{to_time_string(median)} ({ratio:.2f}x)')
+        rows.append(row)
+    rows.append(
+        [
+            'geometric mean',
+            '',
+            *(
+                f'{geometric_mean(case_ratios):.2f}x' if case_ratios else '-'
+                for case_ratios in ratios
+            ),
+        ]
+    )
+    if args.markdown:
+        lines = [header, ['---'] * len(header), *rows]
+        sys.stdout.writelines(
+            '| ' + ' | '.join(line) + ' |\n' for line in lines
+        )
+        return
+    widths = [
+        max(len(row[index]) for row in (header, *rows))
+        for index in range(len(header))
+    ]
+    for row in (header, *rows):
+        sys.stdout.write(
+            row[0].ljust(widths[0])
+            + ''.join(
+                '  ' + cell.rjust(width)
+                for cell, width in zip(row[1:], widths[1:], strict=True)
+            )
+            + '\n'
+        )
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,75 @@
+"""Benchmarks of floor division, remainder & ``divmod`` of fractions.
+
+Run from the project root with ``python -m benchmarks.division``.
+"""
+
+from __future__ import annotations
+
+import fractions
+import operator
+import random
+import sys
+import timeit
+from collections.abc import Callable
+from typing import Any
+
+import cfractions
+
+OPERATIONS: dict[str, Callable[[Any, Any], Any]] = {
+    '//': operator.floordiv,
+    '%': operator.mod,
+    'divmod': divmod,
+}
+SIZES = {'word': 60, 'large': 1_000, 'huge': 10_000}
+
+
+def to_operands(
+    bit_length: int, seed: int = 0
+) -> tuple[tuple[int, int], tuple[int, int]]:
+    generator = random.Random(seed)
+    return (
+        (
+            generator.getrandbits(bit_length),
+            generator.getrandbits(bit_length) | 1,
+        ),
+        (
+            generator.getrandbits(bit_length // 2) | 1,
+            generator.getrandbits(bit_length) | 1,
+        ),
+    )
+
+
+def measure(
+    operation: Callable[[Any, Any], Any], dividend: Any, divisor: Any
+) -> float:
+    timer = timeit.Timer(lambda: operation(dividend, divisor))
+    number, _ = timer.autorange()
+    return min(timer.repeat(repeat=5, number=number)) / number
+
+
+def main() -> None:
+    sys.stdout.write(
+        f'{"operation":<10}{"size":<8}{"fractions":>12}{"cfractions":>12}\n'
+    )
+    for name, operation in OPERATIONS.items():
+        for size_name, bit_length in SIZES.items():
+            (numerator, denominator), (other_numerator, other_denominator) = (
+                to_operands(bit_length)
+            )
+            timings = [
+                measure(
+                    operation,
+                    module.Fraction(numerator, denominator),
+                    module.Fraction(other_numerator, other_denominator),
+                )
+                for module in (fractions, cfractions)
+            ]
+            sys.stdout.write(
+                f'{name:<10}{size_name:<8}'
+                + ''.join(f'{timing * 1e6:>10.2f}us' for timing in timings)
+                + '\n'
+            )
+
+
+if __name__ == '__main__':
+    main()
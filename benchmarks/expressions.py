@@ -0,0 +1,58 @@
+"""Benchmarks of compiled expressions evaluation.
+
+The formula ``(a * b + c * d) / (e - f)`` is evaluated over rows
+of decimal amounts with plain fractions arithmetic per row
+and with ``evaluate_many`` of the compiled expression.
+
+Run from the project root with ``python -m benchmarks.expressions``.
+"""
+
+from __future__ import annotations
+
+import random
+import sys
+import time
+from collections.abc import Callable
+
+from cfractions import Fraction, compile as compile_expression
+
+SIZE = 200_000
+
+
+def to_columns(seed: int) -> list[list[Fraction]]:
+    generator = random.Random(seed)
+    return [
+        [
+            Fraction(generator.randint(-(10**8), 10**8), 100)
+            for _ in range(SIZE)
+        ]
+        for _ in range(6)
+    ]
+
+
+def measure(function: Callable[[], list[Fraction]]) -> float:
+    start = time.perf_counter()
+    function()
+    return time.perf_counter() - start
+
+
+def main() -> None:
+    columns = to_columns(0)
+    expression = compile_expression('(a * b + c * d) / (e - f)')
+    sys.stdout.write(f'rows: {SIZE}\n')
+    sys.stdout.write(f'{"evaluation":<16}{"seconds":>10}\n')
+    for name, function in (
+        (
+            'arithmetic',
+            lambda: [
+                (a * b + c * d) / (e - f)
+                for a, b, c, d, e, f in zip(*columns, strict=True)
+            ],
+        ),
+        ('evaluate_many', lambda: expression.evaluate_many(columns)),
+    ):
+        sys.stdout.write(f'{name:<16}{measure(function):>10.3f}\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,107 @@
+"""Benchmarks of arithmetic on fractions with huge components.
+
+Run from the project root with ``python -m benchmarks.huge_operands``
+against the default build and the one made with ``CFRACTIONS_GMP=1``.
+Besides timings it reports how many iterations a concurrent thread
+managed to make per second of a single operation,
+which shows whether the operation holds the GIL.
+"""
+
+from __future__ import annotations
+
+import fractions
+import operator
+import random
+import sys
+import threading
+import time
+import timeit
+from collections.abc import Callable
+from typing import Any
+
+import cfractions
+
+OPERATIONS: dict[str, Callable[[Any, Any], Any]] = {
+    '+': operator.add,
+    '*': operator.mul,
+    '/': operator.truediv,
+}
+SIZES = {'1e3': 1_000, '1e4': 10_000, '1e5': 100_000, '1e6': 1_000_000}
+
+
+def to_operands(
+    bit_length: int, seed: int = 0
+) -> tuple[tuple[int, int], tuple[int, int]]:
+    generator = random.Random(seed)
+    return (
+        (
+            generator.getrandbits(bit_length),
+            generator.getrandbits(bit_length) | 1,
+        ),
+        (
+            generator.getrandbits(bit_length),
+            generator.getrandbits(bit_length) | 1,
+        ),
+    )
+
+
+def measure(
+    operation: Callable[[Any, Any], Any], first: Any, second: Any
+) -> float:
+    timer = timeit.Timer(lambda: operation(first, second))
+    number, _ = timer.autorange()
+    return min(timer.repeat(repeat=3, number=number)) / number
+
+
+def measure_concurrent_progress(
+    operation: Callable[[Any, Any], Any], first: Any, second: Any
+) -> float:
+    iterations_count = 0
+    is_running = True
+
+    def count_iterations() -> None:
+        nonlocal iterations_count
+        while is_running:
+            iterations_count += 1
+
+    thread = threading.Thread(target=count_iterations)
+    thread.start()
+    start = time.perf_counter()
+    while (elapsed := time.perf_counter() - start) < 0.2:
+        operation(first, second)
+    is_running = False
+    thread.join()
+    return iterations_count / elapsed
+
+
+def main() -> None:
+    sys.stdout.write(
+        f'{"operation":<10}{"bits":<8}{"fractions":>12}{"cfractions":>12}'
+        f'{"concurrent it/s":>18}\n'
+    )
+    for name, operation in OPERATIONS.items():
+        for size_name, bit_length in SIZES.items():
+            (numerator, denominator), (other_numerator, other_denominator) = (
+                to_operands(bit_length)
+            )
+            operands = [
+                (
+                    module.Fraction(numerator, denominator),
+                    module.Fraction(other_numerator, other_denominator),
+                )
+                for module in (fractions, cfractions)
+            ]
+            timings = [
+                measure(operation, *module_operands)
+                for module_operands in operands
+            ]
+            progress = measure_concurrent_progress(operation, *operands[-1])
+            sys.stdout.write(
+                f'{name:<10}{size_name:<8}'
+                + ''.join(f'{timing * 1e3:>10.3f}ms' for timing in timings)
+                + f'{progress:>18.0f}\n'
+            )
+
+
+if __name__ == '__main__':
+    main()
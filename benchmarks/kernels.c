@@ -0,0 +1,423 @@
+/* Benchmarks of internal kernels of the extension.
+
+   Embeds the interpreter and calls kernels directly in tight loops,
+   reports time, allocations through Python allocators and,
+   where `perf_event_open` is permitted, hardware counters per operation
+   as JSON, so results can be tracked over time.
+
+   Build from the project root with
+   `python setup.py build_kernels_benchmark` and run with
+   `build/kernels_benchmark [SUBSTRING]`,
+   where `SUBSTRING` selects kernels by name. */
+#include "cfractions.c"
+
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define COUNTERS_COUNT 3
+#define MIN_CALIBRATION_NS 10000000LL
+#define RUN_NS 50000000LL
+#define RUNS_COUNT 5
+
+static const char* const counters_names[COUNTERS_COUNT] = {
+    "cycles", "instructions", "cache_misses"};
+
+static long long allocations_count = 0;
+
+static PyMemAllocatorEx memory_allocator, object_allocator;
+
+static void* counting_malloc(void* context, size_t size) {
+  PyMemAllocatorEx* allocator = (PyMemAllocatorEx*)context;
+  ++allocations_count;
+  return allocator->malloc(allocator->ctx, size);
+}
+
+static void* counting_calloc(void* context, size_t count, size_t size) {
+  PyMemAllocatorEx* allocator = (PyMemAllocatorEx*)context;
+  ++allocations_count;
+  return allocator->calloc(allocator->ctx, count, size);
+}
+
+static void* counting_realloc(void* context, void* pointer, size_t size) {
+  PyMemAllocatorEx* allocator = (PyMemAllocatorEx*)context;
+  if (pointer == NULL) ++allocations_count;
+  return allocator->realloc(allocator->ctx, pointer, size);
+}
+
+static void counting_free(void* context, void* pointer) {
+  PyMemAllocatorEx* allocator = (PyMemAllocatorEx*)context;
+  allocator->free(allocator->ctx, pointer);
+}
+
+/* Wraps allocators of Python objects & buffers,
+   raw allocations are not counted as kernels do not make them. */
+static void install_counting_allocators(void) {
+  PyMemAllocatorDomain domains[2] = {PYMEM_DOMAIN_MEM, PYMEM_DOMAIN_OBJ};
+  PyMemAllocatorEx* originals[2] = {&memory_allocator, &object_allocator};
+  for (size_t index = 0; index < 2; ++index) {
+    PyMem_GetAllocator(domains[index], originals[index]);
+    PyMemAllocatorEx allocator = {originals[index], counting_malloc,
+                                  counting_calloc, counting_realloc,
+                                  counting_free};
+    PyMem_SetAllocator(domains[index], &allocator);
+  }
+}
+
+typedef struct {
+  int leader; /* -1 if counters are not available */
+  int members[COUNTERS_COUNT];
+} Counters;
+
+#ifdef __linux__
+static int open_counter(unsigned long long config, int group) {
+  struct perf_event_attr attribute;
+  memset(&attribute, 0, sizeof(attribute));
+  attribute.size = sizeof(attribute);
+  attribute.type = PERF_TYPE_HARDWARE;
+  attribute.config = config;
+  attribute.disabled = group == -1;
+  attribute.exclude_kernel = 1;
+  attribute.exclude_hv = 1;
+  attribute.read_format = PERF_FORMAT_GROUP;
+  return (int)syscall(__NR_perf_event_open, &attribute, 0, -1, group, 0);
+}
+#endif
+
+static void counters_open(Counters* self) {
+  self->leader = -1;
+#ifdef __linux__
+  unsigned long long configs[COUNTERS_COUNT] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES};
+  for (size_t index = 0; index < COUNTERS_COUNT; ++index) {
+    self->members[index] = open_counter(configs[index], self->leader);
+    if (self->members[index] < 0) {
+      for (size_t offset = 0; offset < index; ++offset)
+        close(self->members[offset]);
+      self->leader = -1;
+      return;
+    }
+    if (!index) self->leader = self->members[0];
+  }
+#endif
+}
+
+static void counters_close(Counters* self) {
+#ifdef __linux__
+  if (self->leader < 0) return;
+  for (size_t index = 0; index < COUNTERS_COUNT; ++index)
+    close(self->members[index]);
+#else
+  (void)self;
+#endif
+}
+
+static void counters_start(Counters* self) {
+#ifdef __linux__
+  if (self->leader < 0) return;
+  ioctl(self->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(self->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+  (void)self;
+#endif
+}
+
+static int counters_stop(Counters* self,
+                         unsigned long long result[COUNTERS_COUNT]) {
+#ifdef __linux__
+  if (self->leader < 0) return 0;
+  ioctl(self->leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  unsigned long long values[1 + COUNTERS_COUNT];
+  if (read(self->leader, values, sizeof(values)) != sizeof(values) ||
+      values[0] != COUNTERS_COUNT)
+    return 0;
+  memcpy(result, &values[1], sizeof(values) - sizeof(values[0]));
+  return 1;
+#else
+  (void)self;
+  (void)result;
+  return 0;
+#endif
+}
+
+static long long monotonic_ns(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (long long)time.tv_sec * 1000000000LL + time.tv_nsec;
+}
+
+/* Operands of a kernel, components are owned. */
+typedef struct {
+  PyTypeObject* cls;
+  PyObject* components[4];
+  FractionObject* fraction;
+  PyObject* max_denominator;
+  double value;
+  PyObject* string;
+} Operands;
+
+typedef struct {
+  const char* name;
+  int (*run)(Operands* operands); /* one operation, -1 on failure */
+  Operands operands;
+} Kernel;
+
+static int run_normalize_moduli(Operands* operands) {
+  PyObject *numerator = operands->components[0],
+           *denominator = operands->components[1];
+  Py_INCREF(numerator);
+  Py_INCREF(denominator);
+  int result = normalize_fraction_components_moduli(&numerator, &denominator);
+  Py_DECREF(denominator);
+  Py_DECREF(numerator);
+  return result;
+}
+
+static int run_parse_double(Operands* operands) {
+  PyObject *numerator, *denominator;
+  if (parse_fraction_components_from_double(operands->value, &numerator,
+                                            &denominator) < 0)
+    return -1;
+  Py_DECREF(denominator);
+  Py_DECREF(numerator);
+  return 0;
+}
+
+static int run_parse_string(Operands* operands) {
+  PyObject *numerator, *denominator;
+  if (parse_fraction_components_from_PyUnicode(operands->string, &numerator,
+                                               &denominator) < 0)
+    return -1;
+  Py_DECREF(denominator);
+  Py_DECREF(numerator);
+  return 0;
+}
+
+static int run_binary_kernel(
+    Operands* operands,
+    FractionObject* (*kernel)(PyTypeObject*, PyObject*, PyObject*, PyObject*,
+                              PyObject*)) {
+  FractionObject* result =
+      kernel(operands->cls, operands->components[0], operands->components[1],
+             operands->components[2], operands->components[3]);
+  if (result == NULL) return -1;
+  Py_DECREF(result);
+  return 0;
+}
+
+static int run_add(Operands* operands) {
+  return run_binary_kernel(operands, Fractions_components_add);
+}
+
+static int run_multiply(Operands* operands) {
+  return run_binary_kernel(operands, Fractions_components_multiply);
+}
+
+static int run_true_divide(Operands* operands) {
+  return run_binary_kernel(operands, Fractions_components_true_divide);
+}
+
+static int run_hash(Operands* operands) {
+  /* hashes are not cached, so every call computes one */
+  return fraction_hash(operands->fraction) == -1 ? -1 : 0;
+}
+
+static int run_limit_denominator(Operands* operands) {
+  FractionObject* result = fraction_limit_denominator_impl(
+      operands->fraction, operands->max_denominator);
+  if (result == NULL) return -1;
+  Py_DECREF(result);
+  return 0;
+}
+
+static int run_repr(Operands* operands) {
+  PyObject* result = fraction_repr(operands->fraction);
+  if (result == NULL) return -1;
+  Py_DECREF(result);
+  return 0;
+}
+
+/* Fills components of two fractions with pseudo-random integers
+   of the given size, the first fraction is negative. */
+static int operands_init(Operands* self, PyTypeObject* cls,
+                         Py_ssize_t bit_length) {
+  memset(self, 0, sizeof(*self));
+  self->cls = cls;
+  unsigned long long state = 0x9E3779B97F4A7C15ULL;
+  for (size_t index = 0; index < 4; ++index) {
+    size_t size = ((size_t)bit_length + 7) / 8;
+    unsigned char* bytes = PyMem_Malloc(size);
+    if (bytes == NULL) return -1;
+    for (size_t offset = 0; offset < size; ++offset) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      bytes[offset] = (unsigned char)state;
+    }
+    bytes[0] |= 1;
+    if (bit_length % 8)
+      bytes[size - 1] &= (unsigned char)((1U << (bit_length % 8)) - 1);
+    self->components[index] = _PyLong_FromByteArray(bytes, size, 1, 0);
+    PyMem_Free(bytes);
+    if (self->components[index] == NULL) return -1;
+  }
+  Py_SETREF(self->components[0], PyNumber_Negative(self->components[0]));
+  if (self->components[0] == NULL) return -1;
+  for (size_t index = 0; index < 4; index += 2)
+    if (normalize_fraction_components_moduli(
+            &self->components[index], &self->components[index + 1]) < 0)
+      return -1;
+  Py_INCREF(self->components[0]);
+  Py_INCREF(self->components[1]);
+  self->fraction =
+      construct_fraction(cls, self->components[0], self->components[1]);
+  if (self->fraction == NULL) return -1;
+  self->max_denominator = PyLong_FromLong(1000);
+  if (self->max_denominator == NULL) return -1;
+  self->value = -0.1;
+  self->string = PyUnicode_FromString("-3.14159e-2");
+  return self->string == NULL ? -1 : 0;
+}
+
+static void operands_clear(Operands* self) {
+  for (size_t index = 0; index < 4; ++index)
+    Py_XDECREF(self->components[index]);
+  Py_XDECREF(self->fraction);
+  Py_XDECREF(self->max_denominator);
+  Py_XDECREF(self->string);
+}
+
+typedef struct {
+  long long iterations;
+  double ns_per_op;
+  double allocations_per_op;
+  int has_counters;
+  unsigned long long counters[COUNTERS_COUNT];
+} Measurement;
+
+static int run_kernel(Kernel* kernel, long long iterations,
+                      Counters* counters, Measurement* result) {
+  long long allocations_start = allocations_count;
+  counters_start(counters);
+  long long start = monotonic_ns();
+  for (long long index = 0; index < iterations; ++index)
+    if (kernel->run(&kernel->operands) < 0) return -1;
+  long long elapsed = monotonic_ns() - start;
+  result->has_counters = counters_stop(counters, result->counters);
+  result->iterations = iterations;
+  result->ns_per_op = (double)elapsed / (double)iterations;
+  result->allocations_per_op =
+      (double)(allocations_count - allocations_start) / (double)iterations;
+  return 0;
+}
+
+/* Keeps the fastest of runs which last about `RUN_NS` each. */
+static int measure_kernel(Kernel* kernel, Counters* counters,
+                          Measurement* result) {
+  long long iterations = 1;
+  for (;; iterations *= 2) {
+    long long start = monotonic_ns();
+    for (long long index = 0; index < iterations; ++index)
+      if (kernel->run(&kernel->operands) < 0) return -1;
+    long long elapsed = monotonic_ns() - start;
+    if (elapsed >= MIN_CALIBRATION_NS) {
+      iterations = Py_MAX(iterations * RUN_NS / elapsed, 1);
+      break;
+    }
+  }
+  for (size_t index = 0; index < RUNS_COUNT; ++index) {
+    Measurement measurement;
+    if (run_kernel(kernel, iterations, counters, &measurement) < 0)
+      return -1;
+    if (!index || measurement.ns_per_op < result->ns_per_op)
+      *result = measurement;
+  }
+  return 0;
+}
+
+static void print_measurement(const char* name,
+                              const Measurement* measurement, int is_first) {
+  printf("%s\n    {\"name\": \"%s\", \"iterations\": %lld, "
+         "\"ns_per_op\": %.3f, \"allocations_per_op\": %.3f",
+         is_first ? "" : ",", name, measurement->iterations,
+         measurement->ns_per_op, measurement->allocations_per_op);
+  for (size_t index = 0; index < COUNTERS_COUNT; ++index)
+    if (measurement->has_counters)
+      printf(", \"%s_per_op\": %.3f", counters_names[index],
+             (double)measurement->counters[index] /
+                 (double)measurement->iterations);
+    else
+      printf(", \"%s_per_op\": null", counters_names[index]);
+  printf("}");
+}
+
+int main(int argc, char** argv) {
+  const char* selection = argc > 1 ? argv[1] : "";
+  if (PyImport_AppendInittab("_cfractions", PyInit__cfractions) < 0)
+    return EXIT_FAILURE;
+  Py_InitializeEx(0);
+  PyObject* module = PyImport_ImportModule("_cfractions");
+  if (module == NULL) {
+    PyErr_Print();
+    return EXIT_FAILURE;
+  }
+  PyTypeObject* cls = get_module_state(module)->fraction_type;
+  Kernel kernels[] = {
+      {"normalize_moduli/64-bits", run_normalize_moduli, {0}},
+      {"normalize_moduli/1000-bits", run_normalize_moduli, {0}},
+      {"parse_double", run_parse_double, {0}},
+      {"parse_string", run_parse_string, {0}},
+      {"add/64-bits", run_add, {0}},
+      {"add/1000-bits", run_add, {0}},
+      {"multiply/64-bits", run_multiply, {0}},
+      {"multiply/1000-bits", run_multiply, {0}},
+      {"true_divide/64-bits", run_true_divide, {0}},
+      {"true_divide/1000-bits", run_true_divide, {0}},
+      {"hash/64-bits", run_hash, {0}},
+      {"hash/1000-bits", run_hash, {0}},
+      {"limit_denominator/64-bits", run_limit_denominator, {0}},
+      {"limit_denominator/1000-bits", run_limit_denominator, {0}},
+      {"repr/64-bits", run_repr, {0}},
+  };
+  size_t kernels_count = sizeof(kernels) / sizeof(kernels[0]);
+  int status = EXIT_SUCCESS;
+  for (size_t index = 0; index < kernels_count; ++index)
+    if (operands_init(&kernels[index].operands, cls,
+                      strstr(kernels[index].name, "/1000-bits") ? 1000
+                                                                : 64) < 0) {
+      PyErr_Print();
+      status = EXIT_FAILURE;
+      goto exit;
+    }
+  install_counting_allocators();
+  Counters counters;
+  counters_open(&counters);
+  printf("{\n  \"python\": \"%s\",\n  \"counters\": %s,\n  \"kernels\": [",
+         PY_VERSION, counters.leader < 0 ? "false" : "true");
+  int is_first = 1;
+  for (size_t index = 0; index < kernels_count; ++index) {
+    if (!strstr(kernels[index].name, selection)) continue;
+    Measurement measurement;
+    if (measure_kernel(&kernels[index], &counters, &measurement) < 0) {
+      PyErr_Print();
+      status = EXIT_FAILURE;
+      break;
+    }
+    print_measurement(kernels[index].name, &measurement, is_first);
+    is_first = 0;
+  }
+  printf("\n  ]\n}\n");
+  counters_close(&counters);
+exit:
+  for (size_t index = 0; index < kernels_count; ++index)
+    operands_clear(&kernels[index].operands);
+  Py_DECREF(module);
+  if (Py_FinalizeEx() < 0) status = EXIT_FAILURE;
+  return status;
+}
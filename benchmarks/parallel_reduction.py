@@ -0,0 +1,65 @@
+"""Benchmarks of parallel reductions of fractions.
+
+Sums and dot products of decimal amounts are computed sequentially
+with the builtin ``sum`` and with ``parallel_sum``/``parallel_dot``
+for growing numbers of workers.
+
+Run from the project root with ``python -m benchmarks.parallel_reduction``.
+"""
+
+from __future__ import annotations
+
+import os
+import random
+import sys
+import time
+from collections.abc import Callable
+from functools import partial
+from operator import mul
+
+from cfractions import Fraction, parallel_dot, parallel_sum
+
+SIZE = 1_000_000
+
+
+def to_amounts(seed: int) -> list[Fraction]:
+    generator = random.Random(seed)
+    return [
+        Fraction(generator.randint(-(10**8), 10**8), 100) for _ in range(SIZE)
+    ]
+
+
+def measure(function: Callable[[], Fraction]) -> float:
+    start = time.perf_counter()
+    function()
+    return time.perf_counter() - start
+
+
+def main() -> None:
+    xs, ys = to_amounts(0), to_amounts(1)
+    is_gil_enabled = getattr(sys, '_is_gil_enabled', lambda: True)()
+    sys.stdout.write(f'GIL enabled: {is_gil_enabled}, terms: {SIZE}\n')
+    sys.stdout.write(f'{"reduction":<16}{"workers":>8}{"seconds":>10}\n')
+    for name, sequential in (
+        ('sum', lambda: sum(xs, Fraction())),
+        ('dot', lambda: sum(map(mul, xs, ys), Fraction())),
+    ):
+        sys.stdout.write(
+            f'{"sequential " + name:<16}{1:>8}{measure(sequential):>10.3f}\n'
+        )
+    max_workers_count = os.cpu_count() or 1
+    workers_counts = sorted(
+        {1, *(1 << exponent for exponent in range(8)), max_workers_count}
+        & set(range(1, max_workers_count + 1))
+    )
+    for name, parallel in (
+        ('parallel_sum', partial(parallel_sum, xs)),
+        ('parallel_dot', partial(parallel_dot, xs, ys)),
+    ):
+        for workers_count in workers_counts:
+            seconds = measure(partial(parallel, workers=workers_count))
+            sys.stdout.write(f'{name:<16}{workers_count:>8}{seconds:>10.3f}\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,79 @@
+"""Benchmarks of iterative workloads within precision contexts.
+
+Each workload runs with exact arithmetic
+and within ``precision_context`` limiting denominators
+either by ``max_denominator`` or by ``max_bits``,
+reporting time and bit length of the final denominator.
+
+Run from the project root with ``python -m benchmarks.precision``.
+"""
+
+from __future__ import annotations
+
+import sys
+import time
+from collections.abc import Callable
+from contextlib import AbstractContextManager, nullcontext
+from typing import Any
+
+from cfractions import Fraction, precision_context
+
+
+def logistic_map(iterations: int) -> Fraction:
+    rate, value = Fraction(7, 2), Fraction(1, 3)
+    for _ in range(iterations):
+        value = rate * value * (1 - value)
+    return value
+
+
+def euler_method(iterations: int) -> Fraction:
+    # integrates y' = y * (1 - y) with y(0) = 1 / 10 over [0, 1]
+    step, value = Fraction(1, iterations), Fraction(1, 10)
+    for _ in range(iterations):
+        value += step * value * (1 - value)
+    return value
+
+
+def newton_method(iterations: int) -> Fraction:
+    # approximates square root of 2
+    value = Fraction(1)
+    for _ in range(iterations):
+        value = (value + 2 / value) / 2
+    return value
+
+
+WORKLOADS: tuple[tuple[str, Callable[[int], Fraction], int], ...] = (
+    ('logistic_map', logistic_map, 18),
+    ('euler_method', euler_method, 12),
+    ('newton_method', newton_method, 16),
+)
+
+
+def main() -> None:
+    contexts: tuple[tuple[str, Callable[[], AbstractContextManager[Any]]], ...]
+    contexts = (
+        ('exact', nullcontext),
+        (
+            'max_denominator=10**12',
+            lambda: precision_context(max_denominator=10**12),
+        ),
+        ('max_bits=64', lambda: precision_context(max_bits=64)),
+    )
+    sys.stdout.write(
+        f'{"workload":<16}{"iterations":>12}{"precision":>26}'
+        f'{"seconds":>10}{"bits":>10}\n'
+    )
+    for name, workload, iterations in WORKLOADS:
+        for context_name, context in contexts:
+            with context():
+                start = time.perf_counter()
+                result = workload(iterations)
+                seconds = time.perf_counter() - start
+            sys.stdout.write(
+                f'{name:<16}{iterations:>12}{context_name:>26}'
+                f'{seconds:>10.4f}{result.denominator.bit_length():>10}\n'
+            )
+
+
+if __name__ == '__main__':
+    main()
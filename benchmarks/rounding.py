@@ -0,0 +1,77 @@
+"""Benchmarks of rounding fractions to positive & negative precisions.
+
+The native kernel is compared against the standard library
+and against the previous path of ``cfractions``
+which scaled the fraction by a power of ten through intermediate fractions.
+
+Run from the project root with ``python -m benchmarks.rounding``.
+"""
+
+from __future__ import annotations
+
+import fractions
+import random
+import sys
+import timeit
+from collections.abc import Callable
+from typing import Any
+
+import cfractions
+
+PRECISIONS = (2, -3)
+SIZES = {'word': 60, 'large': 1_000, 'huge': 10_000}
+
+
+def scaling_round(
+    value: cfractions.Fraction, precision: int
+) -> cfractions.Fraction:
+    shift = 10 ** abs(precision)
+    if precision >= 0:
+        return cfractions.Fraction(round(value * shift), shift)
+    return cfractions.Fraction(round(value / shift) * shift)
+
+
+def to_components(bit_length: int, seed: int = 0) -> tuple[int, int]:
+    generator = random.Random(seed)
+    return (
+        generator.getrandbits(bit_length),
+        generator.getrandbits(bit_length // 2) | 1,
+    )
+
+
+def measure(
+    rounder: Callable[[Any, int], Any], value: Any, precision: int
+) -> float:
+    timer = timeit.Timer(lambda: rounder(value, precision))
+    number, _ = timer.autorange()
+    return min(timer.repeat(repeat=5, number=number)) / number
+
+
+def main() -> None:
+    sys.stdout.write(
+        f'{"precision":<10}{"size":<8}{"fractions":>12}{"scaling":>12}'
+        f'{"cfractions":>12}\n'
+    )
+    for precision in PRECISIONS:
+        for size_name, bit_length in SIZES.items():
+            numerator, denominator = to_components(bit_length)
+            value = cfractions.Fraction(numerator, denominator)
+            assert round(value, precision) == scaling_round(value, precision)
+            timings = [
+                measure(
+                    round,
+                    fractions.Fraction(numerator, denominator),
+                    precision,
+                ),
+                measure(scaling_round, value, precision),
+                measure(round, value, precision),
+            ]
+            sys.stdout.write(
+                f'{precision:<10}{size_name:<8}'
+                + ''.join(f'{timing * 1e6:>10.2f}us' for timing in timings)
+                + '\n'
+            )
+
+
+if __name__ == '__main__':
+    main()
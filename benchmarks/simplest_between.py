@@ -0,0 +1,105 @@
+"""Benchmarks of ``simplest_between`` & ``Fraction.from_float_shortest``.
+
+Both are compared against a naive Stern-Brocot walk
+which descends by one mediant per step.
+
+Run from the project root with ``python -m benchmarks.simplest_between``.
+"""
+
+from __future__ import annotations
+
+import math
+import sys
+import timeit
+from collections.abc import Callable, Sequence
+from functools import partial
+from typing import Any
+
+from cfractions import Fraction, simplest_between
+
+INTERVALS: dict[str, tuple[Fraction, Fraction]] = {
+    'pi +- 1e-6': (
+        Fraction(math.pi) - Fraction(1, 10**6),
+        Fraction(math.pi) + Fraction(1, 10**6),
+    ),
+    '0.3 +- 1e-15': (
+        Fraction(3, 10) - Fraction(1, 10**15),
+        Fraction(3, 10) + Fraction(1, 10**15),
+    ),
+    '[1/1000, 1/999]': (Fraction(1, 1000), Fraction(1, 999)),
+}
+FLOATS: dict[str, float] = {'shortest 0.1': 0.1, 'shortest pi': math.pi}
+
+
+def stern_brocot_simplest_between(
+    lower_bound: Fraction, upper_bound: Fraction, *, inclusive: bool = True
+) -> Fraction:
+    # walks positive intervals only
+    left_numerator, left_denominator = 0, 1
+    right_numerator, right_denominator = 1, 0
+    while True:
+        numerator, denominator = (
+            left_numerator + right_numerator,
+            left_denominator + right_denominator,
+        )
+        mediant = Fraction(numerator, denominator)
+        if mediant < lower_bound or (not inclusive and mediant == lower_bound):
+            left_numerator, left_denominator = numerator, denominator
+        elif mediant > upper_bound or (
+            not inclusive and mediant == upper_bound
+        ):
+            right_numerator, right_denominator = numerator, denominator
+        else:
+            return mediant
+
+
+def stern_brocot_from_float_shortest(value: float) -> Fraction:
+    # handles positive floats which are not powers of two
+    mantissa, _ = math.frexp(value)
+    half_ulp = Fraction(math.ulp(value)) / 2
+    exact = Fraction(value)
+    return stern_brocot_simplest_between(
+        exact - half_ulp,
+        exact + half_ulp,
+        inclusive=int(mantissa * (1 << 53)) % 2 == 0,
+    )
+
+
+def measure(function: Callable[[], Any]) -> float:
+    timer = timeit.Timer(function)
+    number, _ = timer.autorange()
+    return min(timer.repeat(repeat=5, number=number)) / number
+
+
+def main() -> None:
+    sys.stdout.write(
+        f'{"case":<18}{"stern-brocot":>14}{"cfractions":>14}{"speedup":>10}\n'
+    )
+    cases: Sequence[
+        tuple[str, Callable[[], Fraction], Callable[[], Fraction]]
+    ] = [
+        (
+            name,
+            partial(simplest_between, *bounds),
+            partial(stern_brocot_simplest_between, *bounds),
+        )
+        for name, bounds in INTERVALS.items()
+    ] + [
+        (
+            name,
+            partial(Fraction.from_float_shortest, value),
+            partial(stern_brocot_from_float_shortest, value),
+        )
+        for name, value in FLOATS.items()
+    ]
+    for name, function, naive_function in cases:
+        assert function() == naive_function(), name
+        naive_timing, timing = measure(naive_function), measure(function)
+        sys.stdout.write(
+            f'{name:<18}{naive_timing * 1e6:>12.2f}us'
+            f'{timing * 1e6:>12.2f}us{naive_timing / timing:>9.0f}x\n'
+        )
+
+
+if __name__ == '__main__':
+    main()
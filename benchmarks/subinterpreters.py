@@ -0,0 +1,145 @@
+"""Benchmarks of fractions arithmetic scaling across subinterpreters.
+
+The same workload runs either in threads of the main interpreter
+or in subinterpreters each driven by its own thread,
+since Python 3.12 subinterpreters have their own GIL,
+so only the latter should scale with the number of workers
+on builds with the GIL.
+
+Run from the project root with ``python -m benchmarks.subinterpreters``.
+"""
+
+from __future__ import annotations
+
+import importlib
+import os
+import sys
+import threading
+import time
+from collections.abc import Callable
+from functools import partial
+from typing import Any
+
+ITERATIONS = 5_000
+WORKLOAD = """
+import random
+
+from cfractions import Fraction
+
+generator = random.Random({seed})
+values = [
+    Fraction(generator.getrandbits(30), generator.getrandbits(30) | 1)
+    for _ in range(64)
+]
+for index in range({iterations}):
+    first, second = values[index % 64], values[(index * 7 + 3) % 64]
+    _ = ((first + second) * first / second - first // second) ** 2
+    _ = (first * second).limit_denominator(1_000)
+"""
+
+
+def load_interpreters_module() -> Any:
+    try:
+        return importlib.import_module(
+            '_interpreters'
+            if sys.version_info >= (3, 13)
+            else '_xxsubinterpreters'
+        )
+    except ImportError:
+        return None
+
+
+def to_script(seed: int) -> str:
+    return f'import sys\nsys.path[:0] = {sys.path!r}\n' + WORKLOAD.format(
+        seed=seed, iterations=ITERATIONS
+    )
+
+
+def run_in_interpreter(
+    interpreters: Any, interpreter_id: Any, script: str
+) -> None:
+    error = interpreters.run_string(interpreter_id, script)
+    if error is not None:
+        raise RuntimeError(error)
+
+
+def measure(workers: list[Callable[[], None]]) -> float:
+    barrier = threading.Barrier(len(workers) + 1)
+
+    def work(worker: Callable[[], None]) -> None:
+        barrier.wait()
+        worker()
+
+    threads = [
+        threading.Thread(target=work, args=(worker,)) for worker in workers
+    ]
+    for thread in threads:
+        thread.start()
+    barrier.wait()
+    start = time.perf_counter()
+    for thread in threads:
+        thread.join()
+    return len(workers) * ITERATIONS / (time.perf_counter() - start)
+
+
+def measure_threads(workers_count: int) -> float:
+    scripts = [to_script(seed) for seed in range(workers_count)]
+    return measure([partial(exec, script, {}) for script in scripts])
+
+
+def measure_subinterpreters(interpreters: Any, workers_count: int) -> float:
+    interpreters_ids = [interpreters.create() for _ in range(workers_count)]
+    try:
+        for interpreter_id in interpreters_ids:
+            run_in_interpreter(interpreters, interpreter_id, to_script(0))
+        return measure(
+            [
+                partial(
+                    run_in_interpreter,
+                    interpreters,
+                    interpreter_id,
+                    to_script(seed),
+                )
+                for seed, interpreter_id in enumerate(interpreters_ids)
+            ]
+        )
+    finally:
+        for interpreter_id in interpreters_ids:
+            interpreters.destroy(interpreter_id)
+
+
+def main() -> None:
+    interpreters = load_interpreters_module()
+    if interpreters is None:
+        sys.stderr.write('Subinterpreters are not available.\n')
+        return
+    sys.stdout.write(
+        f'{"mode":<18}{"workers":>8}{"iterations/s":>16}{"speedup":>10}\n'
+    )
+    max_workers_count = os.cpu_count() or 1
+    workers_counts = sorted(
+        {1, *(1 << exponent for exponent in range(8)), max_workers_count}
+        & set(range(1, max_workers_count + 1))
+    )
+    for mode, measure_mode in (
+        ('threads', measure_threads),
+        (
+            'subinterpreters',
+            lambda workers_count: measure_subinterpreters(
+                interpreters, workers_count
+            ),
+        ),
+    ):
+        base_throughput = None
+        for workers_count in workers_counts:
+            throughput = measure_mode(workers_count)
+            if base_throughput is None:
+                base_throughput = throughput
+            sys.stdout.write(
+                f'{mode:<18}{workers_count:>8}'
+                f'{throughput:>16.0f}{throughput / base_throughput:>9.2f}x\n'
+            )
+
+
+if __name__ == '__main__':
+    main()
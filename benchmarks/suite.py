@@ -0,0 +1,136 @@
+"""pyperf suite of operations on fractions.
+
+Every run measures one implementation of fractions:
+``cfractions`` (the C extension), ``fallback`` (the pure Python one,
+used on PyPy) or ``fractions`` (the standard library),
+so regressions show up when results are compared
+against the ones of another run or of another implementation.
+
+Run from the project root with
+``python -m benchmarks.suite --implementation cfractions -o cfractions.json``
+(``--select`` runs only cases whose names contain the given substring)
+and compare results with ``python -m benchmarks.compare``.
+"""
+
+from __future__ import annotations
+
+import argparse
+import fractions
+import importlib
+import math
+import operator
+import pickle
+import random
+import sys
+from collections.abc import Callable, Iterator
+from typing import Any
+
+import pyperf
+
+BIT_LENGTHS = (8, 64, 1_000, 10_000, 100_000)
+IMPLEMENTATIONS = ('cfractions', 'fallback', 'fractions')
+BINARY_OPERATIONS: dict[str, Callable[[Any, Any], Any]] = {
+    'add': operator.add,
+    'sub': operator.sub,
+    'mul': operator.mul,
+    'truediv': operator.truediv,
+    'floordiv': operator.floordiv,
+    'mod': operator.mod,
+    'divmod': divmod,
+    'lt': operator.lt,
+    'eq': operator.eq,
+}
+MIXED_OPERATIONS: dict[str, Callable[[Any, Any], Any]] = {
+    'add': operator.add,
+    'mul': operator.mul,
+    'truediv': operator.truediv,
+    'lt': operator.lt,
+    'eq': operator.eq,
+}
+Case = tuple[str, Callable[..., Any], tuple[Any, ...]]
+
+
+def load_fraction_type(implementation: str) -> Any:
+    if implementation == 'fallback':
+        # the package falls back to the pure Python implementation
+        # when the extension cannot be imported
+        sys.modules['cfractions._cfractions'] = None  # type: ignore[assignment]
+        implementation = 'cfractions'
+    return importlib.import_module(implementation).Fraction
+
+
+def to_operands(
+    fraction_type: Any, bit_length: int, seed: int = 0
+) -> tuple[Any, Any]:
+    generator = random.Random(seed)
+    return (
+        fraction_type(
+            generator.getrandbits(bit_length) - (1 << (bit_length - 1)),
+            generator.getrandbits(bit_length) | 1,
+        ),
+        fraction_type(
+            generator.getrandbits(bit_length) | 1,
+            generator.getrandbits(bit_length) | 1,
+        ),
+    )
+
+
+def to_cases(fraction_type: Any) -> Iterator[Case]:
+    yield 'construct/int', fraction_type, (12_345_678_901_234_567_890,)
+    yield 'construct/ints', fraction_type, (-314_159, 100_000)
+    yield 'construct/float', fraction_type, (math.pi,)
+    yield 'construct/str', fraction_type, ('-314159/100000',)
+    yield 'construct/decimal-str', fraction_type, ('-3.14159e-2',)
+    yield 'construct/rational', fraction_type, (fractions.Fraction(22, 7),)
+    for bit_length in BIT_LENGTHS:
+        first, second = to_operands(fraction_type, bit_length)
+        for name, operation in BINARY_OPERATIONS.items():
+            yield f'{name}/{bit_length}-bits', operation, (first, second)
+        yield f'pow/{bit_length}-bits', pow, (first, 3)
+    value, other = to_operands(fraction_type, 64)
+    for operand_name, operand in (
+        ('int', 7),
+        ('float', 0.5),
+        ('fractions', fractions.Fraction(3, 7)),
+    ):
+        for name, operation in MIXED_OPERATIONS.items():
+            yield f'mixed/{name}/{operand_name}', operation, (value, operand)
+    yield 'hash', hash, (value,)
+    yield 'sort', sorted, (list(map(fraction_type, range(-500, 500))),)
+    yield (
+        'sort/random',
+        sorted,
+        ([to_operands(fraction_type, 64, seed)[0] for seed in range(1_000)],),
+    )
+    yield 'limit_denominator', fraction_type.limit_denominator, (value, 1_000)
+    yield 'round', round, (value,)
+    yield 'round/digits', round, (value, 3)
+    yield 'pickle/dumps', pickle.dumps, (value,)
+    yield 'pickle/loads', pickle.loads, (pickle.dumps(other),)
+    yield 'str', str, (value,)
+    yield 'repr', repr, (value,)
+
+
+def add_cmdline_args(command: list[str], args: argparse.Namespace) -> None:
+    command.extend(
+        ('--implementation', args.implementation, '--select', args.select)
+    )
+
+
+def main() -> None:
+    runner = pyperf.Runner(add_cmdline_args=add_cmdline_args)
+    runner.argparser.add_argument(
+        '--implementation', choices=IMPLEMENTATIONS, default='cfractions'
+    )
+    runner.argparser.add_argument('--select', default='')
+    args = runner.parse_args()
+    runner.metadata['fractions_implementation'] = args.implementation
+    for name, function, arguments in to_cases(
+        load_fraction_type(args.implementation)
+    ):
+        if args.select in name:
+            runner.bench_func(name, function, *arguments)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,87 @@
+"""Benchmarks of fractions arithmetic scaling across threads.
+
+Every thread runs the same independent workload,
+so on free-threaded builds of CPython throughput should grow
+with the number of threads, while with the GIL it stays flat.
+
+Run from the project root with ``python -m benchmarks.threads``.
+"""
+
+from __future__ import annotations
+
+import fractions
+import os
+import random
+import sys
+import threading
+import time
+from itertools import starmap
+from typing import Any
+
+import cfractions
+
+ITERATIONS = 5_000
+
+
+def to_terms(seed: int) -> list[tuple[int, int]]:
+    generator = random.Random(seed)
+    return [
+        (generator.getrandbits(30), generator.getrandbits(30) | 1)
+        for _ in range(64)
+    ]
+
+
+def run_workload(module: Any, terms: list[tuple[int, int]]) -> None:
+    values = list(starmap(module.Fraction, terms))
+    for index in range(ITERATIONS):
+        first, second = values[index % 64], values[(index * 7 + 3) % 64]
+        _ = ((first + second) * first / second - first // second) ** 2
+        _ = (first * second).limit_denominator(1_000)
+
+
+def measure(module: Any, threads_count: int) -> float:
+    barrier = threading.Barrier(threads_count + 1)
+
+    def work(seed: int) -> None:
+        terms = to_terms(seed)
+        barrier.wait()
+        run_workload(module, terms)
+
+    threads = [
+        threading.Thread(target=work, args=(seed,))
+        for seed in range(threads_count)
+    ]
+    for thread in threads:
+        thread.start()
+    barrier.wait()
+    start = time.perf_counter()
+    for thread in threads:
+        thread.join()
+    return threads_count * ITERATIONS / (time.perf_counter() - start)
+
+
+def main() -> None:
+    is_gil_enabled = getattr(sys, '_is_gil_enabled', lambda: True)()
+    sys.stdout.write(f'GIL enabled: {is_gil_enabled}\n')
+    sys.stdout.write(
+        f'{"module":<12}{"threads":>8}{"iterations/s":>16}{"speedup":>10}\n'
+    )
+    max_threads_count = os.cpu_count() or 1
+    threads_counts = sorted(
+        {1, *(1 << exponent for exponent in range(8)), max_threads_count}
+        & set(range(1, max_threads_count + 1))
+    )
+    for module in (fractions, cfractions):
+        base_throughput = None
+        for threads_count in threads_counts:
+            throughput = measure(module, threads_count)
+            if base_throughput is None:
+                base_throughput = throughput
+            sys.stdout.write(
+                f'{module.__name__:<12}{threads_count:>8}'
+                f'{throughput:>16.0f}{throughput / base_throughput:>9.2f}x\n'
+            )
+
+
+if __name__ == '__main__':
+    main()
@@ -4,14 +4,36 @@ from __future__ import annotations
 
 from typing import TYPE_CHECKING
 
+from ._c_api import get_include as get_include
+from ._expression import (
+    Expression as Expression,
+    compile as compile,  # ruff:ignore[builtin-import-shadowing]
+)
+from ._precision import precision_context as precision_context
+from ._rounding import (
+    ROUND_CEILING as ROUND_CEILING,
+    ROUND_DOWN as ROUND_DOWN,
+    ROUND_FLOOR as ROUND_FLOOR,
+    ROUND_HALF_DOWN as ROUND_HALF_DOWN,
+    ROUND_HALF_EVEN as ROUND_HALF_EVEN,
+    ROUND_HALF_UP as ROUND_HALF_UP,
+    ROUND_UP as ROUND_UP,
+)
+
 __version__ = '2.6.1'
 
 if TYPE_CHECKING:
     import numbers as _numbers
+    from collections.abc import (
+        Callable as _Callable,
+        Iterable as _Iterable,
+        Iterator as _Iterator,
+    )
     from fractions import Fraction as _Fraction
     from typing import Any as _Any, TypeAlias as _TypeAlias
 
     from typing_extensions import (
+        Buffer as _Buffer,
         Protocol as _Protocol,
         Self as _Self,
         final as _final,
@@ -33,12 +55,54 @@ if TYPE_CHECKING:
 
         def as_integer_ratio(self, /) -> tuple[int, int]: ...
 
+        def continued_fraction(self, /) -> _Iterator[int]: ...
+
+        def convergents(self, /) -> _Iterator[Fraction]: ...
+
+        @classmethod
+        def from_bytes(cls, data: _Buffer, /) -> _Self: ...
+
+        @classmethod
+        def from_continued_fraction(
+            cls, terms: _Iterable[int], /
+        ) -> _Self: ...
+
+        @classmethod
+        def from_float_shortest(cls, value: float, /) -> _Self: ...
+
         def is_integer(self, /) -> bool: ...
 
         def limit_denominator(
             self, max_denominator: int = 10**6, /
         ) -> _Self: ...
 
+        def quantize(
+            self, step: _Rational | _Self, /, rounding: str = ...
+        ) -> Fraction: ...
+
+        def root(
+            self, degree: int, /, max_denominator: int = ...
+        ) -> Fraction: ...
+
+        def sqrt(self, /, max_denominator: int = ...) -> Fraction: ...
+
+        def to_bytes(self, /) -> bytes: ...
+
+        @classmethod
+        def _restore(cls, numerator: int, denominator: int, /) -> _Self: ...
+
+        @classmethod
+        def _unpickle(cls, numerator: int, denominator: int, /) -> _Self: ...
+
+        def to_decimal_string(
+            self,
+            /,
+            max_digits: int | None = None,
+            *,
+            detect_period: bool = True,
+            base: int = 10,
+        ) -> str: ...
+
         @_overload
         def __new__(
             cls,
@@ -329,6 +393,395 @@ if TYPE_CHECKING:
 
         def __trunc__(self, /) -> int: ...
 
+    @_final
+    class LazyFraction:
+        @property
+        def numerator(self, /) -> int: ...
+
+        @property
+        def denominator(self, /) -> int: ...
+
+        def as_integer_ratio(self, /) -> tuple[int, int]: ...
+
+        def limit_denominator(
+            self, max_denominator: int = ..., /
+        ) -> Fraction: ...
+
+        def to_fraction(self, /) -> Fraction: ...
+
+        @_overload
+        def __new__(
+            cls,
+            value: _HasAsIntegerRatio
+            | _Rational
+            | Fraction
+            | _Self
+            | float
+            | str = ...,
+            _: None = ...,
+            /,
+        ) -> _Self: ...
+
+        @_overload
+        def __new__(cls, numerator: int, denominator: int, /) -> _Self: ...
+
+        def __new__(
+            cls,
+            numerator: _HasAsIntegerRatio
+            | _Rational
+            | Fraction
+            | _Self
+            | float
+            | str = ...,
+            denominator: int | None = None,
+            /,
+        ) -> _Self: ...
+
+        def __abs__(self, /) -> _Self: ...
+
+        @_overload
+        def __add__(self, other: Fraction | int | _Self, /) -> _Self: ...
+
+        @_overload
+        def __add__(self, other: float, /) -> float: ...
+
+        @_overload
+        def __add__(self, other: _Any, /) -> _Any: ...
+
+        def __add__(self, other: _Any, /) -> _Any: ...
+
+        def __bool__(self, /) -> bool: ...
+
+        def __ceil__(self, /) -> int: ...
+
+        def __copy__(self, /) -> _Self: ...
+
+        def __deepcopy__(
+            self, memo: dict[str, _Any] | None = None, /
+        ) -> _Self: ...
+
+        @_overload
+        def __divmod__(
+            self, divisor: _Rational | Fraction | _Self, /
+        ) -> tuple[int, Fraction]: ...
+
+        @_overload
+        def __divmod__(self, divisor: float, /) -> tuple[float, float]: ...
+
+        @_overload
+        def __divmod__(self, divisor: _Any, /) -> _Any: ...
+
+        def __divmod__(self, divisor: _Any, /) -> _Any: ...
+
+        @_overload
+        def __eq__(
+            self, other: _Rational | Fraction | _Self | float, /
+        ) -> bool: ...
+
+        @_overload
+        def __eq__(self, other: _Any, /) -> _Any: ...
+
+        def __eq__(self, other: _Any, /) -> _Any: ...
+
+        def __float__(self, /) -> float: ...
+
+        def __floor__(self, /) -> int: ...
+
+        @_overload
+        def __floordiv__(
+            self, divisor: _Rational | Fraction | _Self, /
+        ) -> int: ...
+
+        @_overload
+        def __floordiv__(self, divisor: float, /) -> float: ...
+
+        @_overload
+        def __floordiv__(self, divisor: _Any, /) -> _Any: ...
+
+        def __floordiv__(self, divisor: _Any, /) -> _Any: ...
+
+        @_overload
+        def __ge__(
+            self, other: _Rational | Fraction | _Self | float, /
+        ) -> bool: ...
+
+        @_overload
+        def __ge__(self, other: _Any, /) -> _Any: ...
+
+        def __ge__(self, other: _Any, /) -> _Any: ...
+
+        @_overload
+        def __gt__(
+            self, other: _Rational | Fraction | _Self | float, /
+        ) -> bool: ...
+
+        @_overload
+        def __gt__(self, other: _Any, /) -> _Any: ...
+
+        def __gt__(self, other: _Any, /) -> _Any: ...
+
+        def __hash__(self, /) -> int: ...
+
+        def __int__(self, /) -> int: ...
+
+        @_overload
+        def __le__(
+            self, other: _Rational | Fraction | _Self | float, /
+        ) -> bool: ...
+
+        @_overload
+        def __le__(self, other: _Any, /) -> _Any: ...
+
+        def __le__(self, other: _Any, /) -> _Any: ...
+
+        @_overload
+        def __lt__(
+            self, other: _Rational | Fraction | _Self | float, /
+        ) -> bool: ...
+
+        @_overload
+        def __lt__(self, other: _Any, /) -> _Any: ...
+
+        def __lt__(self, other: _Any, /) -> _Any: ...
+
+        @_overload
+        def __mod__(
+            self, divisor: _Rational | Fraction | _Self, /
+        ) -> Fraction: ...
+
+        @_overload
+        def __mod__(self, divisor: float, /) -> float: ...
+
+        @_overload
+        def __mod__(self, divisor: _Any, /) -> _Any: ...
+
+        def __mod__(self, divisor: _Any, /) -> _Any: ...
+
+        @_overload
+        def __mul__(self, other: Fraction | int | _Self, /) -> _Self: ...
+
+        @_overload
+        def __mul__(self, other: float, /) -> float: ...
+
+        @_overload
+        def __mul__(self, other: _Any, /) -> _Any: ...
+
+        def __mul__(self, other: _Any, /) -> _Any: ...
+
+        def __neg__(self, /) -> _Self: ...
+
+        def __pos__(self, /) -> _Self: ...
+
+        @_overload
+        def __pow__(self, exponent: int, /) -> Fraction: ...
+
+        @_overload
+        def __pow__(
+            self, exponent: _Rational | Fraction | _Self | float, /
+        ) -> Fraction | float: ...
+
+        @_overload
+        def __pow__(self, exponent: _Any, /) -> _Any: ...
+
+        def __pow__(self, exponent: _Any, /) -> _Any: ...
+
+        @_overload
+        def __radd__(self, other: Fraction | int | _Self, /) -> _Self: ...
+
+        @_overload
+        def __radd__(self, other: float, /) -> float: ...
+
+        @_overload
+        def __radd__(self, other: _Any, /) -> _Any: ...
+
+        def __radd__(self, other: _Any, /) -> _Any: ...
+
+        @_overload
+        def __rdivmod__(
+            self, dividend: _Rational | Fraction, /
+        ) -> tuple[int, Fraction]: ...
+
+        @_overload
+        def __rdivmod__(self, dividend: float, /) -> tuple[float, float]: ...
+
+        @_overload
+        def __rdivmod__(self, dividend: _Any, /) -> _Any: ...
+
+        def __rdivmod__(self, dividend: _Any, /) -> _Any: ...
+
+        @_overload
+        def __rfloordiv__(self, dividend: _Rational | Fraction, /) -> int: ...
+
+        @_overload
+        def __rfloordiv__(self, dividend: float, /) -> float: ...
+
+        @_overload
+        def __rfloordiv__(self, dividend: _Any, /) -> _Any: ...
+
+        def __rfloordiv__(self, dividend: _Any, /) -> _Any: ...
+
+        @_overload
+        def __rmod__(self, dividend: _Rational | Fraction, /) -> Fraction: ...
+
+        @_overload
+        def __rmod__(self, dividend: float, /) -> float: ...
+
+        @_overload
+        def __rmod__(self, dividend: _Any, /) -> _Any: ...
+
+        def __rmod__(self, dividend: _Any, /) -> _Any: ...
+
+        @_overload
+        def __rmul__(self, other: Fraction | int | _Self, /) -> _Self: ...
+
+        @_overload
+        def __rmul__(self, other: float, /) -> float: ...
+
+        @_overload
+        def __rmul__(self, other: _Any, /) -> _Any: ...
+
+        def __rmul__(self, other: _Any, /) -> _Any: ...
+
+        @_overload
+        def __round__(self, precision: None = ..., /) -> int: ...
+
+        @_overload
+        def __round__(self, precision: int, /) -> Fraction: ...
+
+        def __round__(
+            self, precision: int | None = ..., /
+        ) -> int | Fraction: ...
+
+        @_overload
+        def __rpow__(
+            self, base: _Rational | Fraction, /
+        ) -> Fraction | float: ...
+
+        @_overload
+        def __rpow__(self, base: float, /) -> float: ...
+
+        @_overload
+        def __rpow__(self, base: _Any, /) -> _Any: ...
+
+        def __rpow__(self, base: _Any, /) -> _Any: ...
+
+        @_overload
+        def __rsub__(self, other: Fraction | int | _Self, /) -> _Self: ...
+
+        @_overload
+        def __rsub__(self, other: float, /) -> float: ...
+
+        @_overload
+        def __rsub__(self, other: _Any, /) -> _Any: ...
+
+        def __rsub__(self, other: _Any, /) -> _Any: ...
+
+        @_overload
+        def __rtruediv__(self, other: Fraction | int | _Self, /) -> _Self: ...
+
+        @_overload
+        def __rtruediv__(self, other: float, /) -> float: ...
+
+        @_overload
+        def __rtruediv__(self, other: _Any, /) -> _Any: ...
+
+        def __rtruediv__(self, other: _Any, /) -> _Any: ...
+
+        @_overload
+        def __sub__(self, other: Fraction | int | _Self, /) -> _Self: ...
+
+        @_overload
+        def __sub__(self, other: float, /) -> float: ...
+
+        @_overload
+        def __sub__(self, other: _Any, /) -> _Any: ...
+
+        def __sub__(self, other: _Any, /) -> _Any: ...
+
+        @_overload
+        def __truediv__(self, other: Fraction | int | _Self, /) -> _Self: ...
+
+        @_overload
+        def __truediv__(self, other: float, /) -> float: ...
+
+        @_overload
+        def __truediv__(self, other: _Any, /) -> _Any: ...
+
+        def __truediv__(self, other: _Any, /) -> _Any: ...
+
+        def __trunc__(self, /) -> int: ...
+
+    @_final
+    class _FractionsIterator(_Iterator[Fraction]):
+        def fill(self, target: list[Fraction], /) -> int: ...
+
+        def __next__(self, /) -> Fraction: ...
+
+    _C_API: object
+
+    def _disable_stats() -> None: ...
+
+    def _enable_stats() -> None: ...
+
+    def _reset_stats() -> None: ...
+
+    def _stats() -> dict[str, _Any]: ...
+
+    def dumps_many(values: _Iterable[Fraction | int], /) -> bytes: ...
+
+    def farey(order: int, /) -> _FractionsIterator: ...
+
+    def limit_denominators(
+        values: _Iterable[Fraction | int], max_denominator: int = ..., /
+    ) -> list[Fraction]: ...
+
+    def loads_many(data: _Buffer, /) -> list[Fraction]: ...
+
+    def mediants(
+        lower_bound: _Rational | Fraction,
+        upper_bound: _Rational | Fraction,
+        depth: int,
+        /,
+    ) -> _FractionsIterator: ...
+
+    def parallel_dot(
+        xs: _Iterable[_Rational | Fraction],
+        ys: _Iterable[_Rational | Fraction],
+        /,
+        *,
+        workers: int | None = ...,
+    ) -> Fraction: ...
+
+    def parallel_sum(
+        values: _Iterable[_Rational | Fraction],
+        /,
+        *,
+        workers: int | None = ...,
+    ) -> Fraction: ...
+
+    def powers(
+        base: _Rational | Fraction, count: int, /
+    ) -> list[Fraction]: ...
+
+    def quantize_many(
+        values: _Iterable[Fraction | int],
+        step: _Rational | Fraction,
+        /,
+        rounding: str = ...,
+    ) -> list[Fraction]: ...
+
+    def set_growth_hook(
+        threshold_bits: int, hook: _Callable[[int, int], _Any] | None, /
+    ) -> None: ...
+
+    def simplest_between(
+        lower_bound: _Rational | Fraction,
+        upper_bound: _Rational | Fraction,
+        /,
+        *,
+        inclusive: bool = ...,
+    ) -> Fraction: ...
+
 else:
     try:
         from . import _cfractions
@@ -336,5 +789,54 @@ else:
         from . import _fractions
 
         Fraction = _fractions.Fraction
+        LazyFraction = _fractions.LazyFraction
+        dumps_many = _fractions.dumps_many
+        farey = _fractions.farey
+        limit_denominators = _fractions.limit_denominators
+        loads_many = _fractions.loads_many
+        mediants = _fractions.mediants
+        parallel_dot = _fractions.parallel_dot
+        parallel_sum = _fractions.parallel_sum
+        powers = _fractions.powers
+        quantize_many = _fractions.quantize_many
+        set_growth_hook = _fractions.set_growth_hook
+        simplest_between = _fractions.simplest_between
+        _disable_stats = (
+            _fractions._disable_stats  # ruff:ignore[private-member-access]
+        )
+        _enable_stats = (
+            _fractions._enable_stats  # ruff:ignore[private-member-access]
+        )
+        _reset_stats = (
+            _fractions._reset_stats  # ruff:ignore[private-member-access]
+        )
+        _stats = (
+            _fractions._stats  # ruff:ignore[private-member-access]
+        )
     else:
         Fraction = _cfractions.Fraction
+        LazyFraction = _cfractions.LazyFraction
+        _C_API = _cfractions._C_API  # ruff:ignore[private-member-access]
+        dumps_many = _cfractions.dumps_many
+        farey = _cfractions.farey
+        limit_denominators = _cfractions.limit_denominators
+        loads_many = _cfractions.loads_many
+        mediants = _cfractions.mediants
+        parallel_dot = _cfractions.parallel_dot
+        parallel_sum = _cfractions.parallel_sum
+        powers = _cfractions.powers
+        quantize_many = _cfractions.quantize_many
+        set_growth_hook = _cfractions.set_growth_hook
+        simplest_between = _cfractions.simplest_between
+        _disable_stats = (
+            _cfractions._disable_stats  # ruff:ignore[private-member-access]
+        )
+        _enable_stats = (
+            _cfractions._enable_stats  # ruff:ignore[private-member-access]
+        )
+        _reset_stats = (
+            _cfractions._reset_stats  # ruff:ignore[private-member-access]
+        )
+        _stats = (
+            _cfractions._stats  # ruff:ignore[private-member-access]
+        )
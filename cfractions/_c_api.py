@@ -0,0 +1,5 @@
+import os as _os
+
+
+def get_include() -> str:
+    return _os.path.join(_os.path.dirname(__file__), 'include')
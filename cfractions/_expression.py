@@ -0,0 +1,456 @@
+"""Compilation of arithmetic expressions over fractions.
+
+Expressions are built into a DAG over ``+``, ``-``, ``*`` & ``/``
+whose nodes are pairs of numerator & denominator of integer DAGs,
+so common denominators are pushed through it algebraically
+and evaluation runs a straight-line program over integers
+with a single reduction of the final numerator & denominator.
+Numerators of divisors are checked for zeros in order of evaluation,
+so division by zero fails even if it vanishes algebraically.
+"""
+
+from __future__ import annotations
+
+import ast as _ast
+import inspect as _inspect
+import numbers as _numbers
+from collections.abc import Callable, Iterable, Mapping, Sequence
+from typing import Any, TYPE_CHECKING, TypeAlias, final
+
+if TYPE_CHECKING:
+    from typing_extensions import Buffer
+
+    from . import Fraction
+
+    _Column: TypeAlias = Iterable['Fraction | int'] | Buffer
+    _Program: TypeAlias = tuple[
+        int,
+        tuple[int, ...],
+        tuple[tuple[int, int, int], ...],
+        tuple[tuple[int, int, int], ...],
+        int,
+        int,
+    ]
+
+    def _evaluate_many(
+        program: _Program, columns: Sequence[_Column], /
+    ) -> list[Fraction]: ...
+
+else:
+    try:
+        from ._cfractions import Fraction, _evaluate_many
+    except ImportError:
+        from ._fractions import Fraction, _evaluate_many
+
+_ADD, _SUBTRACT, _MULTIPLY = range(3)
+
+
+def compile(  # ruff:ignore[builtin-variable-shadowing]
+    expression: str | Callable[..., Any], /
+) -> Expression:
+    if isinstance(expression, str):
+        try:
+            tree = _ast.parse(expression.strip(), mode='eval')
+        except SyntaxError as error:
+            raise ValueError(f'Invalid expression: {expression!r}.') from error
+        names = sorted(
+            (node for node in _ast.walk(tree) if isinstance(node, _ast.Name)),
+            key=lambda node: (node.lineno, node.col_offset),
+        )
+        symbols = tuple(dict.fromkeys(node.id for node in names))
+        builder = _ProgramBuilder(symbols)
+        result = _ExpressionParser(builder).visit(tree.body)
+    elif callable(expression):
+        symbols = tuple(
+            parameter.name
+            for parameter in _inspect.signature(expression).parameters.values()
+        )
+        builder = _ProgramBuilder(symbols)
+        result = builder.to_value(expression(*map(builder.symbol, symbols)))
+    else:
+        raise TypeError(
+            'Expression should be a string or a callable, '
+            f'but got {expression!r}.'
+        )
+    return Expression(symbols, builder.to_program(result))
+
+
+@final
+class Expression:
+    @property
+    def symbols(self, /) -> tuple[str, ...]:
+        return self._symbols
+
+    def evaluate_many(
+        self, columns: Sequence[_Column] | Mapping[str, _Column], /
+    ) -> list[Fraction]:
+        if isinstance(columns, Mapping):
+            missing_symbols = [
+                symbol for symbol in self._symbols if symbol not in columns
+            ]
+            if missing_symbols:
+                raise KeyError(
+                    f'Columns are missing for symbols {missing_symbols!r}.'
+                )
+            columns = [columns[symbol] for symbol in self._symbols]
+        return _evaluate_many(self._program, columns)
+
+    _program: _Program
+    _symbols: tuple[str, ...]
+
+    __slots__ = ('_program', '_symbols')
+
+    def __init__(self, symbols: tuple[str, ...], program: _Program, /) -> None:
+        self._program, self._symbols = program, symbols
+
+    def __call__(self, *values: Fraction | int) -> Fraction:
+        if len(values) != len(self._symbols):
+            raise TypeError(
+                f'Expected {len(self._symbols)} values, but got {len(values)}.'
+            )
+        if not values:
+            _, constants, _, divisions, numerator, denominator = self._program
+            for (
+                dividend_numerator,
+                dividend_denominator,
+                divisor_numerator,
+            ) in divisions:
+                if not constants[divisor_numerator]:
+                    # fails with the error of the division operator
+                    Fraction(
+                        constants[dividend_numerator],
+                        constants[dividend_denominator],
+                    ) / 0
+            return Fraction(constants[numerator], constants[denominator])
+        return _evaluate_many(self._program, [[value] for value in values])[0]
+
+    def __repr__(self, /) -> str:
+        return (
+            f'<{type(self).__qualname__} over {self._symbols!r} '
+            f'with {len(self._program[2])} instructions>'
+        )
+
+
+@final
+class _ProgramBuilder:
+    """Builds DAG of integer nodes with hash-consing & constant folding.
+
+    Nodes are identified by integers, a node of ``index``-th symbol
+    numerator is ``2 * index`` and denominator is ``2 * index + 1``.
+    """
+
+    def add(self, first: int, second: int, /) -> int:
+        first_value, second_value = (
+            self._constants.get(first),
+            self._constants.get(second),
+        )
+        if first_value == 0:
+            return second
+        if second_value == 0:
+            return first
+        if first_value is not None and second_value is not None:
+            return self.constant(first_value + second_value)
+        return self._instruction(_ADD, min(first, second), max(first, second))
+
+    def constant(self, value: int, /) -> int:
+        try:
+            return self._constants_nodes[value]
+        except KeyError:
+            node = self._constants_nodes[value] = self._new_node()
+            self._constants[node] = value
+            return node
+
+    def divide(self, dividend: _Value, divisor: _Value, /) -> _Value:
+        # divisors with non-zero constant numerators need no checks
+        if not self._constants.get(divisor.numerator):
+            self._divisions.setdefault(
+                (dividend.numerator, dividend.denominator, divisor.numerator)
+            )
+        return _Value(
+            self,
+            self.multiply(dividend.numerator, divisor.denominator),
+            self.multiply(dividend.denominator, divisor.numerator),
+        )
+
+    def multiply(self, first: int, second: int, /) -> int:
+        first_value, second_value = (
+            self._constants.get(first),
+            self._constants.get(second),
+        )
+        if first_value == 0 or second_value == 1:
+            return first
+        if second_value == 0 or first_value == 1:
+            return second
+        if first_value is not None and second_value is not None:
+            return self.constant(first_value * second_value)
+        return self._instruction(
+            _MULTIPLY, min(first, second), max(first, second)
+        )
+
+    def subtract(self, first: int, second: int, /) -> int:
+        if first == second:
+            return self.constant(0)
+        first_value, second_value = (
+            self._constants.get(first),
+            self._constants.get(second),
+        )
+        if second_value == 0:
+            return first
+        if first_value is not None and second_value is not None:
+            return self.constant(first_value - second_value)
+        return self._instruction(_SUBTRACT, first, second)
+
+    def symbol(self, name: str, /) -> _Value:
+        index = self._symbols.index(name)
+        return _Value(self, 2 * index, 2 * index + 1)
+
+    def to_program(self, value: _Value, /) -> _Program:
+        inputs_count = 2 * len(self._symbols)
+        reachable = self._to_reachable(
+            {value.numerator, value.denominator}.union(*self._divisions)
+        )
+        constants_nodes = sorted(
+            node for node in reachable if node in self._constants
+        )
+        instructions_nodes = sorted(
+            node for node in reachable if node in self._instructions
+        )
+        registers = {node: node for node in range(inputs_count)}
+        registers.update(
+            (node, register)
+            for register, node in enumerate(
+                constants_nodes + instructions_nodes, start=inputs_count
+            )
+        )
+        return (
+            inputs_count,
+            tuple(self._constants[node] for node in constants_nodes),
+            tuple(
+                (opcode, registers[first], registers[second])
+                for opcode, first, second in map(
+                    self._instructions.__getitem__, instructions_nodes
+                )
+            ),
+            tuple(
+                (
+                    registers[dividend_numerator],
+                    registers[dividend_denominator],
+                    registers[divisor_numerator],
+                )
+                for (
+                    dividend_numerator,
+                    dividend_denominator,
+                    divisor_numerator,
+                ) in self._divisions
+            ),
+            registers[value.numerator],
+            registers[value.denominator],
+        )
+
+    def to_value(self, value: Any, /) -> _Value:
+        if isinstance(value, _Value):
+            if value.builder is not self:
+                raise ValueError('Values belong to different expressions.')
+            return value
+        if isinstance(value, _numbers.Rational):
+            return _Value(
+                self,
+                self.constant(int(value.numerator)),
+                self.constant(int(value.denominator)),
+            )
+        raise TypeError(
+            f'Operands should be rational numbers, but got {value!r}.'
+        )
+
+    _constants: dict[int, int]
+    _constants_nodes: dict[int, int]
+    _divisions: dict[tuple[int, int, int], None]
+    _instructions: dict[int, tuple[int, int, int]]
+    _instructions_nodes: dict[tuple[int, int, int], int]
+    _nodes_count: int
+    _symbols: tuple[str, ...]
+
+    __slots__ = (
+        '_constants',
+        '_constants_nodes',
+        '_divisions',
+        '_instructions',
+        '_instructions_nodes',
+        '_nodes_count',
+        '_symbols',
+    )
+
+    def __init__(self, symbols: tuple[str, ...], /) -> None:
+        self._constants, self._constants_nodes = {}, {}
+        self._divisions = {}
+        self._instructions, self._instructions_nodes = {}, {}
+        self._nodes_count, self._symbols = 0, symbols
+
+    def _instruction(self, opcode: int, first: int, second: int, /) -> int:
+        key = (opcode, first, second)
+        try:
+            return self._instructions_nodes[key]
+        except KeyError:
+            node = self._instructions_nodes[key] = self._new_node()
+            self._instructions[node] = key
+            return node
+
+    def _new_node(self, /) -> int:
+        node = 2 * len(self._symbols) + self._nodes_count
+        self._nodes_count += 1
+        return node
+
+    def _to_reachable(self, nodes: set[int], /) -> set[int]:
+        result: set[int] = set()
+        while nodes:
+            node = nodes.pop()
+            if node in result:
+                continue
+            result.add(node)
+            instruction = self._instructions.get(node)
+            if instruction is not None:
+                _, first, second = instruction
+                nodes.update((first, second))
+        return result
+
+
+@final
+class _Value:
+    """Rational node as a pair of numerator & denominator integer nodes."""
+
+    builder: _ProgramBuilder
+    denominator: int
+    numerator: int
+
+    __slots__ = ('builder', 'denominator', 'numerator')
+
+    def __init__(
+        self, builder: _ProgramBuilder, numerator: int, denominator: int, /
+    ) -> None:
+        self.builder, self.numerator, self.denominator = (
+            builder,
+            numerator,
+            denominator,
+        )
+
+    def __add__(self, other: Any, /) -> _Value:
+        return _add_values(self, self.builder.to_value(other))
+
+    def __mul__(self, other: Any, /) -> _Value:
+        return _multiply_values(self, self.builder.to_value(other))
+
+    def __neg__(self, /) -> _Value:
+        builder = self.builder
+        return _Value(
+            builder,
+            builder.subtract(builder.constant(0), self.numerator),
+            self.denominator,
+        )
+
+    def __pos__(self, /) -> _Value:
+        return self
+
+    def __radd__(self, other: Any, /) -> _Value:
+        return _add_values(self.builder.to_value(other), self)
+
+    def __rmul__(self, other: Any, /) -> _Value:
+        return _multiply_values(self.builder.to_value(other), self)
+
+    def __rsub__(self, other: Any, /) -> _Value:
+        return _subtract_values(self.builder.to_value(other), self)
+
+    def __rtruediv__(self, other: Any, /) -> _Value:
+        return _divide_values(self.builder.to_value(other), self)
+
+    def __sub__(self, other: Any, /) -> _Value:
+        return _subtract_values(self, self.builder.to_value(other))
+
+    def __truediv__(self, other: Any, /) -> _Value:
+        return _divide_values(self, self.builder.to_value(other))
+
+
+@final
+class _ExpressionParser(_ast.NodeVisitor):
+    def __init__(self, builder: _ProgramBuilder, /) -> None:
+        self._builder = builder
+
+    def generic_visit(self, node: _ast.AST) -> Any:
+        raise ValueError(f'Unsupported expression: {_ast.unparse(node)!r}.')
+
+    def visit_BinOp(self, node: _ast.BinOp) -> _Value:
+        operation = _BINARY_OPERATIONS.get(type(node.op))
+        if operation is None:
+            return self.generic_visit(node)  # type: ignore[no-any-return]
+        return operation(self.visit(node.left), self.visit(node.right))
+
+    def visit_Constant(self, node: _ast.Constant) -> _Value:
+        if type(node.value) is not int:
+            return self.generic_visit(node)  # type: ignore[no-any-return]
+        return self._builder.to_value(node.value)
+
+    def visit_Name(self, node: _ast.Name) -> _Value:
+        return self._builder.symbol(node.id)
+
+    def visit_UnaryOp(self, node: _ast.UnaryOp) -> _Value:
+        if isinstance(node.op, _ast.USub):
+            return -self.visit(node.operand)  # type: ignore[no-any-return]
+        if isinstance(node.op, _ast.UAdd):
+            return self.visit(node.operand)  # type: ignore[no-any-return]
+        return self.generic_visit(node)  # type: ignore[no-any-return]
+
+
+def _add_values(first: _Value, second: _Value, /) -> _Value:
+    builder = first.builder
+    if first.denominator == second.denominator:
+        return _Value(
+            builder,
+            builder.add(first.numerator, second.numerator),
+            first.denominator,
+        )
+    return _Value(
+        builder,
+        builder.add(
+            builder.multiply(first.numerator, second.denominator),
+            builder.multiply(second.numerator, first.denominator),
+        ),
+        builder.multiply(first.denominator, second.denominator),
+    )
+
+
+def _divide_values(dividend: _Value, divisor: _Value, /) -> _Value:
+    return dividend.builder.divide(dividend, divisor)
+
+
+def _multiply_values(first: _Value, second: _Value, /) -> _Value:
+    builder = first.builder
+    return _Value(
+        builder,
+        builder.multiply(first.numerator, second.numerator),
+        builder.multiply(first.denominator, second.denominator),
+    )
+
+
+def _subtract_values(minuend: _Value, subtrahend: _Value, /) -> _Value:
+    builder = minuend.builder
+    if minuend.denominator == subtrahend.denominator:
+        return _Value(
+            builder,
+            builder.subtract(minuend.numerator, subtrahend.numerator),
+            minuend.denominator,
+        )
+    return _Value(
+        builder,
+        builder.subtract(
+            builder.multiply(minuend.numerator, subtrahend.denominator),
+            builder.multiply(subtrahend.numerator, minuend.denominator),
+        ),
+        builder.multiply(minuend.denominator, subtrahend.denominator),
+    )
+
+
+_BINARY_OPERATIONS: dict[type[_ast.operator], Callable[[Any, Any], _Value]] = {
+    _ast.Add: _add_values,
+    _ast.Div: _divide_values,
+    _ast.Mult: _multiply_values,
+    _ast.Sub: _subtract_values,
+}
@@ -1,8 +1,17 @@
 from __future__ import annotations
 
+import math as _math
 import numbers as _numbers
+import operator as _operator
 import sys
+from collections.abc import (
+    Callable as _Callable,
+    Iterable as _Iterable,
+    Iterator as _Iterator,
+)
+from contextvars import ContextVar as _ContextVar
 from fractions import Fraction as _Fraction
+from itertools import islice as _islice
 from typing import (
     Any as _Any,
     Protocol,
@@ -13,8 +22,18 @@ from typing import (
     overload as _overload,
 )
 
+from ._rounding import (
+    ROUND_CEILING,
+    ROUND_DOWN,
+    ROUND_FLOOR,
+    ROUND_HALF_DOWN,
+    ROUND_HALF_EVEN,
+    ROUND_HALF_UP,
+    ROUND_UP,
+)
+
 if TYPE_CHECKING:
-    from typing_extensions import Self
+    from typing_extensions import Buffer as _Buffer, Self
 
     _Rational: _TypeAlias = _Fraction | _numbers.Rational | int
 
@@ -43,11 +62,255 @@ class Fraction:
         def is_integer(self, /) -> bool:
             return self.denominator == 1
 
+    def continued_fraction(self, /) -> _Iterator[int]:
+        numerator, denominator = self.numerator, self.denominator
+        while denominator:
+            quotient, remainder = divmod(numerator, denominator)
+            yield quotient
+            numerator, denominator = denominator, remainder
+
+    def convergents(self, /) -> _Iterator[Fraction]:
+        previous_numerator, previous_denominator, numerator, denominator = (
+            0,
+            1,
+            1,
+            0,
+        )
+        for term in self.continued_fraction():
+            (
+                previous_numerator,
+                previous_denominator,
+                numerator,
+                denominator,
+            ) = (
+                numerator,
+                denominator,
+                term * numerator + previous_numerator,
+                term * denominator + previous_denominator,
+            )
+            yield Fraction(numerator, denominator)
+
+    @classmethod
+    def from_bytes(cls, data: _Buffer, /) -> Self:
+        data = bytes(data)
+        numerator, denominator, position = _decode_fraction_components(data, 0)
+        if position != len(data):
+            raise ValueError('Data has trailing bytes.')
+        return cls(numerator, denominator)
+
+    @classmethod
+    def from_continued_fraction(cls, terms: _Iterable[int], /) -> Self:
+        try:
+            terms = list(terms)
+        except TypeError:
+            raise TypeError(
+                'Terms should be an iterable of integers.'
+            ) from None
+        if not terms:
+            raise ValueError('Terms should not be empty.')
+        for index, term in enumerate(terms):
+            if not isinstance(term, int):
+                raise TypeError(f'Terms should be integers, but got {term!r}.')
+            if index > 0 and term <= 0:
+                raise ValueError(
+                    'Terms after the first one should be positive, '
+                    f'but got {term!r}.'
+                )
+        numerator, _, denominator, _ = _continued_fraction_terms_product(
+            terms, 0, len(terms)
+        )
+        return cls(numerator, denominator)
+
+    @classmethod
+    def from_float_shortest(cls, value: float, /) -> Self:
+        if not isinstance(value, float):
+            raise TypeError(f'Value should be a float, but got {value!r}.')
+        if _math.isinf(value):
+            raise OverflowError('Cannot construct Fraction from infinity.')
+        if _math.isnan(value):
+            raise ValueError('Cannot construct Fraction from NaN.')
+        if not value:
+            return cls(0)
+        significand, exponent = _math.frexp(abs(value))
+        mantissa = int(_math.ldexp(significand, _FLOAT_MANTISSA_SIZE))
+        exponent -= _FLOAT_MANTISSA_SIZE
+        if exponent < _MIN_FLOAT_EXPONENT:
+            mantissa >>= _MIN_FLOAT_EXPONENT - exponent
+            exponent = _MIN_FLOAT_EXPONENT
+        # the value is what its half-ulp neighbourhood rounds to,
+        # ties are included for even mantissas,
+        # the neighbourhood is narrower below powers of two
+        is_power_of_two = (
+            mantissa == 1 << (_FLOAT_MANTISSA_SIZE - 1)
+            and exponent > _MIN_FLOAT_EXPONENT
+        )
+        numerator, denominator = _simplest_between_components(
+            *(
+                _binary_fraction_components(4 * mantissa - 1, exponent - 2)
+                if is_power_of_two
+                else _binary_fraction_components(
+                    2 * mantissa - 1, exponent - 1
+                )
+            ),
+            *_binary_fraction_components(2 * mantissa + 1, exponent - 1),
+            inclusive=not mantissa & 1,
+        )
+        return cls(-numerator if value < 0 else numerator, denominator)
+
     def limit_denominator(self, max_denominator: int = 10**6, /) -> Self:
         return self._to_fraction_if_std_fraction(
             self._value.limit_denominator(max_denominator)
         )
 
+    def quantize(
+        self, step: _Rational | Self, /, rounding: str = ROUND_HALF_EVEN
+    ) -> Fraction:
+        _validate_rounding_mode(rounding)
+        step_numerator, step_denominator = _parse_quantization_step(step)
+        return _quantize_components(
+            self.numerator,
+            self.denominator,
+            step_numerator,
+            step_denominator,
+            rounding,
+        )
+
+    def root(self, degree: int, /, max_denominator: int = 10**6) -> Fraction:
+        if not isinstance(degree, int):
+            raise TypeError(
+                f'Degree should be an integer, but got {degree!r}.'
+            )
+        if degree <= 0:
+            raise ValueError('Degree should be positive.')
+        if degree >= 1 << 63:
+            raise OverflowError('Degree is too large.')
+        max_denominator = _operator.index(max_denominator)
+        if max_denominator < 1:
+            raise ValueError('`max_denominator` should not be less than 1.')
+        numerator, denominator = self.numerator, self.denominator
+        is_negative = numerator < 0
+        if is_negative and degree % 2 == 0:
+            raise ValueError(
+                'Root of even degree should have non-negative base.'
+            )
+        numerator_modulus = abs(numerator)
+        root_numerator = _exact_root(numerator_modulus, degree)
+        root_denominator = _exact_root(denominator, degree)
+        if root_numerator is not None and root_denominator is not None:
+            return Fraction(
+                -root_numerator if is_negative else root_numerator,
+                root_denominator,
+            ).limit_denominator(max_denominator)
+        # the root is irrational, so it lies strictly inside the bracket
+        # and `limit_denominator` agreeing on both bracket ends
+        # agrees on the root as well, since it is monotonic
+        precision = 2 * max_denominator.bit_length() + 8
+        while True:
+            lower_numerator = _integer_root(
+                (numerator_modulus << precision * degree) // denominator,
+                degree,
+            )
+            lower_bound = Fraction(
+                lower_numerator, 1 << precision
+            ).limit_denominator(max_denominator)
+            upper_bound = Fraction(
+                lower_numerator + 1, 1 << precision
+            ).limit_denominator(max_denominator)
+            if lower_bound == upper_bound:
+                return -lower_bound if is_negative else lower_bound
+            precision *= 2
+
+    def sqrt(self, /, max_denominator: int = 10**6) -> Fraction:
+        return self.root(2, max_denominator)
+
+    def to_bytes(self, /) -> bytes:
+        return _encode_term(self.numerator) + _encode_term(self.denominator)
+
+    def to_decimal_string(
+        self,
+        /,
+        max_digits: int | None = None,
+        *,
+        detect_period: bool = True,
+        base: int = 10,
+    ) -> str:
+        if max_digits is not None:
+            if not isinstance(max_digits, int):
+                raise TypeError(
+                    '`max_digits` should be either an integer or `None`.'
+                )
+            if max_digits < 0:
+                raise ValueError('`max_digits` should be non-negative.')
+        if not 2 <= base <= 36:
+            raise ValueError('`base` should be in range from 2 to 36.')
+        numerator, denominator = self.numerator, self.denominator
+        sign = '-' if numerator < 0 else ''
+        integral_part, remainder = divmod(abs(numerator), denominator)
+        integral_part_string = _to_digits_string(integral_part, base, 0)
+        if not remainder:
+            return sign + integral_part_string
+        # the length of non-repeating part equals to the number of steps
+        # needed to strip all prime factors of the base from the denominator
+        prefix_size, periodic_denominator = 0, denominator
+        while max_digits is None or prefix_size <= max_digits:
+            gcd = _math.gcd(periodic_denominator, base)
+            if gcd == 1:
+                break
+            periodic_denominator //= gcd
+            prefix_size += 1
+        else:
+            return _to_truncated_digits_string(
+                sign,
+                integral_part_string,
+                remainder,
+                denominator,
+                base,
+                max_digits,
+            )
+        prefix, rest = divmod(remainder * base**prefix_size, denominator)
+        prefix_string = (
+            _to_digits_string(prefix, base, prefix_size) if prefix_size else ''
+        )
+        if not rest:
+            return f'{sign}{integral_part_string}.{prefix_string}'
+        if not detect_period:
+            if max_digits is None:
+                raise ValueError(
+                    'Expansion is infinite, '
+                    '`max_digits` should be specified '
+                    'when period detection is disabled.'
+                )
+            return _to_truncated_digits_string(
+                sign,
+                integral_part_string,
+                remainder,
+                denominator,
+                base,
+                max_digits,
+            )
+        period_size = _multiplicative_order(
+            base,
+            periodic_denominator,
+            None if max_digits is None else max_digits - prefix_size,
+        )
+        if period_size is None:
+            assert max_digits is not None
+            return _to_truncated_digits_string(
+                sign,
+                integral_part_string,
+                remainder,
+                denominator,
+                base,
+                max_digits,
+            )
+        # the period is the numerator of the purely periodic remainder
+        # brought to the denominator of form `base ** period_size - 1`
+        period = rest * (base**period_size - 1) // denominator
+        return (
+            f'{sign}{integral_part_string}.{prefix_string}'
+            f'({_to_digits_string(period, base, period_size)})'
+        )
+
     __module__ = 'cfractions'
     __slots__ = ('_value',)
 
@@ -106,6 +369,8 @@ class Fraction:
             value = _Fraction(numerator, denominator)
         self = super().__new__(cls)
         self._value = value
+        if _growth_hook is not None:
+            _check_growth(value)
         return self
 
     def __abs__(self, /) -> Self:
@@ -121,7 +386,7 @@ class Fraction:
     def __add__(self, other: _Any, /) -> _Any: ...
 
     def __add__(self, other: _Any, /) -> _Any:
-        return self._to_fraction_if_std_fraction(
+        return self._to_limited_fraction_if_std_fraction(
             self._value + _to_std_fraction_if_rational(other)
         )
 
@@ -266,7 +531,7 @@ class Fraction:
     def __mul__(self, other: _Any, /) -> _Any: ...
 
     def __mul__(self, other: _Any, /) -> _Any:
-        return self._to_fraction_if_std_fraction(
+        return self._to_limited_fraction_if_std_fraction(
             self._value * _to_std_fraction_if_rational(other)
         )
 
@@ -288,6 +553,9 @@ class Fraction:
     def __pow__(self, exponent: _Any, /) -> _Any: ...
 
     def __pow__(self, exponent: _Any, /) -> _Any:
+        result = _exact_power(self.numerator, self.denominator, exponent)
+        if result is not None:
+            return result
         return self._to_fraction_if_std_fraction(
             self._value ** _to_std_fraction_if_rational(exponent)
         )
@@ -302,10 +570,18 @@ class Fraction:
     def __radd__(self, other: _Any, /) -> _Any: ...
 
     def __radd__(self, other: _Any, /) -> _Any:
-        return self._to_fraction_if_std_fraction(
+        return self._to_limited_fraction_if_std_fraction(
             _to_std_fraction_if_rational(other) + self._value
         )
 
+    def __reduce__(
+        self, /
+    ) -> tuple[_Callable[[int, int], Self], tuple[int, int]]:
+        return (
+            type(self)._unpickle,  # ruff:ignore[private-member-access]
+            (self.numerator, self.denominator),
+        )
+
     @_overload
     def __rdivmod__(self, dividend: _Rational, /) -> tuple[int, Self]: ...
 
@@ -360,7 +636,7 @@ class Fraction:
     def __rmul__(self, other: _Any, /) -> _Any: ...
 
     def __rmul__(self, other: _Any, /) -> _Any:
-        return self._to_fraction_if_std_fraction(
+        return self._to_limited_fraction_if_std_fraction(
             _to_std_fraction_if_rational(other) * self._value
         )
 
@@ -383,6 +659,19 @@ class Fraction:
     def __rpow__(self, base: _Any, /) -> _Any: ...
 
     def __rpow__(self, base: _Any, /) -> _Any:
+        if isinstance(base, int | _numbers.Rational):
+            base_numerator, base_denominator = (
+                int(base.numerator),
+                int(base.denominator),
+            )
+            if base_denominator < 0:
+                base_numerator, base_denominator = (
+                    -base_numerator,
+                    -base_denominator,
+                )
+            result = _exact_power(base_numerator, base_denominator, self)
+            if result is not None:
+                return result
         return self._to_fraction_if_std_fraction(
             _to_std_fraction_if_rational(base) ** self._value
         )
@@ -397,7 +686,7 @@ class Fraction:
     def __rsub__(self, minuend: _Any, /) -> _Any: ...
 
     def __rsub__(self, minuend: _Any, /) -> _Any:
-        return self._to_fraction_if_std_fraction(
+        return self._to_limited_fraction_if_std_fraction(
             _to_std_fraction_if_rational(minuend) - self._value
         )
 
@@ -411,7 +700,7 @@ class Fraction:
     def __rtruediv__(self, dividend: _Any, /) -> _Any: ...
 
     def __rtruediv__(self, dividend: _Any, /) -> _Any:
-        return self._to_fraction_if_std_fraction(
+        return self._to_limited_fraction_if_std_fraction(
             _to_std_fraction_if_rational(dividend) / self._value
         )
 
@@ -428,7 +717,7 @@ class Fraction:
     def __sub__(self, subtrahend: _Any, /) -> _Any: ...
 
     def __sub__(self, subtrahend: _Any, /) -> _Any:
-        return self._to_fraction_if_std_fraction(
+        return self._to_limited_fraction_if_std_fraction(
             self._value - _to_std_fraction_if_rational(subtrahend)
         )
 
@@ -442,13 +731,55 @@ class Fraction:
     def __truediv__(self, divisor: _Any, /) -> _Any: ...
 
     def __truediv__(self, divisor: _Any, /) -> _Any:
-        return self._to_fraction_if_std_fraction(
+        return self._to_limited_fraction_if_std_fraction(
             self._value / _to_std_fraction_if_rational(divisor)
         )
 
     def __trunc__(self, /) -> int:
         return self._value.__trunc__()
 
+    @classmethod
+    def _restore(cls, numerator: int, denominator: int, /) -> Self:
+        if not (
+            type(numerator) is int
+            and type(denominator) is int
+            and denominator > 0
+        ):
+            raise ValueError(
+                'Numerator & denominator should be integers '
+                'with positive denominator.'
+            )
+        if _math.gcd(numerator, denominator) != 1:
+            raise ValueError('Numerator & denominator should be coprime.')
+        return cls._from_normalized_components(numerator, denominator)
+
+    @classmethod
+    def _unpickle(cls, numerator: int, denominator: int, /) -> Self:
+        # unpickling executes arbitrary code anyway, so data is trusted
+        if not (type(numerator) is int and type(denominator) is int):
+            raise TypeError('Numerator & denominator should be integers.')
+        return cls._from_normalized_components(numerator, denominator)
+
+    @classmethod
+    def _from_normalized_components(
+        cls, numerator: int, denominator: int, /
+    ) -> Self:
+        value = _to_normalized_std_fraction(numerator, denominator)
+        self = super().__new__(cls)
+        self._value = value
+        if _growth_hook is not None:
+            _check_growth(value)
+        return self
+
+    @classmethod
+    def _to_limited_fraction_if_std_fraction(cls, value: _Any, /) -> _Any:
+        result = cls._to_fraction_if_std_fraction(value)
+        if _is_precision_used and isinstance(result, Fraction):
+            precision = _precision.get(None)
+            if precision is not None:
+                result = _limit_precision(result, precision)
+        return result
+
     @classmethod
     @_overload
     def _to_fraction_if_std_fraction(cls, value: _Fraction, /) -> Self: ...
@@ -466,6 +797,1412 @@ class Fraction:
         )
 
 
+@_final
+@_numbers.Rational.register
+class LazyFraction:
+    @property
+    def numerator(self, /) -> int:
+        return self._reduce()[0]
+
+    @property
+    def denominator(self, /) -> int:
+        return self._reduce()[1]
+
+    def as_integer_ratio(self, /) -> tuple[int, int]:
+        return self._reduce()
+
+    def limit_denominator(self, max_denominator: int = 10**6, /) -> Fraction:
+        return self.to_fraction().limit_denominator(max_denominator)
+
+    def to_fraction(self, /) -> Fraction:
+        return Fraction(*self._reduce())
+
+    __module__ = 'cfractions'
+    __slots__ = (
+        '_denominator',
+        '_is_reduced',
+        '_numerator',
+        '_reduction_bits',
+    )
+
+    _denominator: int
+    _is_reduced: bool
+    _numerator: int
+    _reduction_bits: int
+
+    @_overload
+    def __new__(
+        cls,
+        value: _HasAsIntegerRatio | _Rational | Self | float | str = ...,
+        _: None = ...,
+        /,
+    ) -> Self: ...
+
+    @_overload
+    def __new__(cls, numerator: int, denominator: int, /) -> Self: ...
+
+    def __new__(
+        cls, numerator: _Any = 0, denominator: int | None = None, /
+    ) -> Self:
+        if isinstance(numerator, int) and isinstance(denominator, int):
+            if not denominator:
+                raise ZeroDivisionError('Denominator should be non-zero.')
+            if denominator < 0:
+                numerator, denominator = -numerator, -denominator
+            return cls._from_components(
+                int(numerator), int(denominator), is_reduced=False
+            )
+        if denominator is None and isinstance(numerator, LazyFraction):
+            return numerator
+        fraction = (
+            Fraction(numerator)
+            if denominator is None
+            else Fraction(numerator, denominator)
+        )
+        return cls._from_components(
+            fraction.numerator, fraction.denominator, is_reduced=True
+        )
+
+    def __abs__(self, /) -> Self:
+        return -self if self._numerator < 0 else self
+
+    @_overload
+    def __add__(self, other: Fraction | int | Self, /) -> Self: ...
+
+    @_overload
+    def __add__(self, other: float, /) -> float: ...
+
+    @_overload
+    def __add__(self, other: _Any, /) -> _Any: ...
+
+    def __add__(self, other: _Any, /) -> _Any:
+        return self._operation(self, other, _operator.add)
+
+    def __bool__(self, /) -> bool:
+        return bool(self._numerator)
+
+    def __ceil__(self, /) -> int:
+        return -(-self._numerator // self._denominator)
+
+    def __copy__(self, /) -> Self:
+        return self
+
+    def __deepcopy__(self, memo: dict[str, _Any] | None = None, /) -> Self:
+        return self
+
+    @_overload
+    def __divmod__(
+        self, divisor: _Rational | Self, /
+    ) -> tuple[int, Fraction]: ...
+
+    @_overload
+    def __divmod__(self, divisor: float, /) -> tuple[float, float]: ...
+
+    @_overload
+    def __divmod__(self, divisor: _Any, /) -> _Any: ...
+
+    def __divmod__(self, divisor: _Any, /) -> _Any:
+        return self._fraction_operation(self, divisor, divmod)
+
+    def __eq__(self, other: _Any, /) -> _Any:
+        if isinstance(other, LazyFraction):
+            return self._reduce() == other._reduce()
+        operand = self._to_operand(other)
+        if operand is None:
+            return self.to_fraction() == other
+        return self._reduce() == operand[:2]
+
+    def __float__(self, /) -> float:
+        return self._numerator / self._denominator
+
+    def __floor__(self, /) -> int:
+        return self._numerator // self._denominator
+
+    @_overload
+    def __floordiv__(self, divisor: _Rational | Self, /) -> int: ...
+
+    @_overload
+    def __floordiv__(self, divisor: float, /) -> float: ...
+
+    @_overload
+    def __floordiv__(self, divisor: _Any, /) -> _Any: ...
+
+    def __floordiv__(self, divisor: _Any, /) -> _Any:
+        return self._fraction_operation(self, divisor, _operator.floordiv)
+
+    def __ge__(self, other: _Any, /) -> _Any:
+        return self._compare(other, _operator.ge)
+
+    def __gt__(self, other: _Any, /) -> _Any:
+        return self._compare(other, _operator.gt)
+
+    def __hash__(self, /) -> int:
+        return hash(self.to_fraction())
+
+    def __int__(self, /) -> int:
+        return self.__trunc__()
+
+    def __le__(self, other: _Any, /) -> _Any:
+        return self._compare(other, _operator.le)
+
+    def __lt__(self, other: _Any, /) -> _Any:
+        return self._compare(other, _operator.lt)
+
+    @_overload
+    def __mod__(self, divisor: _Rational | Self, /) -> Fraction: ...
+
+    @_overload
+    def __mod__(self, divisor: float, /) -> float: ...
+
+    @_overload
+    def __mod__(self, divisor: _Any, /) -> _Any: ...
+
+    def __mod__(self, divisor: _Any, /) -> _Any:
+        return self._fraction_operation(self, divisor, _operator.mod)
+
+    @_overload
+    def __mul__(self, other: Fraction | int | Self, /) -> Self: ...
+
+    @_overload
+    def __mul__(self, other: float, /) -> float: ...
+
+    @_overload
+    def __mul__(self, other: _Any, /) -> _Any: ...
+
+    def __mul__(self, other: _Any, /) -> _Any:
+        return self._operation(self, other, _operator.mul)
+
+    def __neg__(self, /) -> Self:
+        return self._from_components(
+            -self._numerator,
+            self._denominator,
+            is_reduced=self._is_reduced,
+            reduction_bits=self._reduction_bits,
+        )
+
+    def __pos__(self, /) -> Self:
+        return self
+
+    @_overload
+    def __pow__(self, exponent: int, /) -> Fraction: ...
+
+    @_overload
+    def __pow__(
+        self, exponent: _Rational | Self | float, /
+    ) -> Fraction | float: ...
+
+    @_overload
+    def __pow__(self, exponent: _Any, /) -> _Any: ...
+
+    def __pow__(self, exponent: _Any, /) -> _Any:
+        return self._fraction_operation(self, exponent, _operator.pow)
+
+    @_overload
+    def __radd__(self, other: Fraction | int, /) -> Self: ...
+
+    @_overload
+    def __radd__(self, other: float, /) -> float: ...
+
+    @_overload
+    def __radd__(self, other: _Any, /) -> _Any: ...
+
+    def __radd__(self, other: _Any, /) -> _Any:
+        return self._operation(other, self, _operator.add)
+
+    @_overload
+    def __rdivmod__(self, dividend: _Rational, /) -> tuple[int, Fraction]: ...
+
+    @_overload
+    def __rdivmod__(self, dividend: float, /) -> tuple[float, float]: ...
+
+    @_overload
+    def __rdivmod__(self, dividend: _Any, /) -> _Any: ...
+
+    def __rdivmod__(self, dividend: _Any, /) -> _Any:
+        return self._fraction_operation(dividend, self, divmod)
+
+    def __reduce__(self, /) -> tuple[type[Self], tuple[int, int]]:
+        return type(self), self._reduce()
+
+    def __repr__(self, /) -> str:
+        numerator, denominator = self._reduce()
+        return f'LazyFraction({numerator!r}, {denominator!r})'
+
+    @_overload
+    def __rfloordiv__(self, dividend: _Rational, /) -> int: ...
+
+    @_overload
+    def __rfloordiv__(self, dividend: float, /) -> float: ...
+
+    @_overload
+    def __rfloordiv__(self, dividend: _Any, /) -> _Any: ...
+
+    def __rfloordiv__(self, dividend: _Any, /) -> _Any:
+        return self._fraction_operation(dividend, self, _operator.floordiv)
+
+    @_overload
+    def __rmod__(self, dividend: _Rational, /) -> Fraction: ...
+
+    @_overload
+    def __rmod__(self, dividend: float, /) -> float: ...
+
+    @_overload
+    def __rmod__(self, dividend: _Any, /) -> _Any: ...
+
+    def __rmod__(self, dividend: _Any, /) -> _Any:
+        return self._fraction_operation(dividend, self, _operator.mod)
+
+    @_overload
+    def __rmul__(self, other: Fraction | int, /) -> Self: ...
+
+    @_overload
+    def __rmul__(self, other: float, /) -> float: ...
+
+    @_overload
+    def __rmul__(self, other: _Any, /) -> _Any: ...
+
+    def __rmul__(self, other: _Any, /) -> _Any:
+        return self._operation(other, self, _operator.mul)
+
+    @_overload
+    def __round__(self, precision: None = ..., /) -> int: ...
+
+    @_overload
+    def __round__(self, precision: int, /) -> Fraction: ...
+
+    def __round__(self, precision: int | None = None, /) -> int | Fraction:
+        if precision is None:
+            quotient, remainder = divmod(self._numerator, self._denominator)
+            doubled_remainder = 2 * remainder
+            return (
+                quotient + 1
+                if (
+                    doubled_remainder > self._denominator
+                    or (
+                        doubled_remainder == self._denominator and quotient & 1
+                    )
+                )
+                else quotient
+            )
+        return round(self.to_fraction(), precision)
+
+    @_overload
+    def __rpow__(self, base: _Rational, /) -> Fraction | float: ...
+
+    @_overload
+    def __rpow__(self, base: float, /) -> float: ...
+
+    @_overload
+    def __rpow__(self, base: _Any, /) -> _Any: ...
+
+    def __rpow__(self, base: _Any, /) -> _Any:
+        return self._fraction_operation(base, self, _operator.pow)
+
+    @_overload
+    def __rsub__(self, other: Fraction | int, /) -> Self: ...
+
+    @_overload
+    def __rsub__(self, other: float, /) -> float: ...
+
+    @_overload
+    def __rsub__(self, other: _Any, /) -> _Any: ...
+
+    def __rsub__(self, other: _Any, /) -> _Any:
+        return self._operation(other, self, _operator.sub)
+
+    @_overload
+    def __rtruediv__(self, other: Fraction | int, /) -> Self: ...
+
+    @_overload
+    def __rtruediv__(self, other: float, /) -> float: ...
+
+    @_overload
+    def __rtruediv__(self, other: _Any, /) -> _Any: ...
+
+    def __rtruediv__(self, other: _Any, /) -> _Any:
+        return self._operation(other, self, _operator.truediv)
+
+    def __str__(self, /) -> str:
+        return str(self.to_fraction())
+
+    @_overload
+    def __sub__(self, other: Fraction | int | Self, /) -> Self: ...
+
+    @_overload
+    def __sub__(self, other: float, /) -> float: ...
+
+    @_overload
+    def __sub__(self, other: _Any, /) -> _Any: ...
+
+    def __sub__(self, other: _Any, /) -> _Any:
+        return self._operation(self, other, _operator.sub)
+
+    @_overload
+    def __truediv__(self, other: Fraction | int | Self, /) -> Self: ...
+
+    @_overload
+    def __truediv__(self, other: float, /) -> float: ...
+
+    @_overload
+    def __truediv__(self, other: _Any, /) -> _Any: ...
+
+    def __truediv__(self, other: _Any, /) -> _Any:
+        return self._operation(self, other, _operator.truediv)
+
+    def __trunc__(self, /) -> int:
+        return (
+            -(-self._numerator // self._denominator)
+            if self._numerator < 0
+            else self._numerator // self._denominator
+        )
+
+    def _compare(
+        self, other: _Any, comparator: _Callable[[_Any, _Any], _Any], /
+    ) -> _Any:
+        operand = self._to_operand(other)
+        if operand is None:
+            return comparator(self.to_fraction(), other)
+        other_numerator, other_denominator, _ = operand
+        # denominators are positive
+        return comparator(
+            self._numerator * other_denominator,
+            other_numerator * self._denominator,
+        )
+
+    @staticmethod
+    def _fraction_operation(
+        first: _Any, second: _Any, operation: _Callable[[_Any, _Any], _Any], /
+    ) -> _Any:
+        return operation(
+            first.to_fraction() if isinstance(first, LazyFraction) else first,
+            second.to_fraction()
+            if isinstance(second, LazyFraction)
+            else second,
+        )
+
+    @classmethod
+    def _from_components(
+        cls,
+        numerator: int,
+        denominator: int,
+        /,
+        *,
+        is_reduced: bool,
+        reduction_bits: int | None = None,
+    ) -> Self:
+        if reduction_bits is None:
+            reduction_bits = _to_lazy_fraction_reduction_bits(
+                numerator, denominator
+            )
+        if (
+            not is_reduced
+            and max(numerator.bit_length(), denominator.bit_length())
+            > reduction_bits
+        ):
+            gcd = _math.gcd(numerator, denominator)
+            numerator, denominator = numerator // gcd, denominator // gcd
+            is_reduced = True
+            reduction_bits = _to_lazy_fraction_reduction_bits(
+                numerator, denominator
+            )
+        self = super().__new__(cls)
+        self._numerator, self._denominator = numerator, denominator
+        self._is_reduced, self._reduction_bits = is_reduced, reduction_bits
+        return self
+
+    @classmethod
+    def _operation(
+        cls,
+        first: _Any,
+        second: _Any,
+        operation: _Callable[[_Any, _Any], _Any],
+        /,
+    ) -> _Any:
+        first_operand = cls._to_operand(first)
+        second_operand = cls._to_operand(second)
+        if first_operand is None or second_operand is None:
+            return cls._fraction_operation(first, second, operation)
+        first_numerator, first_denominator, first_reduction_bits = (
+            first_operand
+        )
+        second_numerator, second_denominator, second_reduction_bits = (
+            second_operand
+        )
+        if operation is _operator.add or operation is _operator.sub:
+            numerator = operation(
+                first_numerator * second_denominator,
+                second_numerator * first_denominator,
+            )
+            denominator = first_denominator * second_denominator
+        elif operation is _operator.mul:
+            numerator = first_numerator * second_numerator
+            denominator = first_denominator * second_denominator
+        else:
+            if not second_numerator:
+                raise ZeroDivisionError(f'LazyFraction({first_numerator}, 0)')
+            numerator = first_numerator * second_denominator
+            denominator = first_denominator * second_numerator
+            if denominator < 0:
+                numerator, denominator = -numerator, -denominator
+        return cls._from_components(
+            numerator,
+            denominator,
+            is_reduced=False,
+            reduction_bits=max(first_reduction_bits, second_reduction_bits),
+        )
+
+    def _reduce(self, /) -> tuple[int, int]:
+        if not self._is_reduced:
+            gcd = _math.gcd(self._numerator, self._denominator)
+            self._numerator //= gcd
+            self._denominator //= gcd
+            self._is_reduced = True
+            self._reduction_bits = _to_lazy_fraction_reduction_bits(
+                self._numerator, self._denominator
+            )
+        return self._numerator, self._denominator
+
+    @staticmethod
+    def _to_operand(value: _Any, /) -> tuple[int, int, int] | None:
+        if isinstance(value, LazyFraction):
+            return (
+                value._numerator,  # ruff:ignore[private-member-access]
+                value._denominator,  # ruff:ignore[private-member-access]
+                value._reduction_bits,  # ruff:ignore[private-member-access]
+            )
+        if isinstance(value, Fraction):
+            numerator, denominator = value.numerator, value.denominator
+        elif isinstance(value, int):
+            numerator, denominator = int(value), 1
+        else:
+            return None
+        return (
+            numerator,
+            denominator,
+            _to_lazy_fraction_reduction_bits(numerator, denominator),
+        )
+
+
+@_final
+class _FractionsIterator:
+    def fill(self, target: list[Fraction], /) -> int:
+        if not isinstance(target, list):
+            raise TypeError(f'Target should be a list, but got {target!r}.')
+        count = 0
+        for count, value in enumerate(
+            _islice(self._values, len(target)), start=1
+        ):
+            target[count - 1] = value
+        return count
+
+    _values: _Iterator[Fraction]
+
+    __slots__ = ('_values',)
+
+    def __init__(self, values: _Iterator[Fraction], /) -> None:
+        self._values = values
+
+    def __iter__(self, /) -> Self:
+        return self
+
+    def __next__(self, /) -> Fraction:
+        return next(self._values)
+
+
+def dumps_many(values: _Iterable[Fraction | int], /) -> bytes:
+    values = list(values)
+    chunks = [_encode_varint(len(values))]
+    for value in values:
+        if isinstance(value, Fraction):
+            chunks.append(value.to_bytes())
+        elif isinstance(value, int):
+            chunks.append(_encode_term(value) + _encode_term(1))
+        else:
+            raise TypeError(
+                f'Values should be fractions or integers, but got {value!r}.'
+            )
+    return b''.join(chunks)
+
+
+def quantize_many(
+    values: _Iterable[Fraction | int],
+    step: _Rational | Fraction,
+    /,
+    rounding: str = ROUND_HALF_EVEN,
+) -> list[Fraction]:
+    _validate_rounding_mode(rounding)
+    step_numerator, step_denominator = _parse_quantization_step(step)
+    result = []
+    for value in values:
+        if not isinstance(value, Fraction | int):
+            raise TypeError(
+                f'Values should be fractions or integers, but got {value!r}.'
+            )
+        result.append(
+            _quantize_components(
+                value.numerator,
+                value.denominator,
+                step_numerator,
+                step_denominator,
+                rounding,
+            )
+        )
+    return result
+
+
+def farey(order: int, /) -> _FractionsIterator:
+    if not isinstance(order, int):
+        raise TypeError(f'Order should be an integer, but got {order!r}.')
+    if order <= 0:
+        raise ValueError('Order should be positive.')
+    if order > _MAX_FAREY_ORDER:
+        raise OverflowError('Order is too large.')
+    return _FractionsIterator(_farey(order))
+
+
+def limit_denominators(
+    values: _Iterable[Fraction | int], max_denominator: int = 10**6, /
+) -> list[Fraction]:
+    if max_denominator < 1:
+        raise ValueError('`max_denominator` should not be less than 1.')
+    result = []
+    for value in values:
+        if isinstance(value, Fraction):
+            result.append(value.limit_denominator(max_denominator))
+        elif isinstance(value, int):
+            result.append(Fraction(value))
+        else:
+            raise TypeError(
+                f'Values should be fractions or integers, but got {value!r}.'
+            )
+    return result
+
+
+def loads_many(data: _Buffer, /) -> list[Fraction]:
+    data = bytes(data)
+    size, position = _decode_varint(data, 0)
+    # each fraction takes at least two bytes
+    if size > (len(data) - position) // 2:
+        raise ValueError('Data is truncated.')
+    result = []
+    for _ in range(size):
+        numerator, denominator, position = _decode_fraction_components(
+            data, position
+        )
+        result.append(Fraction(numerator, denominator))
+    if position != len(data):
+        raise ValueError('Data has trailing bytes.')
+    return result
+
+
+def mediants(
+    lower_bound: _Rational | Fraction,
+    upper_bound: _Rational | Fraction,
+    depth: int,
+    /,
+) -> _FractionsIterator:
+    depth = _operator.index(depth)
+    if depth < 0:
+        raise ValueError('Depth should be non-negative.')
+    lower_numerator, lower_denominator = _parse_bound(lower_bound)
+    upper_numerator, upper_denominator = _parse_bound(upper_bound)
+    determinant = (
+        upper_numerator * lower_denominator
+        - lower_numerator * upper_denominator
+    )
+    if determinant <= 0:
+        raise ValueError('Lower bound should be less than the upper one.')
+    return _FractionsIterator(
+        _mediants(
+            lower_numerator,
+            lower_denominator,
+            upper_numerator,
+            upper_denominator,
+            depth,
+        )
+    )
+
+
+def _disable_stats() -> None:
+    pass
+
+
+def _enable_stats() -> None:
+    raise RuntimeError(
+        'Statistics are not collected by the pure Python implementation.'
+    )
+
+
+def _evaluate_many(
+    program: tuple[
+        int,
+        tuple[int, ...],
+        tuple[tuple[int, int, int], ...],
+        tuple[tuple[int, int, int], ...],
+        int,
+        int,
+    ],
+    columns: _Iterable[_Any],
+    /,
+) -> list[Fraction]:
+    (
+        inputs_count,
+        constants,
+        instructions,
+        divisions,
+        numerator_register,
+        denominator_register,
+    ) = program
+    snapshots = [_to_column_snapshot(column) for column in columns]
+    if 2 * len(snapshots) != inputs_count:
+        raise ValueError(
+            f'Expected {inputs_count // 2} columns, but got {len(snapshots)}.'
+        )
+    if len({len(snapshot) for snapshot in snapshots}) > 1:
+        raise ValueError('Columns should have the same length.')
+    result = []
+    for row in zip(*snapshots, strict=True):
+        registers = [
+            component
+            for value in row
+            for component in _parse_fraction_or_integer(value)
+        ]
+        registers += constants
+        for opcode, first, second in instructions:
+            registers.append(
+                _EXPRESSION_OPERATIONS[opcode](
+                    registers[first], registers[second]
+                )
+            )
+        for (
+            dividend_numerator,
+            dividend_denominator,
+            divisor_numerator,
+        ) in divisions:
+            if not registers[divisor_numerator]:
+                # fails with the error of the division operator
+                Fraction(
+                    registers[dividend_numerator],
+                    registers[dividend_denominator],
+                ) / 0
+        result.append(
+            Fraction(
+                registers[numerator_register], registers[denominator_register]
+            )
+        )
+    return result
+
+
+def _reset_stats() -> None:
+    pass
+
+
+def _stats() -> dict[str, _Any]:
+    return {
+        'enabled': False,
+        'operations': {},
+        'rational_checks': 0,
+        'rational_matches': 0,
+        'gcd_calls': 0,
+        'gcd_bits': {},
+        'word_gcd_calls': 0,
+        'fractions_allocated': 0,
+        'powers_of_ten_cache_hits': 0,
+        'powers_of_ten_cache_misses': 0,
+    }
+
+
+def parallel_dot(
+    xs: _Iterable[_Rational | Fraction],
+    ys: _Iterable[_Rational | Fraction],
+    /,
+    *,
+    workers: int | None = None,
+) -> Fraction:
+    _validate_workers_count(workers)
+    xs_components = [_parse_term(x) for x in xs]
+    ys_components = [_parse_term(y) for y in ys]
+    if len(xs_components) != len(ys_components):
+        raise ValueError('Sequences should have the same length.')
+    return Fraction(
+        *_components_sum(
+            [
+                (x_numerator * y_numerator, x_denominator * y_denominator)
+                for (x_numerator, x_denominator), (
+                    y_numerator,
+                    y_denominator,
+                ) in zip(xs_components, ys_components, strict=True)
+            ]
+        )
+    )
+
+
+def parallel_sum(
+    values: _Iterable[_Rational | Fraction], /, *, workers: int | None = None
+) -> Fraction:
+    _validate_workers_count(workers)
+    return Fraction(*_components_sum([_parse_term(value) for value in values]))
+
+
+def powers(base: _Rational | Fraction, count: int, /) -> list[Fraction]:
+    count = _operator.index(count)
+    if count < 0:
+        raise ValueError('Count should be non-negative.')
+    if not isinstance(base, Fraction | _numbers.Rational):
+        raise TypeError(f'Base should be a rational number, but got {base!r}.')
+    numerator, denominator = int(base.numerator), int(base.denominator)
+    result = []
+    power_numerator = power_denominator = 1
+    for _ in range(count):
+        result.append(Fraction(power_numerator, power_denominator))
+        power_numerator *= numerator
+        power_denominator *= denominator
+    return result
+
+
+def set_growth_hook(
+    threshold_bits: int, hook: _Callable[[int, int], _Any] | None, /
+) -> None:
+    global _growth_hook, _growth_threshold_bits
+    threshold_bits = _operator.index(threshold_bits)
+    if threshold_bits < 0:
+        raise ValueError('Threshold should be non-negative.')
+    if not (hook is None or callable(hook)):
+        raise TypeError(
+            f'Hook should be a callable or None, but got {hook!r}.'
+        )
+    _growth_hook, _growth_threshold_bits = hook, threshold_bits
+
+
+def simplest_between(
+    lower_bound: _Rational | Fraction,
+    upper_bound: _Rational | Fraction,
+    /,
+    *,
+    inclusive: bool = True,
+) -> Fraction:
+    lower_numerator, lower_denominator = _parse_bound(lower_bound)
+    upper_numerator, upper_denominator = _parse_bound(upper_bound)
+    if not (
+        lower_numerator * upper_denominator
+        <= upper_numerator * lower_denominator
+        if inclusive
+        else lower_numerator * upper_denominator
+        < upper_numerator * lower_denominator
+    ):
+        raise ValueError('Interval should not be empty.')
+    if (
+        lower_numerator <= 0 <= upper_numerator
+        if inclusive
+        else lower_numerator < 0 < upper_numerator
+    ):
+        return Fraction(0)
+    if upper_numerator <= 0:
+        numerator, denominator = _simplest_between_components(
+            -upper_numerator,
+            upper_denominator,
+            -lower_numerator,
+            lower_denominator,
+            inclusive=inclusive,
+        )
+        return Fraction(-numerator, denominator)
+    return Fraction(
+        *_simplest_between_components(
+            lower_numerator,
+            lower_denominator,
+            upper_numerator,
+            upper_denominator,
+            inclusive=inclusive,
+        )
+    )
+
+
+# Binary form of a fraction is its numerator followed by its denominator,
+# each of them is encoded as a LEB128 header
+# which has sign in the second lowest bit and
+# - if the lowest bit is unset: magnitude in the rest of bits,
+# - otherwise: size of the magnitude bytes (in little-endian order)
+#   which follow the header.
+_MAX_INLINE_TERM_MAGNITUDE = (1 << 62) - 1
+
+
+def _decode_fraction_components(
+    data: bytes, position: int, /
+) -> tuple[int, int, int]:
+    numerator, position = _decode_term(data, position)
+    denominator, position = _decode_term(data, position)
+    if denominator <= 0:
+        raise ValueError('Denominator should be positive.')
+    return numerator, denominator, position
+
+
+def _decode_term(data: bytes, position: int, /) -> tuple[int, int]:
+    header, position = _decode_varint(data, position)
+    if header & 1:
+        size = header >> 2
+        if size > len(data) - position:
+            raise ValueError('Data is truncated.')
+        magnitude = int.from_bytes(data[position : position + size], 'little')
+        position += size
+    else:
+        magnitude = header >> 2
+    return (-magnitude if header & 2 else magnitude), position
+
+
+def _decode_varint(data: bytes, position: int, /) -> tuple[int, int]:
+    value = 0
+    for shift in range(0, 64, 7):
+        if position == len(data):
+            raise ValueError('Data is truncated.')
+        byte = data[position]
+        position += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value & ((1 << 64) - 1), position
+    raise ValueError('Variable-length integer is too long.')
+
+
+def _encode_term(value: int, /) -> bytes:
+    magnitude, sign_flag = abs(value), (value < 0) << 1
+    if magnitude <= _MAX_INLINE_TERM_MAGNITUDE:
+        return _encode_varint(magnitude << 2 | sign_flag)
+    size = (magnitude.bit_length() + 7) // 8
+    return _encode_varint(size << 2 | sign_flag | 1) + magnitude.to_bytes(
+        size, 'little'
+    )
+
+
+def _encode_varint(value: int, /) -> bytes:
+    result = bytearray()
+    while value >= 0x80:
+        result.append(value & 0x7F | 0x80)
+        value >>= 7
+    result.append(value)
+    return bytes(result)
+
+
+_CONTINUED_FRACTION_LEAF_SIZE = 16
+
+
+def _continued_fraction_terms_product(
+    terms: list[int], start: int, stop: int, /
+) -> tuple[int, int, int, int]:
+    if stop - start <= _CONTINUED_FRACTION_LEAF_SIZE:
+        (
+            first_row_first,
+            first_row_second,
+            second_row_first,
+            second_row_second,
+        ) = (1, 0, 0, 1)
+        for index in range(start, stop):
+            term = terms[index]
+            first_row_first, first_row_second = (
+                first_row_first * term + first_row_second,
+                first_row_first,
+            )
+            second_row_first, second_row_second = (
+                second_row_first * term + second_row_second,
+                second_row_first,
+            )
+        return (
+            first_row_first,
+            first_row_second,
+            second_row_first,
+            second_row_second,
+        )
+    middle = (start + stop) // 2
+    left = _continued_fraction_terms_product(terms, start, middle)
+    right = _continued_fraction_terms_product(terms, middle, stop)
+    return (
+        left[0] * right[0] + left[1] * right[2],
+        left[0] * right[1] + left[1] * right[3],
+        left[2] * right[0] + left[3] * right[2],
+        left[2] * right[1] + left[3] * right[3],
+    )
+
+
+_MAX_FAREY_ORDER = ((1 << 63) - 1) // 4
+
+
+def _exact_power(
+    numerator: int, denominator: int, exponent: _Any, /
+) -> Fraction | None:
+    if numerator < 0 or not isinstance(exponent, Fraction | _numbers.Rational):
+        return None
+    exponent_numerator, exponent_denominator = (
+        int(exponent.numerator),
+        int(exponent.denominator),
+    )
+    if exponent_denominator < 0:
+        exponent_numerator, exponent_denominator = (
+            -exponent_numerator,
+            -exponent_denominator,
+        )
+    if exponent_denominator == 1:
+        return None
+    root_numerator = _exact_root(numerator, exponent_denominator)
+    if root_numerator is None:
+        return None
+    root_denominator = _exact_root(denominator, exponent_denominator)
+    if root_denominator is None:
+        return None
+    return Fraction(root_numerator, root_denominator) ** exponent_numerator
+
+
+def _exact_root(value: int, degree: int, /) -> int | None:
+    result = _integer_root(value, degree)
+    return result if result**degree == value else None
+
+
+def _integer_root(value: int, degree: int, /) -> int:
+    if degree == 2:
+        return _math.isqrt(value)
+    if value < 2:
+        return value
+    if degree >= value.bit_length():
+        return 1
+    # starting point above the root is estimated by floating point logarithm,
+    # error of which grows with its magnitude, so the margin does too
+    mantissa_bits_count = sys.float_info.mant_dig
+    root_log2 = _math.log2(value) / degree
+    exponent = _math.floor(root_log2)
+    mantissa = 2.0 ** (root_log2 - exponent)
+    margin = _math.ldexp(root_log2 + 2.0, 4 - mantissa_bits_count)
+    if exponent < mantissa_bits_count - 1:
+        lower_bound = _math.floor(
+            _math.ldexp(mantissa * (1.0 - margin), exponent)
+        )
+        if lower_bound == _math.floor(
+            _math.ldexp(mantissa * (1.0 + margin), exponent)
+        ):
+            return lower_bound
+    mantissa_exponent = min(exponent, mantissa_bits_count - 1)
+    result = (
+        _math.ceil(_math.ldexp(mantissa * (1.0 + margin), mantissa_exponent))
+        + 1
+    ) << (exponent - mantissa_exponent)
+    if result**degree <= value:
+        result = 1 << -(-value.bit_length() // degree)
+    while True:
+        candidate = (
+            (degree - 1) * result + value // result ** (degree - 1)
+        ) // degree
+        if candidate >= result:
+            return result
+        result = candidate
+
+
+def _farey(order: int, /) -> _Iterator[Fraction]:
+    numerator, denominator, next_numerator, next_denominator = 0, 1, 1, order
+    while numerator <= denominator:
+        yield Fraction(numerator, denominator)
+        factor = (order + denominator) // next_denominator
+        numerator, denominator, next_numerator, next_denominator = (
+            next_numerator,
+            next_denominator,
+            factor * next_numerator - numerator,
+            factor * next_denominator - denominator,
+        )
+
+
+def _mediants(
+    lower_numerator: int,
+    lower_denominator: int,
+    upper_numerator: int,
+    upper_denominator: int,
+    depth: int,
+    /,
+) -> _Iterator[Fraction]:
+    # walks the Stern-Brocot subtree between the bounds in order
+    # keeping right subtrees of the pending nodes on the stack
+    stack: list[tuple[int, int, int, int, int]] = []
+    level = 1
+    while True:
+        while level <= depth:
+            mediant_numerator, mediant_denominator = (
+                lower_numerator + upper_numerator,
+                lower_denominator + upper_denominator,
+            )
+            stack.append(
+                (
+                    mediant_numerator,
+                    mediant_denominator,
+                    upper_numerator,
+                    upper_denominator,
+                    level + 1,
+                )
+            )
+            upper_numerator, upper_denominator = (
+                mediant_numerator,
+                mediant_denominator,
+            )
+            level += 1
+        if not stack:
+            return
+        (
+            lower_numerator,
+            lower_denominator,
+            upper_numerator,
+            upper_denominator,
+            level,
+        ) = stack.pop()
+        yield Fraction(lower_numerator, lower_denominator)
+
+
+def _components_add(
+    first: tuple[int, int], second: tuple[int, int], /
+) -> tuple[int, int]:
+    (
+        (first_numerator, first_denominator),
+        (second_numerator, second_denominator),
+    ) = first, second
+    gcd = _math.gcd(first_denominator, second_denominator)
+    first_scale, second_scale = (
+        second_denominator // gcd,
+        first_denominator // gcd,
+    )
+    return (
+        first_numerator * first_scale + second_numerator * second_scale,
+        first_denominator * first_scale,
+    )
+
+
+def _components_sum(components: list[tuple[int, int]], /) -> tuple[int, int]:
+    # adds up pairwise in a balanced tree over least common multiples
+    # of denominators, so operands of additions stay balanced in size
+    if not components:
+        return 0, 1
+    while len(components) > 1:
+        sums = list(map(_components_add, components[::2], components[1::2]))
+        if len(components) % 2:
+            sums.append(components[-1])
+        components = sums
+    return components[0]
+
+
+def _parse_term(value: _Any, /) -> tuple[int, int]:
+    if not isinstance(value, Fraction | _numbers.Rational):
+        raise TypeError(
+            f'Values should be rational numbers, but got {value!r}.'
+        )
+    return int(value.numerator), int(value.denominator)
+
+
+def _validate_workers_count(workers: int | None, /) -> None:
+    if workers is not None and _operator.index(workers) < 1:
+        raise ValueError('Workers count should be positive.')
+
+
+_growth_hook: _Callable[[int, int], _Any] | None = None
+_growth_threshold_bits = 0
+
+
+def _check_growth(value: _Fraction, /) -> None:
+    numerator_bits, denominator_bits = (
+        value.numerator.bit_length(),
+        value.denominator.bit_length(),
+    )
+    hook = _growth_hook
+    if hook is not None and (
+        max(numerator_bits, denominator_bits) > _growth_threshold_bits
+    ):
+        hook(numerator_bits, denominator_bits)
+
+
+_LAZY_FRACTION_MIN_REDUCTION_BITS = 4096
+
+
+def _to_lazy_fraction_reduction_bits(
+    numerator: int, denominator: int, /
+) -> int:
+    return max(
+        _LAZY_FRACTION_MIN_REDUCTION_BITS,
+        2 * max(numerator.bit_length(), denominator.bit_length()),
+    )
+
+
+_precision: _ContextVar[tuple[int | None, int | None]] = _ContextVar(
+    'cfractions.precision'
+)
+# set by the first entered precision context and never cleared,
+# since contexts copied within it (e.g. by tasks) may outlive it
+_is_precision_used = False
+
+
+def _enter_precision_context() -> None:
+    global _is_precision_used
+    _is_precision_used = True
+
+
+def _limit_precision(
+    value: Fraction, precision: tuple[int | None, int | None], /
+) -> Fraction:
+    max_denominator, max_bits = precision
+    if max_bits is not None:
+        shift = value.denominator.bit_length() - max_bits
+        if shift > 0:
+            value = Fraction(
+                ((value.numerator >> (shift - 1)) + 1) >> 1,
+                value.denominator >> shift,
+            )
+    if max_denominator is not None:
+        value = value.limit_denominator(max_denominator)
+    return value
+
+
+def _to_normalized_std_fraction(
+    numerator: int, denominator: int, /
+) -> _Fraction:
+    # skips normalization of already normalized components
+    result = _Fraction.__new__(_Fraction)
+    result._numerator = numerator  # type: ignore[attr-defined]  # ruff:ignore[private-member-access]
+    result._denominator = denominator  # type: ignore[attr-defined]  # ruff:ignore[private-member-access]
+    return result
+
+
+_EXPRESSION_OPERATIONS: tuple[_Callable[[int, int], int], ...] = (
+    _operator.add,
+    _operator.sub,
+    _operator.mul,
+)
+
+
+def _parse_fraction_or_integer(value: _Any, /) -> tuple[int, int]:
+    if isinstance(value, Fraction):
+        return value.numerator, value.denominator
+    if isinstance(value, int):
+        return int(value), 1
+    raise TypeError(
+        f'Values should be fractions or integers, but got {value!r}.'
+    )
+
+
+def _to_column_snapshot(column: _Any, /) -> list[_Any]:
+    # buffers are unpacked to integers, other columns are iterated over
+    if not isinstance(column, bytes | list | tuple):
+        try:
+            view = memoryview(column)
+        except TypeError:
+            pass
+        else:
+            with view:
+                return view.tolist()
+    return list(column)
+
+
+_FLOAT_MANTISSA_SIZE = sys.float_info.mant_dig
+_MIN_FLOAT_EXPONENT = sys.float_info.min_exp - _FLOAT_MANTISSA_SIZE
+
+
+def _binary_fraction_components(
+    numerator: int, exponent: int, /
+) -> tuple[int, int]:
+    return (
+        (numerator << exponent, 1)
+        if exponent >= 0
+        else (numerator, 1 << -exponent)
+    )
+
+
+def _parse_bound(bound: _Any, /) -> tuple[int, int]:
+    if not isinstance(bound, Fraction | _numbers.Rational):
+        raise TypeError(
+            f'Bounds should be rational numbers, but got {bound!r}.'
+        )
+    numerator, denominator = int(bound.numerator), int(bound.denominator)
+    return (
+        (numerator, denominator)
+        if denominator > 0
+        else (-numerator, -denominator)
+    )
+
+
+def _simplest_between_components(
+    lower_numerator: int,
+    lower_denominator: int,
+    upper_numerator: int,
+    upper_denominator: int,
+    /,
+    *,
+    inclusive: bool,
+) -> tuple[int, int]:
+    # walks continued fraction expansions of non-negative bounds
+    # simultaneously: while they share the integral part
+    # it becomes the next partial quotient
+    # and the search continues between reciprocals of the fractional parts
+    previous_numerator, previous_denominator, numerator, denominator = (
+        0,
+        1,
+        1,
+        0,
+    )
+    while True:
+        lower_quotient, lower_remainder = divmod(
+            lower_numerator, lower_denominator
+        )
+        upper_quotient, upper_remainder = divmod(
+            upper_numerator, upper_denominator
+        )
+        if inclusive and not lower_remainder:
+            term = lower_quotient
+            break
+        gap = upper_quotient - lower_quotient
+        if (
+            gap > 0
+            if inclusive
+            else gap > 1 or (gap == 1 and upper_remainder != 0)
+        ):
+            term = lower_quotient + 1
+            break
+        # integral parts coincide unless the open upper bound
+        # is the successor of the lower one
+        rest = upper_remainder or upper_denominator
+        previous_numerator, previous_denominator, numerator, denominator = (
+            numerator,
+            denominator,
+            lower_quotient * numerator + previous_numerator,
+            lower_quotient * denominator + previous_denominator,
+        )
+        if not lower_remainder:
+            # the rest of the open interval is unbounded above
+            term = upper_denominator // rest + 1
+            break
+        (
+            lower_numerator,
+            lower_denominator,
+            upper_numerator,
+            upper_denominator,
+        ) = (upper_denominator, rest, lower_denominator, lower_remainder)
+    return (
+        term * numerator + previous_numerator,
+        term * denominator + previous_denominator,
+    )
+
+
+_ROUNDING_MODES = frozenset(
+    (
+        ROUND_CEILING,
+        ROUND_DOWN,
+        ROUND_FLOOR,
+        ROUND_HALF_DOWN,
+        ROUND_HALF_EVEN,
+        ROUND_HALF_UP,
+        ROUND_UP,
+    )
+)
+
+
+def _divide_rounding(dividend: int, divisor: int, rounding: str, /) -> int:
+    quotient, remainder = divmod(dividend, divisor)
+    if remainder and _rounding_increments_quotient(
+        rounding, quotient, 2 * remainder - divisor
+    ):
+        quotient += 1
+    return quotient
+
+
+def _parse_quantization_step(step: _Any, /) -> tuple[int, int]:
+    if not isinstance(step, Fraction | _numbers.Rational):
+        raise TypeError(f'Step should be a rational number, but got {step!r}.')
+    numerator, denominator = int(step.numerator), int(step.denominator)
+    if (numerator > 0) is not (denominator > 0):
+        raise ValueError('Step should be positive.')
+    return abs(numerator), abs(denominator)
+
+
+def _quantize_components(
+    numerator: int,
+    denominator: int,
+    step_numerator: int,
+    step_denominator: int,
+    rounding: str,
+    /,
+) -> Fraction:
+    multiplier = _divide_rounding(
+        numerator * step_denominator, denominator * step_numerator, rounding
+    )
+    return Fraction(multiplier * step_numerator, step_denominator)
+
+
+def _rounding_increments_quotient(
+    rounding: str, quotient: int, remainder_excess: int, /
+) -> bool:
+    if rounding == ROUND_CEILING:
+        return True
+    if rounding == ROUND_DOWN:
+        return quotient < 0
+    if rounding == ROUND_FLOOR:
+        return False
+    if rounding == ROUND_UP:
+        return quotient >= 0
+    if remainder_excess:
+        return remainder_excess > 0
+    if rounding == ROUND_HALF_DOWN:
+        return quotient < 0
+    if rounding == ROUND_HALF_UP:
+        return quotient >= 0
+    return quotient % 2 == 1
+
+
+def _validate_rounding_mode(rounding: _Any, /) -> None:
+    if not (isinstance(rounding, str) and rounding in _ROUNDING_MODES):
+        raise ValueError(f'Invalid rounding mode: {rounding!r}.')
+
+
+_DIGITS_CHARACTERS = '0123456789abcdefghijklmnopqrstuvwxyz'
+
+
+def _multiplicative_order(
+    base: int, modulus: int, limit: int | None, /
+) -> int | None:
+    power, order = base % modulus, 1
+    while power != 1:
+        if limit is not None and order >= limit:
+            return None
+        power, order = power * base % modulus, order + 1
+    return None if limit is not None and order > limit else order
+
+
+def _to_digits_string(value: int, base: int, min_size: int, /) -> str:
+    chunk_size = 1
+    while base ** (chunk_size + 1) <= (1 << 63) - 1:
+        chunk_size += 1
+    chunk_base = base**chunk_size
+    chunks: list[int] = []
+    while value >= chunk_base:
+        value, chunk = divmod(value, chunk_base)
+        chunks.append(chunk)
+    characters: list[str] = []
+    for chunk in chunks:
+        for _ in range(chunk_size):
+            chunk, digit = divmod(chunk, base)
+            characters.append(_DIGITS_CHARACTERS[digit])
+    while value:
+        value, digit = divmod(value, base)
+        characters.append(_DIGITS_CHARACTERS[digit])
+    characters.extend('0' * (max(min_size, 1) - len(characters)))
+    return ''.join(reversed(characters))
+
+
+def _to_truncated_digits_string(
+    sign: str,
+    integral_part_string: str,
+    remainder: int,
+    denominator: int,
+    base: int,
+    digits_count: int,
+    /,
+) -> str:
+    digits_string = (
+        _to_digits_string(
+            remainder * base**digits_count // denominator, base, digits_count
+        )
+        if digits_count
+        else ''
+    )
+    return f'{sign}{integral_part_string}.{digits_string}...'
+
+
 class _HasAsIntegerRatio(Protocol):
     def as_integer_ratio(self, /) -> tuple[int, int]: ...
 
@@ -0,0 +1,46 @@
+from __future__ import annotations
+
+from collections.abc import Generator
+from contextlib import contextmanager
+from typing import TYPE_CHECKING
+
+if TYPE_CHECKING:
+    from contextvars import ContextVar
+
+    _precision: ContextVar[tuple[int | None, int | None]]
+
+    def _enter_precision_context() -> None: ...
+
+else:
+    try:
+        from ._cfractions import _enter_precision_context, _precision
+    except ImportError:
+        from ._fractions import _enter_precision_context, _precision
+
+
+@contextmanager
+def precision_context(
+    *, max_denominator: int | None = None, max_bits: int | None = None
+) -> Generator[None, None, None]:
+    if max_denominator is not None:
+        if not isinstance(max_denominator, int):
+            raise TypeError(
+                '`max_denominator` should be an integer or None, '
+                f'but got {max_denominator!r}.'
+            )
+        if max_denominator < 1:
+            raise ValueError('`max_denominator` should not be less than 1.')
+    if max_bits is not None:
+        if not isinstance(max_bits, int):
+            raise TypeError(
+                '`max_bits` should be an integer or None, '
+                f'but got {max_bits!r}.'
+            )
+        if max_bits < 1:
+            raise ValueError('`max_bits` should be positive.')
+    _enter_precision_context()
+    token = _precision.set((max_denominator, max_bits))
+    try:
+        yield
+    finally:
+        _precision.reset(token)
@@ -0,0 +1,9 @@
+from typing import Final
+
+ROUND_CEILING: Final = 'ROUND_CEILING'
+ROUND_DOWN: Final = 'ROUND_DOWN'
+ROUND_FLOOR: Final = 'ROUND_FLOOR'
+ROUND_HALF_DOWN: Final = 'ROUND_HALF_DOWN'
+ROUND_HALF_EVEN: Final = 'ROUND_HALF_EVEN'
+ROUND_HALF_UP: Final = 'ROUND_HALF_UP'
+ROUND_UP: Final = 'ROUND_UP'
@@ -0,0 +1,267 @@
+"""Memory-mappable columnar storage of fractions.
+
+File layout (all integers are little-endian, sections are 8-byte aligned):
+
+- header of 32 bytes: signature ``b'CFRACTNS'``, format version (``uint32``),
+  reserved ``uint32`` (zero), number of fractions ``N`` (``uint64``)
+  and number of overflowing terms ``K`` (``uint64``);
+- numerators column: ``N`` of ``int64``;
+- denominators column: ``N`` of ``int64``;
+- overflow keys: ``K`` of ``uint64`` sorted in ascending order,
+  each of them is ``index << 1 | is_denominator``
+  for a term which does not fit in ``int64`` slot
+  (the slot holds ``-2 ** 63`` as a marker instead);
+- overflow offsets: ``K + 1`` of ``uint64``, bounds of the overflowing terms
+  relative to the start of the overflow area;
+- overflow area: terms as signed little-endian two's complement bytes.
+
+Bytes after the overflow area are ignored,
+so tables can be stored in page-rounded buffers
+like ``multiprocessing.shared_memory.SharedMemory.buf``.
+"""
+
+from __future__ import annotations
+
+import io as _io
+import mmap as _mmap
+import struct as _struct
+import sys as _sys
+from array import array as _array
+from bisect import bisect_left as _bisect_left
+from collections.abc import Iterable, Iterator, Sequence
+from typing import BinaryIO, Literal, TYPE_CHECKING, overload
+
+from . import Fraction
+
+if TYPE_CHECKING:
+    from os import PathLike
+
+    from typing_extensions import Buffer, Self
+
+__all__ = ['FractionsTable', 'dump', 'dumps']
+
+_HEADER = _struct.Struct('<8sIIQQ')
+_OVERFLOW_MARKER = -(1 << 63)
+_OVERFLOW_OFFSET = _struct.Struct('<Q')
+_MAX_SMALL_TERM = (1 << 63) - 1
+_MIN_SMALL_TERM = _OVERFLOW_MARKER + 1
+_SIGNATURE = b'CFRACTNS'
+_TERM_SIZE = 8
+_VERSION = 1
+
+
+def dump(values: Iterable[Fraction | int], file: BinaryIO, /) -> None:
+    numerators, denominators = _array('q'), _array('q')
+    overflow_keys, overflow_offsets = _array('Q'), _array('Q', [0])
+    overflow = bytearray()
+    for index, value in enumerate(values):
+        if isinstance(value, Fraction):
+            numerator, denominator = value.numerator, value.denominator
+        elif isinstance(value, int):
+            numerator, denominator = int(value), 1
+        else:
+            raise TypeError(
+                f'Values should be fractions or integers, but got {value!r}.'
+            )
+        for column, term, slots in (
+            (0, numerator, numerators),
+            (1, denominator, denominators),
+        ):
+            if _MIN_SMALL_TERM <= term <= _MAX_SMALL_TERM:
+                slots.append(term)
+            else:
+                slots.append(_OVERFLOW_MARKER)
+                overflow_keys.append(index << 1 | column)
+                overflow += term.to_bytes(
+                    (term.bit_length() + 8) // 8, 'little', signed=True
+                )
+                overflow_offsets.append(len(overflow))
+    if _sys.byteorder != 'little':
+        for section in (
+            numerators,
+            denominators,
+            overflow_keys,
+            overflow_offsets,
+        ):
+            section.byteswap()
+    file.write(
+        _HEADER.pack(
+            _SIGNATURE, _VERSION, 0, len(numerators), len(overflow_keys)
+        )
+    )
+    file.write(numerators)
+    file.write(denominators)
+    file.write(overflow_keys)
+    file.write(overflow_offsets)
+    file.write(overflow)
+
+
+def dumps(values: Iterable[Fraction | int], /) -> bytes:
+    stream = _io.BytesIO()
+    dump(values, stream)
+    return stream.getvalue()
+
+
+class FractionsTable(Sequence[Fraction]):
+    @classmethod
+    def open(cls, path: str | PathLike[str], /) -> Self:
+        with open(path, 'rb') as file:
+            mapping = _mmap.mmap(file.fileno(), 0, access=_mmap.ACCESS_READ)
+        try:
+            result = cls(mapping)
+        except Exception:
+            mapping.close()
+            raise
+        result._mapping = mapping
+        return result
+
+    def close(self, /) -> None:
+        for view in (
+            self._numerators,
+            self._denominators,
+            self._overflow_keys,
+            self._overflow_offsets,
+            self._overflow,
+        ):
+            if isinstance(view, memoryview):
+                view.release()
+        self._view.release()
+        if self._mapping is not None:
+            self._mapping.close()
+            self._mapping = None
+
+    _denominators: Sequence[int]
+    _mapping: _mmap.mmap | None
+    _numerators: Sequence[int]
+    _overflow: memoryview
+    _overflow_keys: Sequence[int]
+    _overflow_offsets: Sequence[int]
+    _size: int
+    _view: memoryview
+
+    __slots__ = (
+        '_denominators',
+        '_mapping',
+        '_numerators',
+        '_overflow',
+        '_overflow_keys',
+        '_overflow_offsets',
+        '_size',
+        '_view',
+    )
+
+    def __init__(self, data: Buffer, /) -> None:
+        view = memoryview(data).cast('B')
+        if len(view) < _HEADER.size:
+            view.release()
+            raise ValueError('Data is truncated.')
+        signature, version, _, size, overflow_size = _HEADER.unpack_from(view)
+        if signature != _SIGNATURE:
+            view.release()
+            raise ValueError('Data is not a fractions table.')
+        if version != _VERSION:
+            view.release()
+            raise ValueError(f'Unsupported format version: {version}.')
+        numerators_start = _HEADER.size
+        denominators_start = numerators_start + size * _TERM_SIZE
+        overflow_keys_start = denominators_start + size * _TERM_SIZE
+        overflow_offsets_start = (
+            overflow_keys_start + overflow_size * _TERM_SIZE
+        )
+        overflow_start = (
+            overflow_offsets_start + (overflow_size + 1) * _TERM_SIZE
+        )
+        if len(view) < overflow_start:
+            view.release()
+            raise ValueError('Data is truncated.')
+        (overflow_area_size,) = _OVERFLOW_OFFSET.unpack_from(
+            view, overflow_start - _OVERFLOW_OFFSET.size
+        )
+        overflow_end = overflow_start + overflow_area_size
+        if len(view) < overflow_end:
+            view.release()
+            raise ValueError('Data is truncated.')
+        self._mapping = None
+        self._numerators = _to_terms(
+            view[numerators_start:denominators_start], 'q'
+        )
+        self._denominators = _to_terms(
+            view[denominators_start:overflow_keys_start], 'q'
+        )
+        self._overflow_keys = _to_terms(
+            view[overflow_keys_start:overflow_offsets_start], 'Q'
+        )
+        self._overflow_offsets = _to_terms(
+            view[overflow_offsets_start:overflow_start], 'Q'
+        )
+        self._overflow = view[overflow_start:overflow_end]
+        self._size = size
+        self._view = view
+
+    def __enter__(self, /) -> Self:
+        return self
+
+    def __exit__(self, *_: object) -> None:
+        self.close()
+
+    @overload
+    def __getitem__(self, item: int, /) -> Fraction: ...
+
+    @overload
+    def __getitem__(self, item: slice, /) -> list[Fraction]: ...
+
+    def __getitem__(self, item: int | slice, /) -> Fraction | list[Fraction]:
+        if isinstance(item, slice):
+            return [
+                self._get(index) for index in range(*item.indices(self._size))
+            ]
+        index = item.__index__()
+        if index < 0:
+            index += self._size
+        if not 0 <= index < self._size:
+            raise IndexError('Fractions table index out of range.')
+        return self._get(index)
+
+    def __iter__(self, /) -> Iterator[Fraction]:
+        for index in range(self._size):
+            yield self._get(index)
+
+    def __len__(self, /) -> int:
+        return self._size
+
+    def _get(self, index: int, /) -> Fraction:
+        numerator = self._numerators[index]
+        if numerator == _OVERFLOW_MARKER:
+            numerator = self._get_overflow_term(index << 1)
+        denominator = self._denominators[index]
+        if denominator == _OVERFLOW_MARKER:
+            denominator = self._get_overflow_term(index << 1 | 1)
+        return Fraction._restore(  # ruff:ignore[private-member-access]
+            numerator, denominator
+        )
+
+    def _get_overflow_term(self, key: int, /) -> int:
+        position = _bisect_left(self._overflow_keys, key)
+        if (
+            position == len(self._overflow_keys)
+            or self._overflow_keys[position] != key
+        ):
+            raise ValueError('Overflow term is missing.')
+        start, end = (
+            self._overflow_offsets[position],
+            self._overflow_offsets[position + 1],
+        )
+        if not start <= end <= len(self._overflow):
+            raise ValueError('Overflow term is out of bounds.')
+        return int.from_bytes(self._overflow[start:end], 'little', signed=True)
+
+
+def _to_terms(
+    view: memoryview, format_: Literal['q', 'Q'], /
+) -> Sequence[int]:
+    if _sys.byteorder == 'little':
+        return view.cast(format_)
+    result = _array(format_)
+    result.frombytes(view)
+    result.byteswap()
+    return result
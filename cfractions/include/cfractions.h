@@ -0,0 +1,89 @@
+/* C API of `cfractions` for other extensions.
+
+   Directory of this header is returned by `cfractions.get_include()`.
+   The API is imported once during module initialization with
+
+     if (CFractions_ImportAPI() < 0) return -1;
+
+   after which fractions can be checked, created & operated on
+   without going through the Python-level number protocol.
+
+   Every interpreter has its own fraction type and so its own API,
+   extensions supporting subinterpreters should import the capsule
+   into their module state & use the `CFractionsAPI` entries directly. */
+#ifndef CFRACTIONS_H
+#define CFRACTIONS_H
+
+#include <Python.h>
+
+/* incremented when entries are appended to `CFractionsAPI` */
+#define CFRACTIONS_API_VERSION 1
+#define CFRACTIONS_API_CAPSULE_NAME "cfractions._C_API"
+
+typedef struct {
+  unsigned int version;
+  /* type of fractions created by this API */
+  PyTypeObject* fraction_type;
+  /* whether an object is a fraction, never fails */
+  int (*check)(PyObject* object);
+  /* new fraction from integer terms with signs & common divisor normalized,
+     raises `ZeroDivisionError` for zero denominator */
+  PyObject* (*from_terms)(PyTypeObject* cls, PyObject* numerator,
+                          PyObject* denominator);
+  /* new fraction from coprime integer terms with positive denominator,
+     they are not checked */
+  PyObject* (*from_terms_trusted)(PyTypeObject* cls, PyObject* numerator,
+                                  PyObject* denominator);
+  /* borrowed references to terms of a fraction */
+  PyObject* (*numerator)(PyObject* fraction);
+  PyObject* (*denominator)(PyObject* fraction);
+  /* same as the corresponding `PyNumber_*` functions,
+     but skip their dispatch when a fraction operand supports the other one */
+  binaryfunc add;
+  binaryfunc subtract;
+  binaryfunc multiply;
+  binaryfunc true_divide;
+  /* same as `PyObject_RichCompareBool` */
+  int (*rich_compare_bool)(PyObject* first, PyObject* second, int op);
+  Py_hash_t (*hash)(PyObject* fraction);
+} CFractionsAPI;
+
+#ifndef CFRACTIONS_MODULE
+static CFractionsAPI* cfractions_api = NULL;
+
+static inline int CFractions_ImportAPI(void) {
+  CFractionsAPI* api =
+      (CFractionsAPI*)PyCapsule_Import(CFRACTIONS_API_CAPSULE_NAME, 0);
+  if (api == NULL) return -1;
+  if (api->version < CFRACTIONS_API_VERSION) {
+    PyErr_Format(PyExc_ImportError,
+                 "cfractions C API version %u is older than required %u.",
+                 api->version, (unsigned int)CFRACTIONS_API_VERSION);
+    return -1;
+  }
+  cfractions_api = api;
+  return 0;
+}
+
+#define CFractions_Check(object) (cfractions_api->check(object))
+#define CFractions_FromTerms(numerator, denominator)                    \
+  (cfractions_api->from_terms(cfractions_api->fraction_type, numerator, \
+                              denominator))
+#define CFractions_FromTermsTrusted(numerator, denominator)          \
+  (cfractions_api->from_terms_trusted(cfractions_api->fraction_type, \
+                                      numerator, denominator))
+#define CFractions_Numerator(fraction) (cfractions_api->numerator(fraction))
+#define CFractions_Denominator(fraction) (cfractions_api->denominator(fraction))
+#define CFractions_Add(first, second) (cfractions_api->add(first, second))
+#define CFractions_Subtract(first, second) \
+  (cfractions_api->subtract(first, second))
+#define CFractions_Multiply(first, second) \
+  (cfractions_api->multiply(first, second))
+#define CFractions_TrueDivide(first, second) \
+  (cfractions_api->true_divide(first, second))
+#define CFractions_RichCompareBool(first, second, op) \
+  (cfractions_api->rich_compare_bool(first, second, op))
+#define CFractions_Hash(fraction) (cfractions_api->hash(fraction))
+#endif
+
+#endif
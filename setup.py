@@ -1,20 +1,23 @@
 from __future__ import annotations
 
+import os
 import sys
-from typing import Any
+from typing import Any, ClassVar
 
-from setuptools import find_packages, setup
+from setuptools import find_namespace_packages, setup
 
 project_base_url = 'https://github.com/lycantropos/cfractions/'
 parameters: dict[str, Any] = {
-    'packages': find_packages(exclude=('tests', 'tests.*')),
+    'packages': find_namespace_packages(
+        include=('cfractions', 'cfractions.*')
+    ),
     'url': project_base_url,
     'download_url': project_base_url + 'archive/master.zip',
 }
 if sys.implementation.name == 'cpython':
     from glob import glob
 
-    from setuptools import Extension
+    from setuptools import Command, Extension
     from setuptools.command.build_ext import build_ext
 
     class BuildExt(build_ext):
@@ -32,9 +35,92 @@ if sys.implementation.name == 'cpython':
                 extension.extra_compile_args += compile_args
             super().build_extensions()
 
+    extension_parameters: dict[str, Any] = {
+        'define_macros': [],
+        'include_dirs': [os.path.join('cfractions', 'include')],
+        'libraries': [],
+    }
+    if os.environ.get('CFRACTIONS_GMP') == '1':
+        # huge operands' arithmetic goes through GMP with the GIL released
+        extension_parameters['define_macros'].append(('CFRACTIONS_GMP', '1'))
+        extension_parameters['libraries'].append('gmp')
+    if os.environ.get('CFRACTIONS_STATS') == '0':
+        # counters behind `cfractions._stats` are compiled out
+        extension_parameters['define_macros'].append(
+            ('CFRACTIONS_NO_STATS', '1')
+        )
+    if os.environ.get('CFRACTIONS_USDT') == '1':
+        # static tracepoints, requires `sys/sdt.h` from SystemTap
+        extension_parameters['define_macros'].append(('CFRACTIONS_USDT', '1'))
+
+    class BuildKernelsBenchmark(Command):
+        description = 'build native benchmark of internal kernels'
+        user_options: ClassVar[list[tuple[str, str | None, str]]] = []
+
+        def initialize_options(self) -> None:
+            pass
+
+        def finalize_options(self) -> None:
+            pass
+
+        def run(self) -> None:
+            import shlex
+            import subprocess
+            import sysconfig
+
+            def get_flags(name: str) -> list[str]:
+                return shlex.split(sysconfig.get_config_var(name) or '')
+
+            library_directory = sysconfig.get_config_var('LIBDIR')
+            command = [
+                *get_flags('CC'),
+                '-O2',
+                '-Werror',
+                '-Wall',
+                '-Wextra',
+                *(('-Wconversion',) if sys.version_info < (3, 12) else ()),
+                '-I',
+                'src',
+                *(
+                    f'-I{directory}'
+                    for directory in extension_parameters['include_dirs']
+                ),
+                '-I',
+                sysconfig.get_path('include'),
+                *(
+                    f'-D{name}={value}'
+                    for name, value in extension_parameters['define_macros']
+                ),
+                os.path.join('benchmarks', 'kernels.c'),
+                '-o',
+                os.path.join('build', 'kernels_benchmark'),
+                f'-L{library_directory}',
+                f'-L{sysconfig.get_config_var("LIBPL")}',
+                f'-Wl,-rpath,{library_directory}',
+                f'-lpython{sysconfig.get_config_var("LDVERSION")}',
+                *(
+                    f'-l{library}'
+                    for library in extension_parameters['libraries']
+                ),
+                *get_flags('LIBS'),
+                *get_flags('SYSLIBS'),
+            ]
+            self.mkpath('build')
+            self.announce(shlex.join(command), level=2)
+            subprocess.check_call(command)
+
     parameters.update(
-        cmdclass={build_ext.__name__: BuildExt},
-        ext_modules=[Extension('cfractions._cfractions', glob('src/*.c'))],
+        cmdclass={
+            build_ext.__name__: BuildExt,
+            'build_kernels_benchmark': BuildKernelsBenchmark,
+        },
+        ext_modules=[
+            Extension(
+                'cfractions._cfractions',
+                glob('src/*.c'),
+                **extension_parameters,
+            )
+        ],
         zip_safe=False,
     )
 setup(**parameters)
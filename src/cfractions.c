@@ -1,10 +1,317 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
+#include <float.h>
 #include <math.h>
 #include <structmember.h>
 
+#define CFRACTIONS_MODULE
+#include "cfractions.h"
+
 #define PY3_9_OR_MORE PY_VERSION_HEX >= 0x03090000
 #define PY3_11_OR_MORE PY_VERSION_HEX >= 0x030b0000
+#define PY3_12_OR_MORE PY_VERSION_HEX >= 0x030c0000
+#define PY3_13_OR_MORE PY_VERSION_HEX >= 0x030d0000
+
+#ifdef Py_GIL_DISABLED
+/* Free-threaded builds have no interpreter lock to serialize advancing
+   of an iterator shared between threads, so it is taken per object. */
+#define DEFINE_LOCKED_ITERNEXT(name, object_type)     \
+  static PyObject* name##_locked(object_type* self) { \
+    PyObject* result;                                 \
+    Py_BEGIN_CRITICAL_SECTION(self);                  \
+    result = name(self);                              \
+    Py_END_CRITICAL_SECTION();                        \
+    return result;                                    \
+  }
+#define LOCKED_ITERNEXT(name) ((iternextfunc)name##_locked)
+#else
+#define DEFINE_LOCKED_ITERNEXT(name, object_type)
+#define LOCKED_ITERNEXT(name) ((iternextfunc)name)
+#endif
+
+/* Borrowed items of a list can be replaced by another thread
+   while they are processed, so free-threaded builds work on a copy. */
+static PyObject* sequence_fast_snapshot(PyObject* values, const char* message) {
+#ifdef Py_GIL_DISABLED
+  if (PyList_CheckExact(values)) return PyList_AsTuple(values);
+#endif
+  return PySequence_Fast(values, message);
+}
+
+/* Counters updated by threads which may run in parallel
+   with own GILs or without any are accessed only atomically
+   (with relaxed ordering). */
+#ifdef _MSC_VER
+#include <intrin.h>
+
+/* 64-bit interlocked operations other than compare-and-swap
+   are missing on 32-bit x86. */
+static unsigned long long counter_load(unsigned long long* counter) {
+  return (unsigned long long)_InterlockedCompareExchange64(
+      (volatile __int64*)counter, 0, 0);
+}
+
+static void counter_store(unsigned long long* counter,
+                          unsigned long long value) {
+  __int64 expected;
+  do
+    expected = (__int64)counter_load(counter);
+  while (_InterlockedCompareExchange64((volatile __int64*)counter,
+                                       (__int64)value,
+                                       expected) != expected);
+}
+#else
+static unsigned long long counter_load(unsigned long long* counter) {
+  return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+static void counter_store(unsigned long long* counter,
+                          unsigned long long value) {
+  __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+}
+#endif
+
+/* Opt-in counters of operations and slow paths,
+   compiled out with `CFRACTIONS_NO_STATS`.
+   They are shared by all interpreters of the process. */
+typedef enum {
+  OPERATION_ADD,
+  OPERATION_COMPARE,
+  OPERATION_DIVMOD,
+  OPERATION_FLOOR_DIVIDE,
+  OPERATION_MULTIPLY,
+  OPERATION_POWER,
+  OPERATION_REMAINDER,
+  OPERATION_SUBTRACT,
+  OPERATION_TRUE_DIVIDE,
+  OPERATIONS_COUNT
+} Operation;
+
+static const char* const operations_names[OPERATIONS_COUNT] = {
+    "add", "compare", "divmod", "floordiv", "mul",
+    "pow", "mod",     "sub",    "truediv"};
+
+typedef enum {
+  OPERAND_FRACTION,
+  OPERAND_INT,
+  OPERAND_FLOAT,
+  OPERAND_OTHER,
+  OPERAND_KINDS_COUNT
+} OperandKind;
+
+static const char* const operand_kinds_names[OPERAND_KINDS_COUNT] = {
+    "Fraction", "int", "float", "other"};
+
+/* GCD operands are bucketed by bit length rounded up to a power of two
+   starting from a machine word. */
+#define GCD_BITS_BUCKETS_COUNT 25
+#define GCD_BITS_MIN_EXPONENT 6
+
+typedef struct {
+  unsigned long long operations[OPERATIONS_COUNT][OPERAND_KINDS_COUNT]
+                               [OPERAND_KINDS_COUNT];
+  unsigned long long rational_checks;
+  unsigned long long rational_matches;
+  unsigned long long gcd_calls;
+  unsigned long long gcd_bits[GCD_BITS_BUCKETS_COUNT];
+  /* GCDs of machine words are counted apart
+     since they skip `Longs_gcd` */
+  unsigned long long word_gcd_calls;
+  unsigned long long fractions_allocated;
+  unsigned long long powers_of_ten_cache_hits;
+  unsigned long long powers_of_ten_cache_misses;
+} Stats;
+
+#ifdef CFRACTIONS_NO_STATS
+#define STATS_INCREMENT(field) ((void)0)
+#define STATS_COUNT_OPERATION(operation, first, second) ((void)0)
+#else
+#ifdef _MSC_VER
+static void counter_add(unsigned long long* counter,
+                        unsigned long long value) {
+  __int64 expected;
+  do
+    expected = (__int64)counter_load(counter);
+  while (_InterlockedCompareExchange64((volatile __int64*)counter,
+                                       expected + (__int64)value,
+                                       expected) != expected);
+}
+#else
+static void counter_add(unsigned long long* counter,
+                        unsigned long long value) {
+  __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+}
+#endif
+
+static Stats stats;
+static unsigned long long stats_are_enabled = 0;
+#define STATS_INCREMENT(field)            \
+  do {                                    \
+    if (counter_load(&stats_are_enabled)) \
+      counter_add(&stats.field, 1);       \
+  } while (0)
+#define STATS_COUNT_OPERATION(operation, first, second) \
+  do {                                                  \
+    if (counter_load(&stats_are_enabled))               \
+      stats_count_operation(operation, first, second);  \
+  } while (0)
+#endif
+
+/* Static tracepoints for SystemTap, bpftrace & perf
+   compiled in with `CFRACTIONS_USDT`.
+   Attached tracers set semaphores of their probes,
+   so arguments are computed only while somebody listens. */
+#ifdef CFRACTIONS_USDT
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+#define DEFINE_PROBE(name)                                  \
+  __attribute__((visibility("hidden"), section(".probes"))) \
+  volatile unsigned short cfractions_##name##_semaphore
+#define IS_PROBE_ENABLED(name) (cfractions_##name##_semaphore != 0)
+#define PROBE(name, ...) STAP_PROBEV(cfractions, name, __VA_ARGS__)
+
+/* operation name, first and second operands components bit lengths */
+DEFINE_PROBE(operation__entry);
+/* operation name, result components bit lengths */
+DEFINE_PROBE(operation__return);
+/* components bit lengths before and after normalization */
+DEFINE_PROBE(gcd__entry);
+DEFINE_PROBE(gcd__return);
+/* string length, result components bit lengths */
+DEFINE_PROBE(parse__entry);
+DEFINE_PROBE(parse__return);
+/* binary exponent, result components bit lengths */
+DEFINE_PROBE(from_float__entry);
+DEFINE_PROBE(from_float__return);
+/* components bit lengths, whether conversion succeeded */
+DEFINE_PROBE(to_float__entry);
+DEFINE_PROBE(to_float__return);
+
+/* Fires probe with bit lengths of components
+   unless they are missing due to an error. */
+#define PROBE_COMPONENTS(name, signal, numerator, denominator)            \
+  do {                                                                    \
+    if (IS_PROBE_ENABLED(name)) {                                         \
+      int is_successful = (signal) >= 0;                                  \
+      PROBE(name, is_successful ? _PyLong_NumBits(numerator) : (size_t)0, \
+            is_successful ? _PyLong_NumBits(denominator) : (size_t)0);    \
+    }                                                                     \
+  } while (0)
+#else
+#define IS_PROBE_ENABLED(name) 0
+#define PROBE(name, ...) ((void)0)
+#define PROBE_COMPONENTS(name, signal, numerator, denominator) ((void)0)
+#endif
+
+#ifdef CFRACTIONS_GMP
+#include <gmp.h>
+
+/* Operands of fewer bits stay on CPython arithmetic,
+   since for them conversions outweigh the gain from GMP algorithms. */
+#define GMP_THRESHOLD_BITS 2048
+
+static int Long_to_mpz(PyObject* value, mpz_t result) {
+  PyObject* modulus = PyNumber_Absolute(value);
+  if (modulus == NULL) return -1;
+  size_t size = (_PyLong_NumBits(modulus) + 7) / 8;
+  unsigned char* buffer = PyMem_Malloc(size);
+  if (buffer == NULL) {
+    Py_DECREF(modulus);
+    PyErr_NoMemory();
+    return -1;
+  }
+  int signal = _PyLong_AsByteArray((PyLongObject*)modulus, buffer, size, 1, 0
+#if PY3_13_OR_MORE
+                                   ,
+                                   1
+#endif
+  );
+  Py_DECREF(modulus);
+  if (signal < 0) {
+    PyMem_Free(buffer);
+    return -1;
+  }
+  mpz_import(result, size, -1, 1, 0, 0, buffer);
+  PyMem_Free(buffer);
+  if (_PyLong_Sign(value) < 0) mpz_neg(result, result);
+  return 0;
+}
+
+static PyObject* mpz_to_Long(mpz_srcptr value) {
+  size_t size = (mpz_sizeinbase(value, 2) + 7) / 8;
+  unsigned char* buffer = PyMem_Malloc(size);
+  if (buffer == NULL) return PyErr_NoMemory();
+  size_t count = 0;
+  mpz_export(buffer, &count, -1, 1, 0, 0, value);
+  PyObject* result = _PyLong_FromByteArray(buffer, count, 1, 0);
+  PyMem_Free(buffer);
+  if (result != NULL && mpz_sgn(value) < 0)
+    Py_SETREF(result, PyNumber_Negative(result));
+  return result;
+}
+
+static int are_Longs_huge(PyObject* first, PyObject* second) {
+  return _PyLong_NumBits(first) >= GMP_THRESHOLD_BITS &&
+         _PyLong_NumBits(second) >= GMP_THRESHOLD_BITS;
+}
+
+/* Runs GMP operation with the GIL released,
+   so other threads make progress meanwhile. */
+static PyObject* Longs_mpz_operation(PyObject* first, PyObject* second,
+                                     void (*operation)(mpz_ptr, mpz_srcptr,
+                                                       mpz_srcptr)) {
+  mpz_t first_mpz, second_mpz, result_mpz;
+  mpz_inits(first_mpz, second_mpz, result_mpz, NULL);
+  PyObject* result = NULL;
+  if (Long_to_mpz(first, first_mpz) == 0 &&
+      Long_to_mpz(second, second_mpz) == 0) {
+    Py_BEGIN_ALLOW_THREADS
+    operation(result_mpz, first_mpz, second_mpz);
+    Py_END_ALLOW_THREADS
+    result = mpz_to_Long(result_mpz);
+  }
+  mpz_clears(first_mpz, second_mpz, result_mpz, NULL);
+  return result;
+}
+#endif
+
+/* Arithmetic of integers which goes through GMP for huge operands
+   when built with `CFRACTIONS_GMP`. */
+static PyObject* Longs_floor_divide(PyObject* dividend, PyObject* divisor) {
+#ifdef CFRACTIONS_GMP
+  if (are_Longs_huge(dividend, divisor))
+    return Longs_mpz_operation(dividend, divisor, mpz_fdiv_q);
+#endif
+  return PyNumber_FloorDivide(dividend, divisor);
+}
+
+static PyObject* Longs_gcd(PyObject* first, PyObject* second) {
+#ifndef CFRACTIONS_NO_STATS
+  if (counter_load(&stats_are_enabled)) {
+    size_t bits = Py_MAX(_PyLong_NumBits(first), _PyLong_NumBits(second));
+    size_t bucket = 0;
+    while (bucket + 1 < GCD_BITS_BUCKETS_COUNT &&
+           bits > ((size_t)1 << (GCD_BITS_MIN_EXPONENT + bucket)))
+      ++bucket;
+    counter_add(&stats.gcd_calls, 1);
+    counter_add(&stats.gcd_bits[bucket], 1);
+  }
+#endif
+#ifdef CFRACTIONS_GMP
+  if (are_Longs_huge(first, second))
+    return Longs_mpz_operation(first, second, mpz_gcd);
+#endif
+  return _PyLong_GCD(first, second);
+}
+
+static PyObject* Longs_multiply(PyObject* first, PyObject* second) {
+#ifdef CFRACTIONS_GMP
+  if (are_Longs_huge(first, second))
+    return Longs_mpz_operation(first, second, mpz_mul);
+#endif
+  return PyNumber_Multiply(first, second);
+}
 
 static int is_negative_py_object(PyObject* self) {
   PyObject* tmp = PyLong_FromLong(0);
@@ -29,25 +336,49 @@ static PyObject* is_unit_py_object(PyObject* self) {
   return result;
 }
 
-static PyObject* round_py_object(PyObject* self) {
-  PyObject* round_method_name = PyUnicode_FromString("__round__");
-  if (round_method_name == NULL) return NULL;
-  PyObject* result =
-#if PY3_9_OR_MORE
-      PyObject_CallMethodNoArgs(self, round_method_name)
-#else
-      PyObject_CallMethodObjArgs(self, round_method_name, NULL)
-#endif
-      ;
-  Py_DECREF(round_method_name);
-  return result;
-}
-
 static int py_unicode_is_ascii(PyObject* self) {
   return ((PyASCIIObject*)self)->state.ascii;
 }
 
-static PyObject* Rational = NULL;
+#define POWERS_OF_TEN_CACHE_SIZE 64
+
+/* Everything an interpreter needs from the module,
+   so interpreters share no Python objects. */
+typedef struct {
+  PyTypeObject* fraction_type;
+  PyTypeObject* continued_fraction_iterator_type;
+  PyTypeObject* convergents_iterator_type;
+  PyTypeObject* farey_iterator_type;
+  PyTypeObject* mediants_iterator_type;
+  PyTypeObject* lazy_fraction_type;
+  PyObject* rational;
+  PyObject* powers_of_ten[POWERS_OF_TEN_CACHE_SIZE];
+  /* pointed by the `_C_API` capsule */
+  CFractionsAPI api;
+  /* called with components bit lengths of every fraction
+     with any of them exceeding the threshold */
+  PyObject* growth_hook;
+  Py_ssize_t growth_threshold_bits;
+  /* context variable with a pair of optional `max_denominator` & `max_bits`
+     of the innermost `precision_context` */
+  PyObject* precision;
+  /* set by the first entered `precision_context` and never cleared,
+     since contexts copied within it (e.g. by tasks) may outlive it,
+     so the variable is not looked up by programs not using it */
+  unsigned long long is_precision_used;
+#ifdef Py_GIL_DISABLED
+  /* guards replacing of the growth hook & its threshold */
+  PyMutex growth_hook_mutex;
+#endif
+} ModuleState;
+
+static ModuleState* get_module_state(PyObject* module) {
+  return (ModuleState*)PyModule_GetState(module);
+}
+
+static ModuleState* get_type_state(PyTypeObject* type) {
+  return (ModuleState*)PyType_GetModuleState(type);
+}
 
 typedef struct {
   PyObject_HEAD PyObject* numerator;
@@ -63,28 +394,57 @@ static int is_integral_fraction(FractionObject* self) {
 }
 
 static void fraction_dealloc(FractionObject* self) {
+  PyTypeObject* type = Py_TYPE(self);
   Py_DECREF(self->numerator);
   Py_DECREF(self->denominator);
-  Py_TYPE(self)->tp_free((PyObject*)self);
+  type->tp_free((PyObject*)self);
+  Py_DECREF(type);
 }
 
-static PyTypeObject FractionType;
+/* Every interpreter has its own non-subclassable fraction type,
+   all of them share the deallocator. */
+static int is_fraction(PyObject* object) {
+  return Py_TYPE(object)->tp_dealloc == (destructor)fraction_dealloc;
+}
 
-static int normalize_fraction_components_moduli(PyObject** result_numerator,
-                                                PyObject** result_denominator) {
-  PyObject* gcd = _PyLong_GCD(*result_numerator, *result_denominator);
+static int is_rational(PyTypeObject* cls, PyObject* object) {
+  int result = PyObject_IsInstance(object, get_type_state(cls)->rational);
+  STATS_INCREMENT(rational_checks);
+  if (result > 0) STATS_INCREMENT(rational_matches);
+  return result;
+}
+
+#ifndef CFRACTIONS_NO_STATS
+static OperandKind to_operand_kind(PyObject* operand) {
+  return is_fraction(operand)      ? OPERAND_FRACTION
+         : PyLong_Check(operand)  ? OPERAND_INT
+         : PyFloat_Check(operand) ? OPERAND_FLOAT
+                                  : OPERAND_OTHER;
+}
+
+static void stats_count_operation(Operation operation, PyObject* first,
+                                  PyObject* second) {
+  counter_add(&stats.operations[operation][to_operand_kind(first)]
+                                [to_operand_kind(second)],
+              1);
+}
+#endif
+
+static int normalize_fraction_components_moduli_untraced(
+    PyObject** result_numerator, PyObject** result_denominator) {
+  PyObject* gcd = Longs_gcd(*result_numerator, *result_denominator);
   if (gcd == NULL) return -1;
   int is_gcd_unit = is_unit_py_object_bool(gcd);
   if (is_gcd_unit < 0) {
     Py_DECREF(gcd);
     return -1;
   } else if (!is_gcd_unit) {
-    PyObject* numerator = PyNumber_FloorDivide(*result_numerator, gcd);
+    PyObject* numerator = Longs_floor_divide(*result_numerator, gcd);
     if (numerator == NULL) {
       Py_DECREF(gcd);
       return -1;
     }
-    PyObject* denominator = PyNumber_FloorDivide(*result_denominator, gcd);
+    PyObject* denominator = Longs_floor_divide(*result_denominator, gcd);
     if (denominator == NULL) {
       Py_DECREF(numerator);
       Py_DECREF(gcd);
@@ -101,6 +461,16 @@ static int normalize_fraction_components_moduli(PyObject** result_numerator,
   return 0;
 }
 
+static int normalize_fraction_components_moduli(PyObject** result_numerator,
+                                                PyObject** result_denominator) {
+  PROBE_COMPONENTS(gcd__entry, 0, *result_numerator, *result_denominator);
+  int result = normalize_fraction_components_moduli_untraced(
+      result_numerator, result_denominator);
+  PROBE_COMPONENTS(gcd__return, result, *result_numerator,
+                   *result_denominator);
+  return result;
+}
+
 static int normalize_fraction_components_signs(PyObject** result_numerator,
                                                PyObject** result_denominator) {
   int is_denominator_negative = is_negative_py_object(*result_denominator);
@@ -156,7 +526,7 @@ static int parse_fraction_components_from_rational(
   return 0;
 }
 
-static int parse_fraction_components_from_double(
+static int parse_fraction_components_from_double_untraced(
     double value, PyObject** result_numerator, PyObject** result_denominator) {
   if (isinf(value)) {
     PyErr_SetString(PyExc_OverflowError,
@@ -211,6 +581,20 @@ static int parse_fraction_components_from_double(
   return 0;
 }
 
+static int parse_fraction_components_from_double(
+    double value, PyObject** result_numerator, PyObject** result_denominator) {
+  if (IS_PROBE_ENABLED(from_float__entry)) {
+    int exponent = 0;
+    if (isfinite(value)) frexp(value, &exponent);
+    PROBE(from_float__entry, exponent);
+  }
+  int result = parse_fraction_components_from_double_untraced(
+      value, result_numerator, result_denominator);
+  PROBE_COMPONENTS(from_float__return, result, *result_numerator,
+                   *result_denominator);
+  return result;
+}
+
 const Py_UCS1 ascii_whitespaces[] = {
     0, 0, 0, 0, 0, 0, 0, 0,
     /*     case 0x0009: * CHARACTER TABULATION */
@@ -316,7 +700,7 @@ static PyObject* append_zeros(PyObject* self, PyObject* exponent) {
   return result;
 }
 
-static int parse_fraction_components_from_PyUnicode(
+static int parse_fraction_components_from_PyUnicode_untraced(
     PyObject* value, PyObject** result_numerator,
     PyObject** result_denominator) {
   Py_ssize_t size = PyUnicode_GET_LENGTH(value);
@@ -574,13 +958,78 @@ static int parse_fraction_components_from_PyUnicode(
   return -1;
 }
 
+static int parse_fraction_components_from_PyUnicode(
+    PyObject* value, PyObject** result_numerator,
+    PyObject** result_denominator) {
+  if (IS_PROBE_ENABLED(parse__entry))
+    PROBE(parse__entry, PyUnicode_GET_LENGTH(value));
+  int result = parse_fraction_components_from_PyUnicode_untraced(
+      value, result_numerator, result_denominator);
+  PROBE_COMPONENTS(parse__return, result, *result_numerator,
+                   *result_denominator);
+  return result;
+}
+
+/* Free-threaded builds may replace the growth hook
+   while other threads are about to call it,
+   so it is replaced & taken under a lock
+   which is acquired only for fractions exceeding the threshold. */
+#ifdef Py_GIL_DISABLED
+#define LOAD_GROWTH_HOOK(state) \
+  ((PyObject*)_Py_atomic_load_ptr_relaxed(&(state)->growth_hook))
+#define STORE_GROWTH_HOOK(state, value) \
+  _Py_atomic_store_ptr_relaxed(&(state)->growth_hook, (value))
+#define LOAD_GROWTH_THRESHOLD_BITS(state) \
+  _Py_atomic_load_ssize_relaxed(&(state)->growth_threshold_bits)
+#define STORE_GROWTH_THRESHOLD_BITS(state, value) \
+  _Py_atomic_store_ssize_relaxed(&(state)->growth_threshold_bits, (value))
+#define LOCK_GROWTH_HOOK(state) PyMutex_Lock(&(state)->growth_hook_mutex)
+#define UNLOCK_GROWTH_HOOK(state) PyMutex_Unlock(&(state)->growth_hook_mutex)
+#else
+#define LOAD_GROWTH_HOOK(state) ((state)->growth_hook)
+#define STORE_GROWTH_HOOK(state, value) ((state)->growth_hook = (value))
+#define LOAD_GROWTH_THRESHOLD_BITS(state) ((state)->growth_threshold_bits)
+#define STORE_GROWTH_THRESHOLD_BITS(state, value) \
+  ((state)->growth_threshold_bits = (value))
+#define LOCK_GROWTH_HOOK(state)
+#define UNLOCK_GROWTH_HOOK(state)
+#endif
+
+static int check_fraction_growth(ModuleState* state,
+                                 FractionObject* fraction) {
+  size_t numerator_bits = _PyLong_NumBits(fraction->numerator),
+         denominator_bits = _PyLong_NumBits(fraction->denominator),
+         bits = Py_MAX(numerator_bits, denominator_bits);
+  if (bits <= (size_t)LOAD_GROWTH_THRESHOLD_BITS(state)) return 0;
+  LOCK_GROWTH_HOOK(state);
+  PyObject* hook = bits > (size_t)state->growth_threshold_bits
+                       ? state->growth_hook
+                       : NULL;
+  Py_XINCREF(hook);
+  UNLOCK_GROWTH_HOOK(state);
+  if (hook == NULL) return 0;
+  PyObject* tmp = PyObject_CallFunction(hook, "nn", (Py_ssize_t)numerator_bits,
+                                        (Py_ssize_t)denominator_bits);
+  Py_DECREF(hook);
+  if (tmp == NULL) return -1;
+  Py_DECREF(tmp);
+  return 0;
+}
+
 static FractionObject* construct_fraction(PyTypeObject* cls,
                                           PyObject* numerator,
                                           PyObject* denominator) {
   FractionObject* result = (FractionObject*)(cls->tp_alloc(cls, 0));
+  STATS_INCREMENT(fractions_allocated);
   if (result) {
     result->numerator = numerator;
     result->denominator = denominator;
+    ModuleState* state = get_type_state(cls);
+    if (LOAD_GROWTH_HOOK(state) != NULL &&
+        check_fraction_growth(state, result) < 0) {
+      Py_DECREF(result);
+      return NULL;
+    }
   } else {
     Py_DECREF(denominator);
     Py_DECREF(numerator);
@@ -588,11 +1037,181 @@ static FractionObject* construct_fraction(PyTypeObject* cls,
   return result;
 }
 
+static int Long_to_int64(PyObject* value, long long* result) {
+  int overflow;
+  *result = PyLong_AsLongLongAndOverflow(value, &overflow);
+  if (*result == -1 && PyErr_Occurred()) return -1;
+  return !overflow;
+}
+
+/* Floored division with positive divisor. */
+static void int64_floor_divmod(long long dividend, long long divisor,
+                               long long* result_quotient,
+                               long long* result_remainder) {
+  long long quotient = dividend / divisor, remainder = dividend % divisor;
+  if (remainder < 0) {
+    remainder += divisor;
+    --quotient;
+  }
+  *result_quotient = quotient;
+  *result_remainder = remainder;
+}
+
+static int int64_add(long long first, long long second, long long* result) {
+  if ((second > 0 && first > LLONG_MAX - second) ||
+      (second < 0 && first < LLONG_MIN - second))
+    return 0;
+  *result = first + second;
+  return 1;
+}
+
+static int int64_multiply(long long first, long long second,
+                          long long* result) {
+  unsigned long long first_modulus =
+      first < 0 ? 0ULL - (unsigned long long)first : (unsigned long long)first;
+  unsigned long long second_modulus =
+      second < 0 ? 0ULL - (unsigned long long)second
+                 : (unsigned long long)second;
+  if (first_modulus != 0 &&
+      second_modulus > (unsigned long long)LLONG_MAX / first_modulus)
+    return 0;
+  *result = first * second;
+  return 1;
+}
+
+/* Exponentiation by squaring with non-negative exponent,
+   returns 0 on overflow. */
+static int int64_power(long long base, long long exponent, long long* result) {
+  long long accumulator = 1;
+  for (;;) {
+    if ((exponent & 1) && !int64_multiply(accumulator, base, &accumulator))
+      return 0;
+    exponent >>= 1;
+    if (exponent == 0) break;
+    if (!int64_multiply(base, base, &base)) return 0;
+  }
+  *result = accumulator;
+  return 1;
+}
+
+/* Floored root of non-negative value. */
+static long long int64_root(long long value, long long degree) {
+  if (value < 2 || degree == 1) return value;
+  if (degree >= 63) return 1;
+  long long power,
+      result = (long long)pow((double)value, 1.0 / (double)degree);
+  /* floating point estimate can be off by one in either direction */
+  while (result > 1 &&
+         (!int64_power(result, degree, &power) || power > value))
+    --result;
+  while (int64_power(result + 1, degree, &power) && power <= value) ++result;
+  return result;
+}
+
+/* Checks if the residue is a power modulo small modulus. */
+static int uint64_is_power_residue(unsigned long long residue,
+                                   long long degree,
+                                   unsigned long long modulus) {
+  for (unsigned long long base = 0; base < modulus; ++base) {
+    unsigned long long factor = base, power = 1;
+    for (long long exponent = degree; exponent > 0; exponent >>= 1) {
+      if (exponent & 1) power = power * factor % modulus;
+      factor = factor * factor % modulus;
+    }
+    if (power == residue) return 1;
+  }
+  return 0;
+}
+
+static void uint64_multiply_wide(unsigned long long first,
+                                 unsigned long long second,
+                                 unsigned long long* result_high,
+                                 unsigned long long* result_low) {
+  unsigned long long first_high = first >> 32,
+                     first_low = first & 0xFFFFFFFFULL,
+                     second_high = second >> 32,
+                     second_low = second & 0xFFFFFFFFULL;
+  unsigned long long low_low = first_low * second_low,
+                     low_high = first_low * second_high,
+                     high_low = first_high * second_low,
+                     high_high = first_high * second_high;
+  unsigned long long middle = (low_low >> 32) + (low_high & 0xFFFFFFFFULL) +
+                              (high_low & 0xFFFFFFFFULL);
+  *result_low = (middle << 32) | (low_low & 0xFFFFFFFFULL);
+  *result_high =
+      high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+}
+
+/* Checks if `first * second <= third * fourth` without overflow. */
+static int uint64_products_less_equal(unsigned long long first,
+                                      unsigned long long second,
+                                      unsigned long long third,
+                                      unsigned long long fourth) {
+  unsigned long long left_high, left_low, right_high, right_low;
+  uint64_multiply_wide(first, second, &left_high, &left_low);
+  uint64_multiply_wide(third, fourth, &right_high, &right_low);
+  return left_high < right_high ||
+         (left_high == right_high && left_low <= right_low);
+}
+
+static FractionObject* construct_fraction_from_small_components(
+    PyTypeObject* cls, long long numerator, long long denominator) {
+  PyObject* result_numerator = PyLong_FromLongLong(numerator);
+  if (result_numerator == NULL) return NULL;
+  PyObject* result_denominator = PyLong_FromLongLong(denominator);
+  if (result_denominator == NULL) {
+    Py_DECREF(result_numerator);
+    return NULL;
+  }
+  return construct_fraction(cls, result_numerator, result_denominator);
+}
+
 int are_kwargs_passed(PyObject* kwargs) {
   return kwargs != NULL &&
          (!PyDict_CheckExact(kwargs) || PyDict_GET_SIZE(kwargs) != 0);
 }
 
+static int parse_fraction_components_from_terms(
+    PyObject* numerator, PyObject* denominator, PyObject** result_numerator,
+    PyObject** result_denominator) {
+  if (!PyLong_Check(numerator)) {
+    PyErr_SetString(PyExc_TypeError, "Numerator should be an integer.");
+    return -1;
+  }
+  if (!PyLong_Check(denominator)) {
+    PyErr_SetString(PyExc_TypeError, "Denominator should be an integer.");
+    return -1;
+  }
+  if (PyObject_Not(denominator)) {
+    PyErr_SetString(PyExc_ZeroDivisionError,
+                    "Denominator should be non-zero.");
+    return -1;
+  }
+  int is_denominator_negative = is_negative_py_object(denominator);
+  if (is_denominator_negative < 0)
+    return -1;
+  else if (is_denominator_negative) {
+    numerator = PyNumber_Negative(numerator);
+    if (numerator == NULL) return -1;
+    denominator = PyNumber_Negative(denominator);
+    if (denominator == NULL) {
+      Py_DECREF(numerator);
+      return -1;
+    }
+  } else {
+    Py_INCREF(numerator);
+    Py_INCREF(denominator);
+  }
+  if (normalize_fraction_components_moduli(&numerator, &denominator) < 0) {
+    Py_DECREF(numerator);
+    Py_DECREF(denominator);
+    return -1;
+  }
+  *result_numerator = numerator;
+  *result_denominator = denominator;
+  return 0;
+}
+
 static PyObject* fraction_new(PyTypeObject* cls, PyObject* args,
                               PyObject* kwargs) {
   if (are_kwargs_passed(kwargs)) {
@@ -602,39 +1221,9 @@ static PyObject* fraction_new(PyTypeObject* cls, PyObject* args,
   PyObject *numerator = NULL, *denominator = NULL;
   if (!PyArg_ParseTuple(args, "|OO", &numerator, &denominator)) return NULL;
   if (denominator != NULL) {
-    if (!PyLong_Check(numerator)) {
-      PyErr_SetString(PyExc_TypeError, "Numerator should be an integer.");
-      return NULL;
-    }
-    if (!PyLong_Check(denominator)) {
-      PyErr_SetString(PyExc_TypeError, "Denominator should be an integer.");
-      return NULL;
-    }
-    if (PyObject_Not(denominator)) {
-      PyErr_SetString(PyExc_ZeroDivisionError,
-                      "Denominator should be non-zero.");
-      return NULL;
-    }
-    int is_denominator_negative = is_negative_py_object(denominator);
-    if (is_denominator_negative < 0)
-      return NULL;
-    else if (is_denominator_negative) {
-      numerator = PyNumber_Negative(numerator);
-      if (numerator == NULL) return NULL;
-      denominator = PyNumber_Negative(denominator);
-      if (denominator == NULL) {
-        Py_DECREF(numerator);
-        return NULL;
-      }
-    } else {
-      Py_INCREF(numerator);
-      Py_INCREF(denominator);
-    }
-    if (normalize_fraction_components_moduli(&numerator, &denominator) < 0) {
-      Py_DECREF(numerator);
-      Py_DECREF(denominator);
+    if (parse_fraction_components_from_terms(numerator, denominator,
+                                             &numerator, &denominator) < 0)
       return NULL;
-    }
   } else if (numerator != NULL) {
     if (PyLong_Check(numerator)) {
       denominator = PyLong_FromLong(1);
@@ -644,13 +1233,13 @@ static PyObject* fraction_new(PyTypeObject* cls, PyObject* args,
       if (parse_fraction_components_from_double(PyFloat_AS_DOUBLE(numerator),
                                                 &numerator, &denominator) < 0)
         return NULL;
-    } else if (PyObject_TypeCheck(numerator, &FractionType)) {
+    } else if (is_fraction(numerator)) {
       FractionObject* fraction_numerator = (FractionObject*)numerator;
       Py_INCREF(fraction_numerator->denominator);
       denominator = fraction_numerator->denominator;
       Py_INCREF(fraction_numerator->numerator);
       numerator = fraction_numerator->numerator;
-    } else if (PyObject_IsInstance(numerator, Rational)) {
+    } else if (is_rational(cls, numerator)) {
       if (parse_fraction_components_from_rational(numerator, &numerator,
                                                   &denominator) < 0)
         return NULL;
@@ -729,9 +1318,9 @@ static PyObject* Fractions_components_richcompare(PyObject* numerator,
       return PyObject_RichCompare(denominator, other_denominator, op);
     }
     default: {
-      PyObject* left = PyNumber_Multiply(numerator, other_denominator);
+      PyObject* left = Longs_multiply(numerator, other_denominator);
       if (left == NULL) return NULL;
-      PyObject* right = PyNumber_Multiply(other_numerator, denominator);
+      PyObject* right = Longs_multiply(other_numerator, denominator);
       if (right == NULL) {
         Py_DECREF(left);
         return NULL;
@@ -753,7 +1342,8 @@ static PyObject* Fractions_richcompare(FractionObject* self,
 
 static PyObject* fraction_richcompare(FractionObject* self, PyObject* other,
                                       int op) {
-  if (PyObject_TypeCheck(other, &FractionType))
+  STATS_COUNT_OPERATION(OPERATION_COMPARE, (PyObject*)self, other);
+  if (is_fraction(other))
     return Fractions_richcompare(self, (FractionObject*)other, op);
   else if (PyLong_Check(other)) {
     if (op == Py_EQ) {
@@ -800,7 +1390,7 @@ static PyObject* fraction_richcompare(FractionObject* self, PyObject* other,
     return Fractions_components_richcompare(self->numerator, self->denominator,
                                             other_numerator, other_denominator,
                                             op);
-  } else if (PyObject_IsInstance(other, Rational)) {
+  } else if (is_rational(Py_TYPE(self), other)) {
     PyObject *other_denominator, *other_numerator;
     if (parse_fraction_components_from_rational(other, &other_numerator,
                                                 &other_denominator) < 0)
@@ -817,7 +1407,7 @@ static FractionObject* fraction_negative(FractionObject* self) {
   if (numerator == NULL) return NULL;
   Py_INCREF(self->denominator);
   PyObject* denominator = self->denominator;
-  return construct_fraction(&FractionType, numerator, denominator);
+  return construct_fraction(Py_TYPE(self), numerator, denominator);
 }
 
 static FractionObject* fraction_absolute(FractionObject* self) {
@@ -825,22 +1415,27 @@ static FractionObject* fraction_absolute(FractionObject* self) {
   if (numerator == NULL) return NULL;
   Py_INCREF(self->denominator);
   PyObject* denominator = self->denominator;
-  return construct_fraction(&FractionType, numerator, denominator);
+  return construct_fraction(Py_TYPE(self), numerator, denominator);
 }
 
 static PyObject* fraction_float(FractionObject* self) {
-  return PyNumber_TrueDivide(self->numerator, self->denominator);
+  PROBE_COMPONENTS(to_float__entry, 0, self->numerator, self->denominator);
+  PyObject* result = PyNumber_TrueDivide(self->numerator, self->denominator);
+  if (IS_PROBE_ENABLED(to_float__return))
+    PROBE(to_float__return, result != NULL);
+  return result;
 }
 
-static FractionObject* Fractions_components_add(PyObject* numerator,
+static FractionObject* Fractions_components_add(PyTypeObject* cls,
+                                                PyObject* numerator,
                                                 PyObject* denominator,
                                                 PyObject* other_numerator,
                                                 PyObject* other_denominator) {
   PyObject* first_result_numerator_component =
-      PyNumber_Multiply(numerator, other_denominator);
+      Longs_multiply(numerator, other_denominator);
   if (first_result_numerator_component == NULL) return NULL;
   PyObject* second_result_numerator_component =
-      PyNumber_Multiply(other_numerator, denominator);
+      Longs_multiply(other_numerator, denominator);
   if (second_result_numerator_component == NULL) {
     Py_DECREF(first_result_numerator_component);
     return NULL;
@@ -851,7 +1446,7 @@ static FractionObject* Fractions_components_add(PyObject* numerator,
   Py_DECREF(first_result_numerator_component);
   if (result_numerator == NULL) return NULL;
   PyObject* result_denominator =
-      PyNumber_Multiply(denominator, other_denominator);
+      Longs_multiply(denominator, other_denominator);
   if (result_denominator == NULL) {
     Py_DECREF(result_numerator);
     return NULL;
@@ -862,14 +1457,14 @@ static FractionObject* Fractions_components_add(PyObject* numerator,
     Py_DECREF(result_numerator);
     return NULL;
   }
-  return construct_fraction(&FractionType, result_numerator,
-                            result_denominator);
+  return construct_fraction(cls, result_numerator, result_denominator);
 }
 
 static FractionObject* Fractions_add(FractionObject* self,
                                      FractionObject* other) {
-  return Fractions_components_add(self->numerator, self->denominator,
-                                  other->numerator, other->denominator);
+  return Fractions_components_add(Py_TYPE(self), self->numerator,
+                                  self->denominator, other->numerator,
+                                  other->denominator);
 }
 
 static PyObject* fraction_Float_add(FractionObject* self, PyObject* other) {
@@ -882,7 +1477,7 @@ static PyObject* fraction_Float_add(FractionObject* self, PyObject* other) {
 
 static FractionObject* fraction_Long_add(FractionObject* self,
                                          PyObject* other) {
-  PyObject* tmp = PyNumber_Multiply(other, self->denominator);
+  PyObject* tmp = Longs_multiply(other, self->denominator);
   if (tmp == NULL) return NULL;
   PyObject* result_numerator = PyNumber_Add(self->numerator, tmp);
   Py_DECREF(tmp);
@@ -895,7 +1490,7 @@ static FractionObject* fraction_Long_add(FractionObject* self,
     Py_DECREF(result_numerator);
     return NULL;
   }
-  return construct_fraction(&FractionType, result_numerator,
+  return construct_fraction(Py_TYPE(self), result_numerator,
                             result_denominator);
 }
 
@@ -905,29 +1500,32 @@ static FractionObject* fraction_Rational_add(FractionObject* self,
   if (parse_fraction_components_from_rational(other, &other_numerator,
                                               &other_denominator) < 0)
     return NULL;
-  FractionObject* result = Fractions_components_add(
-      self->numerator, self->denominator, other_numerator, other_denominator);
+  FractionObject* result =
+      Fractions_components_add(Py_TYPE(self), self->numerator,
+                               self->denominator, other_numerator,
+                               other_denominator);
   Py_DECREF(other_denominator);
   Py_DECREF(other_numerator);
   return result;
 }
 
-static PyObject* fraction_add(PyObject* self, PyObject* other) {
-  if (PyObject_TypeCheck(self, &FractionType)) {
-    if (PyObject_TypeCheck(other, &FractionType))
+static PyObject* fraction_add_exact(PyObject* self, PyObject* other) {
+  STATS_COUNT_OPERATION(OPERATION_ADD, self, other);
+  if (is_fraction(self)) {
+    if (is_fraction(other))
       return (PyObject*)Fractions_add((FractionObject*)self,
                                       (FractionObject*)other);
     else if (PyLong_Check(other))
       return (PyObject*)fraction_Long_add((FractionObject*)self, other);
     else if (PyFloat_Check(other))
       return (PyObject*)fraction_Float_add((FractionObject*)self, other);
-    else if (PyObject_IsInstance(other, Rational))
+    else if (is_rational(Py_TYPE(self), other))
       return (PyObject*)fraction_Rational_add((FractionObject*)self, other);
   } else if (PyLong_Check(self))
     return (PyObject*)fraction_Long_add((FractionObject*)other, self);
   else if (PyFloat_Check(self))
     return (PyObject*)fraction_Float_add((FractionObject*)other, self);
-  else if (PyObject_IsInstance(self, Rational))
+  else if (is_rational(Py_TYPE(other), self))
     return (PyObject*)fraction_Rational_add((FractionObject*)other, self);
   Py_RETURN_NOTIMPLEMENTED;
 }
@@ -965,102 +1563,531 @@ static PyObject* fraction_ceil(FractionObject* self,
 
 static PyObject* fraction_copy(FractionObject* self,
                                PyObject* Py_UNUSED(args)) {
-  if (Py_TYPE(self) == &FractionType) {
-    Py_INCREF(self);
-    return (PyObject*)self;
-  } else
-    return PyObject_CallFunctionObjArgs(
-        (PyObject*)Py_TYPE(self), self->numerator, self->denominator, NULL);
-}
-
-static PyObject* fraction_reduce(FractionObject* self,
-                                 PyObject* Py_UNUSED(args)) {
-  return Py_BuildValue("O(OO)", Py_TYPE(self), self->numerator,
-                       self->denominator);
-}
-
-static PyObject* fraction_floor_impl(FractionObject* self) {
-  return PyNumber_FloorDivide(self->numerator, self->denominator);
-}
-
-static PyObject* fraction_floor(FractionObject* self,
-                                PyObject* Py_UNUSED(args)) {
-  return fraction_floor_impl(self);
+  Py_INCREF(self);
+  return (PyObject*)self;
 }
 
-static PyObject* Fractions_components_floor_divide(
-    PyObject* numerator, PyObject* denominator, PyObject* other_numerator,
-    PyObject* other_denominator) {
-  PyObject* dividend = PyNumber_Multiply(numerator, other_denominator);
-  if (dividend == NULL) return NULL;
-  PyObject* divisor = PyNumber_Multiply(denominator, other_numerator);
-  if (divisor == NULL) {
-    Py_DECREF(dividend);
+static PyObject* fraction_restore(PyTypeObject* cls, PyObject* const* args,
+                                  Py_ssize_t args_count) {
+  if (args_count != 2) {
+    PyErr_Format(PyExc_TypeError,
+                 "Expected numerator & denominator, but got %zd arguments.",
+                 args_count);
     return NULL;
   }
-  PyObject* result = PyNumber_FloorDivide(dividend, divisor);
-  Py_DECREF(dividend);
-  Py_DECREF(divisor);
-  return result;
-}
-
-static PyObject* Fractions_floor_divide(FractionObject* self,
-                                        FractionObject* other) {
-  return Fractions_components_floor_divide(
-      self->numerator, self->denominator, other->numerator, other->denominator);
-}
-
-static PyObject* fraction_Long_floor_divide(FractionObject* self,
-                                            PyObject* other) {
-  PyObject* gcd = _PyLong_GCD(self->numerator, other);
-  if (gcd == NULL) return NULL;
-  PyObject* dividend = PyNumber_FloorDivide(self->numerator, gcd);
-  if (dividend == NULL) {
-    Py_DECREF(gcd);
+  PyObject *numerator = args[0], *denominator = args[1];
+  if (!PyLong_CheckExact(numerator) || !PyLong_CheckExact(denominator) ||
+      _PyLong_Sign(denominator) <= 0) {
+    PyErr_SetString(PyExc_ValueError,
+                    "Numerator & denominator should be integers "
+                    "with positive denominator.");
     return NULL;
   }
-  PyObject* other_normalized = PyNumber_FloorDivide(other, gcd);
+  /* components may come from untrusted data,
+     so only the division by their gcd is skipped, not its check */
+  PyObject* gcd = Longs_gcd(numerator, denominator);
+  if (gcd == NULL) return NULL;
+  int overflow;
+  long long gcd_value = PyLong_AsLongLongAndOverflow(gcd, &overflow);
   Py_DECREF(gcd);
-  if (other_normalized == NULL) {
-    Py_DECREF(dividend);
+  if (gcd_value == -1 && PyErr_Occurred()) return NULL;
+  if (overflow || gcd_value != 1) {
+    PyErr_SetString(PyExc_ValueError,
+                    "Numerator & denominator should be coprime.");
     return NULL;
   }
-  PyObject* divisor = PyNumber_Multiply(self->denominator, other_normalized);
-  Py_DECREF(other_normalized);
-  if (divisor == NULL) {
-    Py_DECREF(dividend);
+  Py_INCREF(numerator);
+  Py_INCREF(denominator);
+  return (PyObject*)construct_fraction(cls, numerator, denominator);
+}
+
+/* Reconstructs a fraction pickled by `__reduce__` from its components
+   without normalizing them, since unpickling executes arbitrary code
+   anyway, so pickled data is trusted. */
+static PyObject* fraction_unpickle(PyTypeObject* cls, PyObject* const* args,
+                                   Py_ssize_t args_count) {
+  if (args_count != 2) {
+    PyErr_Format(PyExc_TypeError,
+                 "Expected numerator & denominator, but got %zd arguments.",
+                 args_count);
     return NULL;
   }
-  PyObject* result = PyNumber_FloorDivide(dividend, divisor);
-  Py_DECREF(dividend);
-  Py_DECREF(divisor);
-  return result;
+  PyObject *numerator = args[0], *denominator = args[1];
+  if (!PyLong_CheckExact(numerator) || !PyLong_CheckExact(denominator)) {
+    PyErr_SetString(PyExc_TypeError,
+                    "Numerator & denominator should be integers.");
+    return NULL;
+  }
+  Py_INCREF(numerator);
+  Py_INCREF(denominator);
+  return (PyObject*)construct_fraction(cls, numerator, denominator);
 }
 
-static PyObject* Long_fraction_floor_divide(PyObject* self,
-                                            FractionObject* other) {
-  PyObject* gcd = _PyLong_GCD(self, other->numerator);
-  if (gcd == NULL) return NULL;
-  PyObject* divisor = PyNumber_FloorDivide(other->numerator, gcd);
-  if (divisor == NULL) {
-    Py_DECREF(gcd);
+static PyObject* fraction_reduce(FractionObject* self,
+                                 PyObject* Py_UNUSED(args)) {
+  PyObject* unpickle = PyObject_GetAttrString((PyObject*)Py_TYPE(self),
+                                              "_unpickle");
+  if (unpickle == NULL) return NULL;
+  return Py_BuildValue("N(OO)", unpickle, self->numerator, self->denominator);
+}
+
+/* Binary form of a fraction is its numerator followed by its denominator,
+   each of them is encoded as a LEB128 header
+   which has sign in the second lowest bit and
+   - if the lowest bit is unset: magnitude in the rest of bits,
+   - otherwise: size of the magnitude bytes (in little-endian order)
+     which follow the header. */
+
+#define MAX_INLINE_TERM_MAGNITUDE ((1ULL << 62) - 1)
+#define MAX_VARINT_SIZE 10
+
+typedef struct {
+  unsigned char* data;
+  Py_ssize_t capacity;
+  Py_ssize_t size;
+} BytesWriter;
+
+typedef struct {
+  const unsigned char* data;
+  Py_ssize_t position;
+  Py_ssize_t size;
+} BytesReader;
+
+static unsigned long long uint64_gcd(unsigned long long first,
+                                     unsigned long long second) {
+  STATS_INCREMENT(word_gcd_calls);
+  while (second) {
+    unsigned long long tmp = first % second;
+    first = second;
+    second = tmp;
+  }
+  return first;
+}
+
+static int bytes_writer_reserve(BytesWriter* self, Py_ssize_t size) {
+  if (self->size + size <= self->capacity) return 0;
+  Py_ssize_t capacity = self->capacity ? self->capacity : 64;
+  while (capacity < self->size + size) capacity *= 2;
+  unsigned char* data = PyMem_Realloc(self->data, (size_t)capacity);
+  if (data == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  self->data = data;
+  self->capacity = capacity;
+  return 0;
+}
+
+static void bytes_writer_write_varint(BytesWriter* self,
+                                      unsigned long long value) {
+  for (; value >= 0x80; value >>= 7)
+    self->data[self->size++] = (unsigned char)(value | 0x80);
+  self->data[self->size++] = (unsigned char)value;
+}
+
+static int bytes_writer_write_term(BytesWriter* self, PyObject* value) {
+  int overflow;
+  long long small_value = PyLong_AsLongLongAndOverflow(value, &overflow);
+  if (small_value == -1 && PyErr_Occurred()) return -1;
+  if (!overflow) {
+    unsigned long long magnitude = small_value < 0
+                                       ? 0ULL - (unsigned long long)small_value
+                                       : (unsigned long long)small_value;
+    if (magnitude <= MAX_INLINE_TERM_MAGNITUDE) {
+      if (bytes_writer_reserve(self, MAX_VARINT_SIZE) < 0) return -1;
+      bytes_writer_write_varint(
+          self, magnitude << 2 | (unsigned long long)(small_value < 0) << 1);
+      return 0;
+    }
+  }
+  int is_negative = _PyLong_Sign(value) < 0;
+  PyObject* magnitude = PyNumber_Absolute(value);
+  if (magnitude == NULL) return -1;
+  size_t magnitude_size = (_PyLong_NumBits(magnitude) + 7) / 8;
+  if (bytes_writer_reserve(self,
+                           MAX_VARINT_SIZE + (Py_ssize_t)magnitude_size) < 0) {
+    Py_DECREF(magnitude);
+    return -1;
+  }
+  bytes_writer_write_varint(self, (unsigned long long)magnitude_size << 2 |
+                                      (unsigned long long)is_negative << 1 |
+                                      1);
+  int signal = _PyLong_AsByteArray((PyLongObject*)magnitude,
+                                   self->data + self->size, magnitude_size,
+                                   1, 0
+#if PY3_13_OR_MORE
+                                   ,
+                                   1
+#endif
+  );
+  Py_DECREF(magnitude);
+  if (signal < 0) return -1;
+  self->size += (Py_ssize_t)magnitude_size;
+  return 0;
+}
+
+static int bytes_writer_write_fraction(BytesWriter* self,
+                                       FractionObject* fraction) {
+  return bytes_writer_write_term(self, fraction->numerator) < 0
+             ? -1
+             : bytes_writer_write_term(self, fraction->denominator);
+}
+
+static int bytes_reader_read_varint(BytesReader* self,
+                                    unsigned long long* result) {
+  unsigned long long value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (self->position == self->size) {
+      PyErr_SetString(PyExc_ValueError, "Data is truncated.");
+      return -1;
+    }
+    unsigned char byte = self->data[self->position++];
+    value |= (unsigned long long)(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      *result = value;
+      return 0;
+    }
+  }
+  PyErr_SetString(PyExc_ValueError, "Variable-length integer is too long.");
+  return -1;
+}
+
+/* Reads a term either into the small value (returning 1)
+   or into the integer object (returning 0). */
+static int bytes_reader_read_term(BytesReader* self, long long* small_result,
+                                  PyObject** result) {
+  unsigned long long header;
+  if (bytes_reader_read_varint(self, &header) < 0) return -1;
+  int is_negative = (int)(header >> 1 & 1);
+  if (!(header & 1)) {
+    long long magnitude = (long long)(header >> 2);
+    *small_result = is_negative ? -magnitude : magnitude;
+    return 1;
+  }
+  unsigned long long magnitude_size = header >> 2;
+  if (magnitude_size > (unsigned long long)(self->size - self->position)) {
+    PyErr_SetString(PyExc_ValueError, "Data is truncated.");
+    return -1;
+  }
+  PyObject* magnitude = _PyLong_FromByteArray(
+      self->data + self->position, (size_t)magnitude_size, 1, 0);
+  if (magnitude == NULL) return -1;
+  self->position += (Py_ssize_t)magnitude_size;
+  if (is_negative) {
+    *result = PyNumber_Negative(magnitude);
+    Py_DECREF(magnitude);
+    if (*result == NULL) return -1;
+  } else
+    *result = magnitude;
+  return 0;
+}
+
+static FractionObject* bytes_reader_read_fraction(BytesReader* self,
+                                                  PyTypeObject* cls) {
+  long long small_numerator = 0, small_denominator = 0;
+  PyObject *denominator = NULL, *numerator = NULL;
+  int numerator_signal =
+      bytes_reader_read_term(self, &small_numerator, &numerator);
+  if (numerator_signal < 0) return NULL;
+  int denominator_signal =
+      bytes_reader_read_term(self, &small_denominator, &denominator);
+  if (denominator_signal < 0) {
+    Py_XDECREF(numerator);
     return NULL;
   }
-  PyObject* self_normalized = PyNumber_FloorDivide(self, gcd);
-  Py_DECREF(gcd);
-  if (self_normalized == NULL) {
-    Py_DECREF(divisor);
+  if (numerator_signal && denominator_signal) {
+    if (small_denominator <= 0) {
+      PyErr_SetString(PyExc_ValueError, "Denominator should be positive.");
+      return NULL;
+    }
+    unsigned long long gcd = uint64_gcd(
+        (unsigned long long)(small_numerator < 0 ? -small_numerator
+                                                 : small_numerator),
+        (unsigned long long)small_denominator);
+    numerator = PyLong_FromLongLong(small_numerator / (long long)gcd);
+    if (numerator == NULL) return NULL;
+    denominator = PyLong_FromLongLong(small_denominator / (long long)gcd);
+    if (denominator == NULL) {
+      Py_DECREF(numerator);
+      return NULL;
+    }
+    return construct_fraction(cls, numerator, denominator);
+  }
+  if (numerator_signal) {
+    numerator = PyLong_FromLongLong(small_numerator);
+    if (numerator == NULL) {
+      Py_DECREF(denominator);
+      return NULL;
+    }
+  } else if (denominator_signal) {
+    denominator = PyLong_FromLongLong(small_denominator);
+    if (denominator == NULL) {
+      Py_DECREF(numerator);
+      return NULL;
+    }
+  }
+  if (_PyLong_Sign(denominator) <= 0) {
+    PyErr_SetString(PyExc_ValueError, "Denominator should be positive.");
+    Py_DECREF(denominator);
+    Py_DECREF(numerator);
     return NULL;
   }
-  PyObject* dividend = PyNumber_Multiply(self_normalized, other->denominator);
-  Py_DECREF(self_normalized);
-  if (dividend == NULL) {
-    Py_DECREF(divisor);
+  if (normalize_fraction_components_moduli(&numerator, &denominator) < 0) {
+    Py_DECREF(denominator);
+    Py_DECREF(numerator);
+    return NULL;
+  }
+  return construct_fraction(cls, numerator, denominator);
+}
+
+static PyObject* fraction_to_bytes(FractionObject* self,
+                                   PyObject* Py_UNUSED(args)) {
+  BytesWriter writer = {NULL, 0, 0};
+  if (bytes_writer_write_fraction(&writer, self) < 0) {
+    PyMem_Free(writer.data);
     return NULL;
   }
-  PyObject* result = PyNumber_FloorDivide(dividend, divisor);
+  PyObject* result =
+      PyBytes_FromStringAndSize((const char*)writer.data, writer.size);
+  PyMem_Free(writer.data);
+  return result;
+}
+
+static PyObject* fraction_from_bytes(PyTypeObject* cls, PyObject* data) {
+  Py_buffer buffer;
+  if (PyObject_GetBuffer(data, &buffer, PyBUF_SIMPLE) < 0) return NULL;
+  BytesReader reader = {buffer.buf, 0, buffer.len};
+  FractionObject* result = bytes_reader_read_fraction(&reader, cls);
+  if (result != NULL && reader.position != reader.size) {
+    Py_DECREF(result);
+    result = NULL;
+    PyErr_SetString(PyExc_ValueError, "Data has trailing bytes.");
+  }
+  PyBuffer_Release(&buffer);
+  return (PyObject*)result;
+}
+
+static PyObject* fraction_floor_impl(FractionObject* self) {
+  return PyNumber_FloorDivide(self->numerator, self->denominator);
+}
+
+static PyObject* fraction_floor(FractionObject* self,
+                                PyObject* Py_UNUSED(args)) {
+  return fraction_floor_impl(self);
+}
+
+static int Longs_divmod(PyObject* dividend, PyObject* divisor,
+                        PyObject** result_quotient,
+                        PyObject** result_remainder) {
+  PyObject* pair = PyNumber_Divmod(dividend, divisor);
+  if (pair == NULL)
+    return -1;
+  else if (!PyTuple_Check(pair) || PyTuple_GET_SIZE(pair) != 2) {
+    Py_DECREF(pair);
+    PyErr_SetString(PyExc_TypeError,
+                    "`divmod` should return pair of integers.");
+    return -1;
+  }
+  PyObject* quotient = PyTuple_GET_ITEM(pair, 0);
+  Py_INCREF(quotient);
+  PyObject* remainder = PyTuple_GET_ITEM(pair, 1);
+  Py_INCREF(remainder);
+  Py_DECREF(pair);
+  *result_quotient = quotient;
+  *result_remainder = remainder;
+  return 0;
+}
+
+/* Floored division of fractions with non-zero divisor,
+   returns 0 on overflow. */
+static int int64_fractions_divmod(const long long components[4],
+                                  long long* result_quotient,
+                                  long long result_remainder[2]) {
+  long long gcd = result_remainder == NULL
+                      ? 1
+                      : (long long)uint64_gcd(
+                            (unsigned long long)components[1],
+                            (unsigned long long)components[3]);
+  long long denominator_part = components[1] / gcd,
+            other_denominator_part = components[3] / gcd, dividend, divisor;
+  if (!int64_multiply(components[0], other_denominator_part, &dividend) ||
+      !int64_multiply(components[2], denominator_part, &divisor))
+    return 0;
+  int is_divisor_negative = divisor < 0;
+  if (is_divisor_negative) {
+    if (dividend == LLONG_MIN || divisor == LLONG_MIN) return 0;
+    dividend = -dividend;
+    divisor = -divisor;
+  }
+  long long quotient, remainder;
+  int64_floor_divmod(dividend, divisor, &quotient, &remainder);
+  if (result_remainder != NULL) {
+    long long remainder_denominator;
+    if (!int64_multiply(denominator_part, components[3],
+                        &remainder_denominator))
+      return 0;
+    if (remainder == 0)
+      remainder_denominator = 1;
+    else {
+      long long remainder_gcd = (long long)uint64_gcd(
+          (unsigned long long)remainder, (unsigned long long)components[3]);
+      remainder /= remainder_gcd;
+      remainder_denominator /= remainder_gcd;
+    }
+    result_remainder[0] = is_divisor_negative ? -remainder : remainder;
+    result_remainder[1] = remainder_denominator;
+  }
+  *result_quotient = quotient;
+  return 1;
+}
+
+/* Floored division of `numerator / denominator`
+   by `other_numerator / other_denominator`
+   producing the quotient and/or the remainder (if pointer is not `NULL`).
+   For the remainder denominators are split by their GCD `g`,
+   so the quotient is
+   `numerator * other_denominator / g // (other_numerator * denominator / g)`
+   and the remainder's denominator is `lcm(denominator, other_denominator)`,
+   which shares factors with the remainder's numerator
+   only through `other_denominator`. */
+static int Fractions_components_divmod_impl(PyTypeObject* cls,
+                                            PyObject* numerator,
+                                            PyObject* denominator,
+                                            PyObject* other_numerator,
+                                            PyObject* other_denominator,
+                                            PyObject** result_quotient,
+                                            FractionObject** result_remainder) {
+  long long components[4], small_quotient, small_remainder[2];
+  int signal = Long_to_int64(numerator, &components[0]);
+  if (signal > 0) signal = Long_to_int64(denominator, &components[1]);
+  if (signal > 0) signal = Long_to_int64(other_numerator, &components[2]);
+  if (signal > 0) signal = Long_to_int64(other_denominator, &components[3]);
+  if (signal < 0) return -1;
+  if (signal && components[2] != 0 &&
+      int64_fractions_divmod(
+          components, &small_quotient,
+          result_remainder == NULL ? NULL : small_remainder)) {
+    if (result_quotient != NULL) {
+      *result_quotient = PyLong_FromLongLong(small_quotient);
+      if (*result_quotient == NULL) return -1;
+    }
+    if (result_remainder != NULL) {
+      *result_remainder = construct_fraction_from_small_components(
+          cls, small_remainder[0], small_remainder[1]);
+      if (*result_remainder == NULL) {
+        if (result_quotient != NULL) Py_DECREF(*result_quotient);
+        return -1;
+      }
+    }
+    return 0;
+  }
+  PyObject *denominator_part = NULL, *other_denominator_part = NULL,
+           *dividend = NULL, *divisor = NULL, *quotient = NULL,
+           *remainder_numerator = NULL, *remainder_denominator = NULL;
+  PyObject* gcd = NULL;
+  int is_gcd_unit = 1;
+  /* splitting large denominators does not pay off for the quotient alone */
+  if (result_remainder != NULL) {
+    gcd = Longs_gcd(denominator, other_denominator);
+    if (gcd == NULL || (is_gcd_unit = is_unit_py_object_bool(gcd)) < 0)
+      goto error;
+  }
+  if (is_gcd_unit) {
+    Py_INCREF(denominator);
+    denominator_part = denominator;
+    Py_INCREF(other_denominator);
+    other_denominator_part = other_denominator;
+  } else if ((denominator_part = PyNumber_FloorDivide(denominator, gcd)) ==
+                 NULL ||
+             (other_denominator_part =
+                  PyNumber_FloorDivide(other_denominator, gcd)) == NULL)
+    goto error;
+  if ((dividend = PyNumber_Multiply(numerator, other_denominator_part)) ==
+          NULL ||
+      (divisor = PyNumber_Multiply(other_numerator, denominator_part)) == NULL)
+    goto error;
+  if (result_remainder == NULL) {
+    if ((quotient = PyNumber_FloorDivide(dividend, divisor)) == NULL)
+      goto error;
+  } else if (result_quotient == NULL) {
+    if ((remainder_numerator = PyNumber_Remainder(dividend, divisor)) == NULL)
+      goto error;
+  } else if (Longs_divmod(dividend, divisor, &quotient,
+                          &remainder_numerator) < 0)
+    goto error;
+  if (result_remainder != NULL) {
+    remainder_denominator =
+        PyNumber_Multiply(denominator_part, other_denominator);
+    if (remainder_denominator == NULL) goto error;
+    Py_SETREF(gcd, Longs_gcd(remainder_numerator, other_denominator));
+    if (gcd == NULL || (is_gcd_unit = is_unit_py_object_bool(gcd)) < 0)
+      goto error;
+    if (!is_gcd_unit) {
+      Py_SETREF(remainder_numerator,
+                PyNumber_FloorDivide(remainder_numerator, gcd));
+      if (remainder_numerator == NULL) goto error;
+      Py_SETREF(remainder_denominator,
+                PyNumber_FloorDivide(remainder_denominator, gcd));
+      if (remainder_denominator == NULL) goto error;
+    }
+    *result_remainder = construct_fraction(cls, remainder_numerator,
+                                           remainder_denominator);
+    remainder_numerator = remainder_denominator = NULL;
+    if (*result_remainder == NULL) goto error;
+  }
+  if (result_quotient != NULL) *result_quotient = quotient;
+  Py_XDECREF(gcd);
+  Py_DECREF(denominator_part);
+  Py_DECREF(other_denominator_part);
   Py_DECREF(dividend);
   Py_DECREF(divisor);
+  return 0;
+error:
+  Py_XDECREF(gcd);
+  Py_XDECREF(denominator_part);
+  Py_XDECREF(other_denominator_part);
+  Py_XDECREF(dividend);
+  Py_XDECREF(divisor);
+  Py_XDECREF(quotient);
+  Py_XDECREF(remainder_numerator);
+  Py_XDECREF(remainder_denominator);
+  return -1;
+}
+
+static PyObject* Fractions_components_floor_divide(
+    PyObject* numerator, PyObject* denominator, PyObject* other_numerator,
+    PyObject* other_denominator) {
+  PyObject* result;
+  return Fractions_components_divmod_impl(NULL, numerator, denominator,
+                                          other_numerator, other_denominator,
+                                          &result, NULL) < 0
+             ? NULL
+             : result;
+}
+
+static PyObject* Fractions_floor_divide(FractionObject* self,
+                                        FractionObject* other) {
+  return Fractions_components_floor_divide(
+      self->numerator, self->denominator, other->numerator, other->denominator);
+}
+
+static PyObject* fraction_Long_floor_divide(FractionObject* self,
+                                            PyObject* other) {
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) return NULL;
+  PyObject* result = Fractions_components_floor_divide(
+      self->numerator, self->denominator, other, one);
+  Py_DECREF(one);
+  return result;
+}
+
+static PyObject* Long_fraction_floor_divide(PyObject* self,
+                                            FractionObject* other) {
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) return NULL;
+  PyObject* result = Fractions_components_floor_divide(
+      self, one, other->numerator, other->denominator);
+  Py_DECREF(one);
   return result;
 }
 
@@ -1091,8 +2118,9 @@ static PyObject* Rational_fraction_floor_divide(PyObject* self,
 }
 
 static PyObject* fraction_floor_divide(PyObject* self, PyObject* other) {
-  if (PyObject_TypeCheck(self, &FractionType)) {
-    if (PyObject_TypeCheck(other, &FractionType))
+  STATS_COUNT_OPERATION(OPERATION_FLOOR_DIVIDE, self, other);
+  if (is_fraction(self)) {
+    if (is_fraction(other))
       return Fractions_floor_divide((FractionObject*)self,
                                     (FractionObject*)other);
     else if (PyLong_Check(other))
@@ -1103,7 +2131,7 @@ static PyObject* fraction_floor_divide(PyObject* self, PyObject* other) {
       PyObject* result = PyNumber_FloorDivide(tmp, other);
       Py_DECREF(tmp);
       return result;
-    } else if (PyObject_IsInstance(other, Rational))
+    } else if (is_rational(Py_TYPE(self), other))
       return fraction_Rational_floor_divide((FractionObject*)self, other);
   } else if (PyLong_Check(self))
     return Long_fraction_floor_divide(self, (FractionObject*)other);
@@ -1113,126 +2141,55 @@ static PyObject* fraction_floor_divide(PyObject* self, PyObject* other) {
     PyObject* result = PyNumber_FloorDivide(self, tmp);
     Py_DECREF(tmp);
     return result;
-  } else if (PyObject_IsInstance(self, Rational))
+  } else if (is_rational(Py_TYPE(other), self))
     return Rational_fraction_floor_divide(self, (FractionObject*)other);
   Py_RETURN_NOTIMPLEMENTED;
 }
 
-static int Longs_divmod(PyObject* dividend, PyObject* divisor,
-                        PyObject** result_quotient,
-                        PyObject** result_remainder) {
-  PyObject* pair = PyNumber_Divmod(dividend, divisor);
-  if (pair == NULL)
-    return -1;
-  else if (!PyTuple_Check(pair) || PyTuple_GET_SIZE(pair) != 2) {
-    Py_DECREF(pair);
-    PyErr_SetString(PyExc_TypeError,
-                    "`divmod` should return pair of integers.");
-    return -1;
-  }
-  PyObject* quotient = PyTuple_GET_ITEM(pair, 0);
-  Py_INCREF(quotient);
-  PyObject* remainder = PyTuple_GET_ITEM(pair, 1);
-  Py_INCREF(remainder);
-  Py_DECREF(pair);
-  *result_quotient = quotient;
-  *result_remainder = remainder;
-  return 0;
-}
-
-static PyObject* Fractions_components_divmod(PyObject* numerator,
+static PyObject* Fractions_components_divmod(PyTypeObject* cls,
+                                             PyObject* numerator,
                                              PyObject* denominator,
                                              PyObject* other_numerator,
                                              PyObject* other_denominator) {
-  PyObject* dividend = PyNumber_Multiply(numerator, other_denominator);
-  if (dividend == NULL) return NULL;
-  PyObject* divisor = PyNumber_Multiply(other_numerator, denominator);
-  if (divisor == NULL) {
-    Py_DECREF(dividend);
-    return NULL;
-  }
-  PyObject *quotient, *remainder_numerator;
-  int divmod_signal =
-      Longs_divmod(dividend, divisor, &quotient, &remainder_numerator);
-  Py_DECREF(divisor);
-  Py_DECREF(dividend);
-  if (divmod_signal < 0) return NULL;
-  PyObject* remainder_denominator =
-      PyNumber_Multiply(denominator, other_denominator);
-  if (remainder_denominator == NULL) {
-    Py_DECREF(remainder_numerator);
-    Py_DECREF(quotient);
+  PyObject* quotient;
+  FractionObject* remainder;
+  if (Fractions_components_divmod_impl(cls, numerator, denominator,
+                                       other_numerator, other_denominator,
+                                       &quotient, &remainder) < 0)
     return NULL;
-  }
-  if (normalize_fraction_components_moduli(&remainder_numerator,
-                                           &remainder_denominator) < 0) {
-    Py_DECREF(remainder_denominator);
-    Py_DECREF(remainder_numerator);
-    Py_DECREF(quotient);
-    return NULL;
-  }
-  FractionObject* remainder = construct_fraction(
-      &FractionType, remainder_numerator, remainder_denominator);
-  if (remainder == NULL) {
+  PyObject* result = PyTuple_New(2);
+  if (result == NULL) {
+    Py_DECREF(remainder);
     Py_DECREF(quotient);
     return NULL;
   }
-  return PyTuple_Pack(2, quotient, remainder);
+  PyTuple_SET_ITEM(result, 0, quotient);
+  PyTuple_SET_ITEM(result, 1, (PyObject*)remainder);
+  return result;
 }
 
 static PyObject* Fractions_divmod(FractionObject* self, FractionObject* other) {
-  return Fractions_components_divmod(self->numerator, self->denominator,
-                                     other->numerator, other->denominator);
+  return Fractions_components_divmod(Py_TYPE(self), self->numerator,
+                                     self->denominator, other->numerator,
+                                     other->denominator);
 }
 
 static PyObject* fraction_Long_divmod(FractionObject* self, PyObject* other) {
-  PyObject* tmp = PyNumber_Multiply(other, self->denominator);
-  if (tmp == NULL) return NULL;
-  PyObject *quotient, *remainder_numerator;
-  int divmod_signal =
-      Longs_divmod(self->numerator, tmp, &quotient, &remainder_numerator);
-  if (divmod_signal < 0) return NULL;
-  PyObject* remainder_denominator = self->denominator;
-  Py_INCREF(remainder_denominator);
-  if (normalize_fraction_components_moduli(&remainder_numerator,
-                                           &remainder_denominator) < 0) {
-    Py_DECREF(remainder_denominator);
-    Py_DECREF(remainder_numerator);
-    Py_DECREF(quotient);
-    return NULL;
-  }
-  FractionObject* remainder = construct_fraction(
-      &FractionType, remainder_numerator, remainder_denominator);
-  if (remainder == NULL) {
-    Py_DECREF(quotient);
-    return NULL;
-  }
-  return PyTuple_Pack(2, quotient, remainder);
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) return NULL;
+  PyObject* result = Fractions_components_divmod(
+      Py_TYPE(self), self->numerator, self->denominator, other, one);
+  Py_DECREF(one);
+  return result;
 }
 
 static PyObject* Long_fraction_divmod(PyObject* self, FractionObject* other) {
-  PyObject* tmp = PyNumber_Multiply(self, other->denominator);
-  if (tmp == NULL) return NULL;
-  PyObject *quotient, *remainder_numerator;
-  int divmod_signal =
-      Longs_divmod(tmp, other->numerator, &quotient, &remainder_numerator);
-  if (divmod_signal < 0) return NULL;
-  PyObject* remainder_denominator = other->denominator;
-  Py_INCREF(remainder_denominator);
-  if (normalize_fraction_components_moduli(&remainder_numerator,
-                                           &remainder_denominator) < 0) {
-    Py_DECREF(remainder_denominator);
-    Py_DECREF(remainder_numerator);
-    Py_DECREF(quotient);
-    return NULL;
-  }
-  FractionObject* remainder = construct_fraction(
-      &FractionType, remainder_numerator, remainder_denominator);
-  if (remainder == NULL) {
-    Py_DECREF(quotient);
-    return NULL;
-  }
-  return PyTuple_Pack(2, quotient, remainder);
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) return NULL;
+  PyObject* result = Fractions_components_divmod(
+      Py_TYPE(other), self, one, other->numerator, other->denominator);
+  Py_DECREF(one);
+  return result;
 }
 
 static PyObject* fraction_Rational_divmod(FractionObject* self,
@@ -1242,7 +2199,8 @@ static PyObject* fraction_Rational_divmod(FractionObject* self,
                                               &other_denominator) < 0)
     return NULL;
   PyObject* result = Fractions_components_divmod(
-      self->numerator, self->denominator, other_numerator, other_denominator);
+      Py_TYPE(self), self->numerator, self->denominator, other_numerator,
+      other_denominator);
   Py_DECREF(other_denominator);
   Py_DECREF(other_numerator);
   return result;
@@ -1254,16 +2212,18 @@ static PyObject* Rational_fraction_divmod(PyObject* self,
   if (parse_fraction_components_from_rational(self, &numerator, &denominator) <
       0)
     return NULL;
-  PyObject* result = Fractions_components_divmod(
-      numerator, denominator, other->numerator, other->denominator);
+  PyObject* result = Fractions_components_divmod(Py_TYPE(other), numerator,
+                                                 denominator, other->numerator,
+                                                 other->denominator);
   Py_DECREF(denominator);
   Py_DECREF(numerator);
   return result;
 }
 
 static PyObject* fraction_divmod(PyObject* self, PyObject* other) {
-  if (PyObject_TypeCheck(self, &FractionType)) {
-    if (PyObject_TypeCheck(other, &FractionType))
+  STATS_COUNT_OPERATION(OPERATION_DIVMOD, self, other);
+  if (is_fraction(self)) {
+    if (is_fraction(other))
       return Fractions_divmod((FractionObject*)self, (FractionObject*)other);
     else if (PyLong_Check(other))
       return fraction_Long_divmod((FractionObject*)self, other);
@@ -1273,7 +2233,7 @@ static PyObject* fraction_divmod(PyObject* self, PyObject* other) {
       PyObject* result = PyNumber_Divmod(float_self, other);
       Py_DECREF(float_self);
       return result;
-    } else if (PyObject_IsInstance(other, Rational))
+    } else if (is_rational(Py_TYPE(self), other))
       return fraction_Rational_divmod((FractionObject*)self, other);
   } else if (PyLong_Check(self))
     return Long_fraction_divmod(self, (FractionObject*)other);
@@ -1283,7 +2243,7 @@ static PyObject* fraction_divmod(PyObject* self, PyObject* other) {
     PyObject* result = PyNumber_Divmod(self, float_other);
     Py_DECREF(float_other);
     return result;
-  } else if (PyObject_IsInstance(self, Rational))
+  } else if (is_rational(Py_TYPE(other), self))
     return Rational_fraction_divmod(self, (FractionObject*)other);
   Py_RETURN_NOTIMPLEMENTED;
 }
@@ -1338,31 +2298,31 @@ static Py_hash_t fraction_hash(FractionObject* self) {
 }
 
 static FractionObject* Fractions_components_multiply(
-    PyObject* numerator, PyObject* denominator, PyObject* other_numerator,
-    PyObject* other_denominator) {
-  PyObject* gcd = _PyLong_GCD(numerator, other_denominator);
+    PyTypeObject* cls, PyObject* numerator, PyObject* denominator,
+    PyObject* other_numerator, PyObject* other_denominator) {
+  PyObject* gcd = Longs_gcd(numerator, other_denominator);
   if (gcd == NULL) return NULL;
-  numerator = PyNumber_FloorDivide(numerator, gcd);
+  numerator = Longs_floor_divide(numerator, gcd);
   if (numerator == NULL) {
     Py_DECREF(gcd);
     return NULL;
   }
-  other_denominator = PyNumber_FloorDivide(other_denominator, gcd);
+  other_denominator = Longs_floor_divide(other_denominator, gcd);
   Py_DECREF(gcd);
   if (other_denominator == NULL) {
     Py_DECREF(numerator);
     return NULL;
   }
-  gcd = _PyLong_GCD(other_numerator, denominator);
+  gcd = Longs_gcd(other_numerator, denominator);
   if (gcd == NULL) return NULL;
-  other_numerator = PyNumber_FloorDivide(other_numerator, gcd);
+  other_numerator = Longs_floor_divide(other_numerator, gcd);
   if (other_numerator == NULL) {
     Py_DECREF(gcd);
     Py_DECREF(other_denominator);
     Py_DECREF(numerator);
     return NULL;
   }
-  denominator = PyNumber_FloorDivide(denominator, gcd);
+  denominator = Longs_floor_divide(denominator, gcd);
   Py_DECREF(gcd);
   if (denominator == NULL) {
     Py_DECREF(other_numerator);
@@ -1370,7 +2330,7 @@ static FractionObject* Fractions_components_multiply(
     Py_DECREF(numerator);
     return NULL;
   }
-  PyObject* result_numerator = PyNumber_Multiply(numerator, other_numerator);
+  PyObject* result_numerator = Longs_multiply(numerator, other_numerator);
   Py_DECREF(other_numerator);
   Py_DECREF(numerator);
   if (result_numerator == NULL) {
@@ -1379,21 +2339,21 @@ static FractionObject* Fractions_components_multiply(
     return NULL;
   }
   PyObject* result_denominator =
-      PyNumber_Multiply(denominator, other_denominator);
+      Longs_multiply(denominator, other_denominator);
   Py_DECREF(other_denominator);
   Py_DECREF(denominator);
   if (result_denominator == NULL) {
     Py_DECREF(result_numerator);
     return NULL;
   }
-  return construct_fraction(&FractionType, result_numerator,
-                            result_denominator);
+  return construct_fraction(cls, result_numerator, result_denominator);
 }
 
 static FractionObject* Fractions_multiply(FractionObject* self,
                                           FractionObject* other) {
-  return Fractions_components_multiply(self->numerator, self->denominator,
-                                       other->numerator, other->denominator);
+  return Fractions_components_multiply(Py_TYPE(self), self->numerator,
+                                       self->denominator, other->numerator,
+                                       other->denominator);
 }
 
 static PyObject* fraction_Float_multiply(FractionObject* self,
@@ -1407,27 +2367,27 @@ static PyObject* fraction_Float_multiply(FractionObject* self,
 
 static FractionObject* fraction_Long_multiply(FractionObject* self,
                                               PyObject* other) {
-  PyObject* gcd = _PyLong_GCD(other, self->denominator);
+  PyObject* gcd = Longs_gcd(other, self->denominator);
   if (gcd == NULL) return NULL;
-  PyObject* other_normalized = PyNumber_FloorDivide(other, gcd);
+  PyObject* other_normalized = Longs_floor_divide(other, gcd);
   if (other_normalized == NULL) {
     Py_DECREF(gcd);
     return NULL;
   }
-  PyObject* result_denominator = PyNumber_FloorDivide(self->denominator, gcd);
+  PyObject* result_denominator = Longs_floor_divide(self->denominator, gcd);
   Py_DECREF(gcd);
   if (result_denominator == NULL) {
     Py_DECREF(other_normalized);
     return NULL;
   }
   PyObject* result_numerator =
-      PyNumber_Multiply(self->numerator, other_normalized);
+      Longs_multiply(self->numerator, other_normalized);
   Py_DECREF(other_normalized);
   if (result_numerator == NULL) {
     Py_DECREF(result_denominator);
     return NULL;
   }
-  return construct_fraction(&FractionType, result_numerator,
+  return construct_fraction(Py_TYPE(self), result_numerator,
                             result_denominator);
 }
 
@@ -1438,104 +2398,71 @@ static FractionObject* fraction_Rational_multiply(FractionObject* self,
                                               &other_denominator) < 0)
     return NULL;
   FractionObject* result = Fractions_components_multiply(
-      self->numerator, self->denominator, other_numerator, other_denominator);
+      Py_TYPE(self), self->numerator, self->denominator, other_numerator,
+      other_denominator);
   Py_DECREF(other_denominator);
   Py_DECREF(other_numerator);
   return result;
 }
 
-static PyObject* fraction_multiply(PyObject* self, PyObject* other) {
-  if (PyObject_TypeCheck(self, &FractionType)) {
-    if (PyObject_TypeCheck(other, &FractionType))
+static PyObject* fraction_multiply_exact(PyObject* self, PyObject* other) {
+  STATS_COUNT_OPERATION(OPERATION_MULTIPLY, self, other);
+  if (is_fraction(self)) {
+    if (is_fraction(other))
       return (PyObject*)Fractions_multiply((FractionObject*)self,
                                            (FractionObject*)other);
     else if (PyLong_Check(other))
       return (PyObject*)fraction_Long_multiply((FractionObject*)self, other);
     else if (PyFloat_Check(other))
       return (PyObject*)fraction_Float_multiply((FractionObject*)self, other);
-    else if (PyObject_IsInstance(other, Rational))
+    else if (is_rational(Py_TYPE(self), other))
       return (PyObject*)fraction_Rational_multiply((FractionObject*)self,
                                                    other);
   } else if (PyLong_Check(self))
     return (PyObject*)fraction_Long_multiply((FractionObject*)other, self);
   else if (PyFloat_Check(self))
     return (PyObject*)fraction_Float_multiply((FractionObject*)other, self);
-  else if (PyObject_IsInstance(self, Rational))
+  else if (is_rational(Py_TYPE(other), self))
     return (PyObject*)fraction_Rational_multiply((FractionObject*)other, self);
   Py_RETURN_NOTIMPLEMENTED;
 }
 
 static FractionObject* Fractions_components_remainder(
-    PyObject* numerator, PyObject* denominator, PyObject* other_numerator,
-    PyObject* other_denominator) {
-  PyObject* dividend = PyNumber_Multiply(numerator, other_denominator);
-  if (dividend == NULL) return NULL;
-  PyObject* divisor = PyNumber_Multiply(other_numerator, denominator);
-  if (divisor == NULL) {
-    Py_DECREF(dividend);
-    return NULL;
-  }
-  PyObject* result_numerator = PyNumber_Remainder(dividend, divisor);
-  Py_DECREF(dividend);
-  Py_DECREF(divisor);
-  if (result_numerator == NULL) return NULL;
-  PyObject* result_denominator =
-      PyNumber_Multiply(denominator, other_denominator);
-  if (result_denominator == NULL) {
-    Py_DECREF(result_numerator);
-    return NULL;
-  }
-  if (normalize_fraction_components_moduli(&result_numerator,
-                                           &result_denominator) < 0) {
-    Py_DECREF(result_denominator);
-    Py_DECREF(result_numerator);
-    return NULL;
-  }
-  return construct_fraction(&FractionType, result_numerator,
-                            result_denominator);
+    PyTypeObject* cls, PyObject* numerator, PyObject* denominator,
+    PyObject* other_numerator, PyObject* other_denominator) {
+  FractionObject* result;
+  return Fractions_components_divmod_impl(cls, numerator, denominator,
+                                          other_numerator, other_denominator,
+                                          NULL, &result) < 0
+             ? NULL
+             : result;
 }
 
 static FractionObject* Fractions_remainder(FractionObject* self,
                                            FractionObject* other) {
-  return Fractions_components_remainder(self->numerator, self->denominator,
-                                        other->numerator, other->denominator);
+  return Fractions_components_remainder(Py_TYPE(self), self->numerator,
+                                        self->denominator, other->numerator,
+                                        other->denominator);
 }
 
 static FractionObject* fraction_Long_remainder(FractionObject* self,
                                                PyObject* other) {
-  PyObject* tmp = PyNumber_Multiply(other, self->denominator);
-  if (tmp == NULL) return NULL;
-  PyObject* result_numerator = PyNumber_Remainder(self->numerator, tmp);
-  Py_DECREF(tmp);
-  if (result_numerator == NULL) return NULL;
-  Py_INCREF(self->denominator);
-  PyObject* result_denominator = self->denominator;
-  if (normalize_fraction_components_moduli(&result_numerator,
-                                           &result_denominator) < 0) {
-    Py_DECREF(result_denominator);
-    Py_DECREF(result_numerator);
-    return NULL;
-  }
-  return construct_fraction(&FractionType, result_numerator,
-                            result_denominator);
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) return NULL;
+  FractionObject* result = Fractions_components_remainder(
+      Py_TYPE(self), self->numerator, self->denominator, other, one);
+  Py_DECREF(one);
+  return result;
 }
 
 static FractionObject* Long_fraction_remainder(PyObject* self,
                                                FractionObject* other) {
-  PyObject* tmp = PyNumber_Multiply(self, other->denominator);
-  if (tmp == NULL) return NULL;
-  PyObject* result_numerator = PyNumber_Remainder(tmp, other->numerator);
-  Py_DECREF(tmp);
-  if (result_numerator == NULL) return NULL;
-  Py_INCREF(other->denominator);
-  PyObject* result_denominator = other->denominator;
-  if (normalize_fraction_components_moduli(&result_numerator,
-                                           &result_denominator) < 0) {
-    Py_DECREF(result_denominator);
-    Py_DECREF(result_numerator);
-  }
-  return construct_fraction(&FractionType, result_numerator,
-                            result_denominator);
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) return NULL;
+  FractionObject* result = Fractions_components_remainder(
+      Py_TYPE(other), self, one, other->numerator, other->denominator);
+  Py_DECREF(one);
+  return result;
 }
 
 static FractionObject* fraction_Rational_remainder(FractionObject* self,
@@ -1545,7 +2472,8 @@ static FractionObject* fraction_Rational_remainder(FractionObject* self,
                                               &other_denominator) < 0)
     return NULL;
   FractionObject* result = Fractions_components_remainder(
-      self->numerator, self->denominator, other_numerator, other_denominator);
+      Py_TYPE(self), self->numerator, self->denominator, other_numerator,
+      other_denominator);
   Py_DECREF(other_denominator);
   Py_DECREF(other_numerator);
   return result;
@@ -1558,7 +2486,8 @@ static FractionObject* Rational_fraction_remainder(PyObject* self,
       0)
     return NULL;
   FractionObject* result = Fractions_components_remainder(
-      numerator, denominator, other->numerator, other->denominator);
+      Py_TYPE(other), numerator, denominator, other->numerator,
+      other->denominator);
   Py_DECREF(denominator);
   Py_DECREF(numerator);
   return result;
@@ -1566,7 +2495,7 @@ static FractionObject* Rational_fraction_remainder(PyObject* self,
 
 static PyObject* FractionObject_remainder(FractionObject* self,
                                           PyObject* other) {
-  if (PyObject_TypeCheck(other, &FractionType))
+  if (is_fraction(other))
     return (PyObject*)Fractions_remainder(self, (FractionObject*)other);
   else if (PyLong_Check(other))
     return (PyObject*)fraction_Long_remainder(self, other);
@@ -1576,13 +2505,14 @@ static PyObject* FractionObject_remainder(FractionObject* self,
     PyObject* result = PyNumber_Remainder(tmp, other);
     Py_DECREF(tmp);
     return result;
-  } else if (PyObject_IsInstance(other, Rational))
+  } else if (is_rational(Py_TYPE(self), other))
     return (PyObject*)fraction_Rational_remainder(self, other);
   Py_RETURN_NOTIMPLEMENTED;
 }
 
 static PyObject* fraction_remainder(PyObject* self, PyObject* other) {
-  if (PyObject_TypeCheck(self, &FractionType))
+  STATS_COUNT_OPERATION(OPERATION_REMAINDER, self, other);
+  if (is_fraction(self))
     return FractionObject_remainder((FractionObject*)self, other);
   else if (PyLong_Check(self))
     return (PyObject*)Long_fraction_remainder(self, (FractionObject*)other);
@@ -1592,124 +2522,363 @@ static PyObject* fraction_remainder(PyObject* self, PyObject* other) {
     PyObject* result = PyNumber_Remainder(self, tmp);
     Py_DECREF(tmp);
     return result;
-  } else if (PyObject_IsInstance(self, Rational))
+  } else if (is_rational(Py_TYPE(other), self))
     return (PyObject*)Rational_fraction_remainder(self, (FractionObject*)other);
   Py_RETURN_NOTIMPLEMENTED;
 }
 
-static PyObject* Long_fraction_power(PyObject* self, FractionObject* exponent) {
-  int comparison_signal = is_integral_fraction(exponent);
-  if (comparison_signal < 0)
-    return NULL;
-  else if (comparison_signal) {
-    comparison_signal = is_negative_fraction(exponent);
-    if (comparison_signal < 0)
-      return NULL;
-    else if (comparison_signal) {
-      if (PyObject_Not(self)) {
-        PyErr_SetString(PyExc_ZeroDivisionError,
-                        "Either exponent should be non-negative "
-                        "or base should not be zero.");
-        return NULL;
-      }
-      PyObject* positive_exponent = PyNumber_Negative(exponent->numerator);
-      if (positive_exponent == NULL) return NULL;
-      PyObject* result_denominator =
-          PyNumber_Power(self, positive_exponent, Py_None);
-      Py_DECREF(positive_exponent);
-      if (result_denominator == NULL) return NULL;
-      PyObject* result_numerator = PyLong_FromLong(1);
-      if (result_numerator == NULL) {
-        Py_DECREF(result_denominator);
-        return NULL;
-      }
-      return (PyObject*)construct_fraction(&FractionType, result_numerator,
-                                           result_denominator);
-    } else {
-      PyObject* result_numerator =
-          PyNumber_Power(self, exponent->numerator, Py_None);
-      if (result_numerator == NULL) return NULL;
-      PyObject* result_denominator = PyLong_FromLong(1);
-      if (result_denominator == NULL) {
-        Py_DECREF(result_numerator);
-        return NULL;
-      }
-      return (PyObject*)construct_fraction(&FractionType, result_numerator,
-                                           result_denominator);
+/* Shifts the integer left for non-negative `shift` and right otherwise. */
+static PyObject* Long_shift(PyObject* value, long long shift) {
+  PyObject* shift_object = PyLong_FromLongLong(shift < 0 ? -shift : shift);
+  if (shift_object == NULL) return NULL;
+  PyObject* result = shift < 0 ? PyNumber_Rshift(value, shift_object)
+                               : PyNumber_Lshift(value, shift_object);
+  Py_DECREF(shift_object);
+  return result;
+}
+
+/* Starting point above the root of non-negative integer
+   for Newton's method estimated by the top bits of the integer
+   (like `int64_root` does), so the method needs only a few steps
+   even for degrees comparable with the bit length of the integer.
+   Sets `is_floored` if the estimate bounds already agree on the floor,
+   which is usual for small roots of high degrees
+   and saves computing powers of the size of the integer.
+   Falls back to the power of two above the root
+   if the estimate turns out to be below it. */
+static PyObject* Long_root_seed(PyObject* value, size_t bits_count,
+                                long long degree, PyObject* degree_object,
+                                int* is_floored) {
+  long long top_shift = bits_count > DBL_MANT_DIG
+                            ? (long long)(bits_count - DBL_MANT_DIG)
+                            : 0;
+  PyObject* top = Long_shift(value, -top_shift);
+  if (top == NULL) return NULL;
+  double top_value = PyLong_AsDouble(top);
+  Py_DECREF(top);
+  if (top_value == -1.0 && PyErr_Occurred()) return NULL;
+  double root_log2 = (log2(top_value) + (double)top_shift) / (double)degree;
+  double exponent = floor(root_log2), mantissa = exp2(root_log2 - exponent);
+  /* error of the logarithm grows with its magnitude,
+     so the relative margin of the root does too */
+  double margin = ldexp(root_log2 + 2.0, 4 - DBL_MANT_DIG);
+  *is_floored = 0;
+  if (exponent < DBL_MANT_DIG - 1) {
+    double lower_bound = floor(ldexp(mantissa * (1.0 - margin), (int)exponent)),
+           upper_bound = floor(ldexp(mantissa * (1.0 + margin), (int)exponent));
+    if (lower_bound == upper_bound) {
+      *is_floored = 1;
+      return PyLong_FromDouble(lower_bound);
     }
-  } else {
-    PyObject* float_exponent =
-        PyNumber_TrueDivide(exponent->numerator, exponent->denominator);
-    if (float_exponent == NULL) return NULL;
-    PyObject* result = PyNumber_Power(self, float_exponent, Py_None);
-    Py_DECREF(float_exponent);
+  }
+  long long mantissa_exponent = exponent < DBL_MANT_DIG - 1
+                                    ? (long long)exponent
+                                    : DBL_MANT_DIG - 1;
+  PyObject* result = PyLong_FromDouble(
+      ceil(ldexp(mantissa * (1.0 + margin), (int)mantissa_exponent)) + 1.0);
+  if (result == NULL) return NULL;
+  Py_SETREF(result,
+            Long_shift(result, (long long)exponent - mantissa_exponent));
+  if (result == NULL) return NULL;
+  PyObject* power = PyNumber_Power(result, degree_object, Py_None);
+  if (power == NULL) {
+    Py_DECREF(result);
+    return NULL;
+  }
+  int is_above = PyObject_RichCompareBool(power, value, Py_GT);
+  Py_DECREF(power);
+  if (is_above) {
+    if (is_above < 0) Py_CLEAR(result);
     return result;
   }
+  Py_DECREF(result);
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) return NULL;
+  result = Long_shift(one, (long long)((bits_count - 1) / (size_t)degree + 1));
+  Py_DECREF(one);
+  return result;
 }
 
-static PyObject* Fractions_components_positive_Long_power(PyObject* numerator,
-                                                          PyObject* denominator,
-                                                          PyObject* exponent) {
-  int comparison_signal = is_unit_py_object_bool(denominator);
-  if (comparison_signal < 0)
-    return NULL;
-  else if (comparison_signal) {
-    PyObject* result_numerator = PyNumber_Power(numerator, exponent, Py_None);
-    if (result_numerator == NULL) return NULL;
-    PyObject* result_denominator = PyLong_FromLong(1);
-    if (result_denominator == NULL) {
-      Py_DECREF(result_numerator);
-      return NULL;
+/* Floored root of non-negative integer by Newton's method
+   starting from an estimate above the root. */
+static PyObject* Long_root(PyObject* value, long long degree) {
+  long long small_value;
+  int signal = Long_to_int64(value, &small_value);
+  if (signal < 0) return NULL;
+  if (signal) return PyLong_FromLongLong(int64_root(small_value, degree));
+  size_t bits_count = _PyLong_NumBits(value);
+  if (bits_count == (size_t)-1 && PyErr_Occurred()) return NULL;
+  if ((unsigned long long)degree >= bits_count) return PyLong_FromLong(1);
+  PyObject *degree_object = PyLong_FromLongLong(degree),
+           *previous_degree_object = PyLong_FromLongLong(degree - 1),
+           *result = NULL;
+  if (degree_object == NULL || previous_degree_object == NULL) goto exit;
+  int is_floored = 0;
+  result =
+      Long_root_seed(value, bits_count, degree, degree_object, &is_floored);
+  if (is_floored) goto exit;
+  while (result != NULL) {
+    PyObject* power = PyNumber_Power(result, previous_degree_object, Py_None);
+    if (power == NULL) goto error;
+    PyObject* quotient = PyNumber_FloorDivide(value, power);
+    Py_DECREF(power);
+    if (quotient == NULL) goto error;
+    PyObject* tmp = PyNumber_Multiply(result, previous_degree_object);
+    if (tmp == NULL) {
+      Py_DECREF(quotient);
+      goto error;
     }
-    return (PyObject*)construct_fraction(&FractionType, result_numerator,
-                                         result_denominator);
-  } else {
-    PyObject* result_numerator = PyNumber_Power(numerator, exponent, Py_None);
-    if (result_numerator == NULL) return NULL;
-    PyObject* result_denominator =
-        PyNumber_Power(denominator, exponent, Py_None);
-    if (result_denominator == NULL) {
-      Py_DECREF(result_numerator);
-      return NULL;
+    PyObject* sum = PyNumber_Add(tmp, quotient);
+    Py_DECREF(tmp);
+    Py_DECREF(quotient);
+    if (sum == NULL) goto error;
+    PyObject* candidate = PyNumber_FloorDivide(sum, degree_object);
+    Py_DECREF(sum);
+    if (candidate == NULL) goto error;
+    int is_converged = PyObject_RichCompareBool(candidate, result, Py_GE);
+    if (is_converged != 0) {
+      Py_DECREF(candidate);
+      if (is_converged < 0) goto error;
+      break;
+    }
+    Py_SETREF(result, candidate);
+  }
+  goto exit;
+error:
+  Py_CLEAR(result);
+exit:
+  Py_XDECREF(previous_degree_object);
+  Py_XDECREF(degree_object);
+  return result;
+}
+
+/* Exact root of non-negative integer,
+   residues modulo 64 and 63 reject most of non-powers
+   before running Newton's method.
+   Returns 0 if there is no such root. */
+static int Long_exact_root(PyObject* value, long long degree,
+                           PyObject** result) {
+  long long small_value;
+  int signal = Long_to_int64(value, &small_value);
+  if (signal < 0) return -1;
+  if (signal) {
+    long long power, root = int64_root(small_value, degree);
+    if (!int64_power(root, degree, &power) || power != small_value) return 0;
+    *result = PyLong_FromLongLong(root);
+    return *result == NULL ? -1 : 1;
+  }
+  unsigned long long low_digits = PyLong_AsUnsignedLongLongMask(value);
+  if (low_digits == (unsigned long long)-1 && PyErr_Occurred()) return -1;
+  if (low_digits != 0) {
+    long long trailing_zeros_count = 0;
+    while (!((low_digits >> trailing_zeros_count) & 1)) ++trailing_zeros_count;
+    if (trailing_zeros_count % degree != 0) return 0;
+  }
+  if (!uint64_is_power_residue(low_digits & 63, degree, 64)) return 0;
+  PyObject* modulus = PyLong_FromLong(63);
+  if (modulus == NULL) return -1;
+  PyObject* residue = PyNumber_Remainder(value, modulus);
+  Py_DECREF(modulus);
+  if (residue == NULL) return -1;
+  unsigned long long small_residue = PyLong_AsUnsignedLongLongMask(residue);
+  Py_DECREF(residue);
+  if (!uint64_is_power_residue(small_residue, degree, 63)) return 0;
+  PyObject* root = Long_root(value, degree);
+  if (root == NULL) return -1;
+  PyObject* degree_object = PyLong_FromLongLong(degree);
+  if (degree_object == NULL) {
+    Py_DECREF(root);
+    return -1;
+  }
+  PyObject* power = PyNumber_Power(root, degree_object, Py_None);
+  Py_DECREF(degree_object);
+  if (power == NULL) {
+    Py_DECREF(root);
+    return -1;
+  }
+  int is_exact = PyObject_RichCompareBool(power, value, Py_EQ);
+  Py_DECREF(power);
+  if (is_exact <= 0) {
+    Py_DECREF(root);
+    return is_exact;
+  }
+  *result = root;
+  return 1;
+}
+
+/* Raises an integer to a non-negative integer power,
+   bases of at most unit modulus are handled without multiplications
+   and word-sized results are computed on machine words,
+   the result is always an exact integer even for `bool` & `int` subclasses. */
+static PyObject* Long_power(PyObject* base, PyObject* exponent) {
+  long long small_base, small_exponent;
+  int is_small_base = Long_to_int64(base, &small_base);
+  if (is_small_base < 0) return NULL;
+  int is_small_exponent = Long_to_int64(exponent, &small_exponent);
+  if (is_small_exponent < 0) return NULL;
+  if (is_small_exponent && small_exponent <= 1) {
+    if (small_exponent == 0) return PyLong_FromLong(1);
+    if (is_small_base) return PyLong_FromLongLong(small_base);
+    if (!PyLong_CheckExact(base)) return PyNumber_Index(base);
+    Py_INCREF(base);
+    return base;
+  }
+  if (is_small_base) {
+    if (small_base == 0 || small_base == 1) {
+      return PyLong_FromLongLong(small_base);
+    } else if (small_base == -1) {
+      unsigned long long exponent_mask =
+          PyLong_AsUnsignedLongLongMask(exponent);
+      if (exponent_mask == (unsigned long long)-1 && PyErr_Occurred())
+        return NULL;
+      return PyLong_FromLong((exponent_mask & 1) ? -1 : 1);
     }
-    return (PyObject*)construct_fraction(&FractionType, result_numerator,
-                                         result_denominator);
+    long long result;
+    if (is_small_exponent && int64_power(small_base, small_exponent, &result))
+      return PyLong_FromLongLong(result);
   }
+  return PyNumber_Power(base, exponent, Py_None);
 }
 
-static PyObject* fraction_components_Long_power(PyObject* numerator,
+/* Raises fraction components to an integer power,
+   since powers of coprime integers stay coprime
+   the result needs no normalization. */
+static PyObject* fraction_components_Long_power(PyTypeObject* cls,
+                                                PyObject* numerator,
                                                 PyObject* denominator,
                                                 PyObject* exponent) {
-  int comparison_signal = is_negative_py_object(exponent);
-  if (comparison_signal < 0)
-    return NULL;
-  else if (comparison_signal) {
+  int is_exponent_negative = is_negative_py_object(exponent);
+  if (is_exponent_negative < 0) return NULL;
+  PyObject *base_denominator, *base_numerator, *positive_exponent;
+  int is_result_negative = 0;
+  if (is_exponent_negative) {
+    int is_numerator_negative = is_negative_py_object(numerator);
+    if (is_numerator_negative < 0) return NULL;
     if (PyObject_Not(numerator)) {
       PyErr_SetString(PyExc_ZeroDivisionError,
                       "Either exponent should be non-negative "
                       "or base should not be zero.");
       return NULL;
     }
-    PyObject* positive_exponent = PyNumber_Negative(exponent);
+    positive_exponent = PyNumber_Negative(exponent);
     if (positive_exponent == NULL) return NULL;
+    if (is_numerator_negative) {
+      unsigned long long exponent_mask =
+          PyLong_AsUnsignedLongLongMask(positive_exponent);
+      if (exponent_mask == (unsigned long long)-1 && PyErr_Occurred()) {
+        Py_DECREF(positive_exponent);
+        return NULL;
+      }
+      is_result_negative = (int)(exponent_mask & 1);
+      base_denominator = PyNumber_Negative(numerator);
+      if (base_denominator == NULL) {
+        Py_DECREF(positive_exponent);
+        return NULL;
+      }
+    } else {
+      Py_INCREF(numerator);
+      base_denominator = numerator;
+    }
+    Py_INCREF(denominator);
+    base_numerator = denominator;
+  } else {
     Py_INCREF(denominator);
-    PyObject* inverted_numerator = denominator;
+    base_denominator = denominator;
     Py_INCREF(numerator);
-    PyObject* inverted_denominator = numerator;
-    if (normalize_fraction_components_signs(&inverted_numerator,
-                                            &inverted_denominator) < 0) {
-      Py_DECREF(positive_exponent);
+    base_numerator = numerator;
+    Py_INCREF(exponent);
+    positive_exponent = exponent;
+  }
+  PyObject* result_numerator = Long_power(base_numerator, positive_exponent);
+  Py_DECREF(base_numerator);
+  if (result_numerator == NULL) {
+    Py_DECREF(base_denominator);
+    Py_DECREF(positive_exponent);
+    return NULL;
+  }
+  PyObject* result_denominator =
+      Long_power(base_denominator, positive_exponent);
+  Py_DECREF(base_denominator);
+  Py_DECREF(positive_exponent);
+  if (result_denominator == NULL) {
+    Py_DECREF(result_numerator);
+    return NULL;
+  }
+  if (is_result_negative) {
+    PyObject* tmp = result_numerator;
+    result_numerator = PyNumber_Negative(result_numerator);
+    Py_DECREF(tmp);
+    if (result_numerator == NULL) {
+      Py_DECREF(result_denominator);
       return NULL;
     }
-    PyObject* result = Fractions_components_positive_Long_power(
-        inverted_numerator, inverted_denominator, positive_exponent);
-    Py_DECREF(inverted_denominator);
-    Py_DECREF(inverted_numerator);
-    Py_DECREF(positive_exponent);
+  }
+  return (PyObject*)construct_fraction(cls, result_numerator,
+                                       result_denominator);
+}
+
+/* Raises non-negative fraction components to a non-integral power
+   if both of them are perfect powers of the exponent denominator,
+   returns 0 otherwise. */
+static int Fractions_components_exact_power(PyTypeObject* cls,
+                                            PyObject* numerator,
+                                            PyObject* denominator,
+                                            PyObject* exponent_numerator,
+                                            PyObject* exponent_denominator,
+                                            PyObject** result) {
+  int is_numerator_negative = is_negative_py_object(numerator);
+  if (is_numerator_negative != 0) return is_numerator_negative < 0 ? -1 : 0;
+  long long degree;
+  int signal = Long_to_int64(exponent_denominator, &degree);
+  if (signal < 0) return -1;
+  /* only 0 and 1 are powers of such large degrees,
+     so any larger degree works the same */
+  if (!signal) degree = LLONG_MAX;
+  PyObject *root_denominator, *root_numerator;
+  signal = Long_exact_root(numerator, degree, &root_numerator);
+  if (signal <= 0) return signal;
+  signal = Long_exact_root(denominator, degree, &root_denominator);
+  if (signal <= 0) {
+    Py_DECREF(root_numerator);
+    return signal;
+  }
+  *result = fraction_components_Long_power(
+      cls, root_numerator, root_denominator, exponent_numerator);
+  Py_DECREF(root_denominator);
+  Py_DECREF(root_numerator);
+  return *result == NULL ? -1 : 1;
+}
+
+static PyObject* Long_fraction_power(PyObject* self, FractionObject* exponent) {
+  PyTypeObject* cls = Py_TYPE(exponent);
+  int comparison_signal = is_integral_fraction(exponent);
+  if (comparison_signal < 0)
+    return NULL;
+  else if (comparison_signal) {
+    PyObject* one = PyLong_FromLong(1);
+    if (one == NULL) return NULL;
+    PyObject* result =
+        fraction_components_Long_power(cls, self, one, exponent->numerator);
+    Py_DECREF(one);
+    return result;
+  } else {
+    PyObject* one = PyLong_FromLong(1);
+    if (one == NULL) return NULL;
+    PyObject* result;
+    int signal = Fractions_components_exact_power(
+        cls, self, one, exponent->numerator, exponent->denominator, &result);
+    Py_DECREF(one);
+    if (signal < 0)
+      return NULL;
+    else if (signal)
+      return result;
+    PyObject* float_exponent =
+        PyNumber_TrueDivide(exponent->numerator, exponent->denominator);
+    if (float_exponent == NULL) return NULL;
+    result = PyNumber_Power(self, float_exponent, Py_None);
+    Py_DECREF(float_exponent);
     return result;
   }
-  return Fractions_components_positive_Long_power(numerator, denominator,
-                                                  exponent);
 }
 
 static PyObject* Float_fraction_components_power(
@@ -1729,7 +2898,8 @@ static PyObject* Float_fraction_power(PyObject* self,
                                          exponent->denominator);
 }
 
-static PyObject* Fractions_components_power(PyObject* numerator,
+static PyObject* Fractions_components_power(PyTypeObject* cls,
+                                            PyObject* numerator,
                                             PyObject* denominator,
                                             PyObject* exponent_numerator,
                                             PyObject* exponent_denominator) {
@@ -1737,12 +2907,20 @@ static PyObject* Fractions_components_power(PyObject* numerator,
   if (is_integral_exponent < 0)
     return NULL;
   else if (is_integral_exponent)
-    return fraction_components_Long_power(numerator, denominator,
+    return fraction_components_Long_power(cls, numerator, denominator,
                                           exponent_numerator);
   else {
+    PyObject* result;
+    int signal = Fractions_components_exact_power(
+        cls, numerator, denominator, exponent_numerator, exponent_denominator,
+        &result);
+    if (signal < 0)
+      return NULL;
+    else if (signal)
+      return result;
     PyObject* float_self = PyNumber_TrueDivide(numerator, denominator);
     if (float_self == NULL) return NULL;
-    PyObject* result = Float_fraction_components_power(
+    result = Float_fraction_components_power(
         float_self, exponent_numerator, exponent_denominator);
     Py_DECREF(float_self);
     return result;
@@ -1751,13 +2929,14 @@ static PyObject* Fractions_components_power(PyObject* numerator,
 
 static PyObject* Fractions_power(FractionObject* self,
                                  FractionObject* exponent) {
-  return Fractions_components_power(self->numerator, self->denominator,
-                                    exponent->numerator, exponent->denominator);
+  return Fractions_components_power(Py_TYPE(self), self->numerator,
+                                    self->denominator, exponent->numerator,
+                                    exponent->denominator);
 }
 
 static PyObject* fraction_Long_power(FractionObject* self, PyObject* exponent) {
-  return fraction_components_Long_power(self->numerator, self->denominator,
-                                        exponent);
+  return fraction_components_Long_power(Py_TYPE(self), self->numerator,
+                                        self->denominator, exponent);
 }
 
 static PyObject* fraction_Rational_power(FractionObject* self,
@@ -1766,9 +2945,9 @@ static PyObject* fraction_Rational_power(FractionObject* self,
   if (parse_fraction_components_from_rational(exponent, &exponent_numerator,
                                               &exponent_denominator) < 0)
     return NULL;
-  PyObject* result =
-      Fractions_components_power(self->numerator, self->denominator,
-                                 exponent_numerator, exponent_denominator);
+  PyObject* result = Fractions_components_power(
+      Py_TYPE(self), self->numerator, self->denominator, exponent_numerator,
+      exponent_denominator);
   Py_DECREF(exponent_denominator);
   Py_DECREF(exponent_numerator);
   return result;
@@ -1781,7 +2960,8 @@ static PyObject* Rational_fraction_power(PyObject* self,
       0)
     return NULL;
   PyObject* result = Fractions_components_power(
-      numerator, denominator, exponent->numerator, exponent->denominator);
+      Py_TYPE(exponent), numerator, denominator, exponent->numerator,
+      exponent->denominator);
   Py_DECREF(denominator);
   Py_DECREF(numerator);
   return result;
@@ -1789,9 +2969,10 @@ static PyObject* Rational_fraction_power(PyObject* self,
 
 static PyObject* fraction_power(PyObject* self, PyObject* exponent,
                                 PyObject* modulo) {
+  STATS_COUNT_OPERATION(OPERATION_POWER, self, exponent);
   if (modulo != Py_None) {
-  } else if (PyObject_TypeCheck(self, &FractionType)) {
-    if (PyObject_TypeCheck(exponent, &FractionType))
+  } else if (is_fraction(self)) {
+    if (is_fraction(exponent))
       return Fractions_power((FractionObject*)self, (FractionObject*)exponent);
     else if (PyLong_Check(exponent))
       return fraction_Long_power((FractionObject*)self, exponent);
@@ -1801,27 +2982,27 @@ static PyObject* fraction_power(PyObject* self, PyObject* exponent,
       result = PyNumber_Power(float_self, exponent, Py_None);
       Py_DECREF(float_self);
       return result;
-    } else if (PyObject_IsInstance(exponent, Rational))
+    } else if (is_rational(Py_TYPE(self), exponent))
       return fraction_Rational_power((FractionObject*)self, exponent);
   } else {
-    assert(PyObject_TypeCheck(exponent, &FractionType) == 1);
+    assert(is_fraction(exponent) == 1);
     if (PyLong_Check(self))
       return Long_fraction_power(self, (FractionObject*)exponent);
     else if (PyFloat_Check(self))
       return Float_fraction_power(self, (FractionObject*)exponent);
-    else if (PyObject_IsInstance(self, Rational))
+    else if (is_rational(Py_TYPE(exponent), self))
       return Rational_fraction_power(self, (FractionObject*)exponent);
   }
   Py_RETURN_NOTIMPLEMENTED;
 }
 
 static FractionObject* Fractions_components_subtract(
-    PyObject* numerator, PyObject* denominator, PyObject* other_numerator,
-    PyObject* other_denominator) {
-  PyObject* numerator_minuend = PyNumber_Multiply(numerator, other_denominator);
+    PyTypeObject* cls, PyObject* numerator, PyObject* denominator,
+    PyObject* other_numerator, PyObject* other_denominator) {
+  PyObject* numerator_minuend = Longs_multiply(numerator, other_denominator);
   if (numerator_minuend == NULL) return NULL;
   PyObject* numerator_subtrahend =
-      PyNumber_Multiply(other_numerator, denominator);
+      Longs_multiply(other_numerator, denominator);
   if (numerator_subtrahend == NULL) {
     Py_DECREF(numerator_minuend);
     return NULL;
@@ -1832,7 +3013,7 @@ static FractionObject* Fractions_components_subtract(
   Py_DECREF(numerator_minuend);
   if (result_numerator == NULL) return NULL;
   PyObject* result_denominator =
-      PyNumber_Multiply(denominator, other_denominator);
+      Longs_multiply(denominator, other_denominator);
   if (result_denominator == NULL) {
     Py_DECREF(result_numerator);
     return NULL;
@@ -1843,14 +3024,14 @@ static FractionObject* Fractions_components_subtract(
     Py_DECREF(result_numerator);
     return NULL;
   }
-  return construct_fraction(&FractionType, result_numerator,
-                            result_denominator);
+  return construct_fraction(cls, result_numerator, result_denominator);
 }
 
 static FractionObject* Fractions_subtract(FractionObject* self,
                                           FractionObject* other) {
-  return Fractions_components_subtract(self->numerator, self->denominator,
-                                       other->numerator, other->denominator);
+  return Fractions_components_subtract(Py_TYPE(self), self->numerator,
+                                       self->denominator, other->numerator,
+                                       other->denominator);
 }
 
 static PyObject* fraction_Float_subtract(FractionObject* self,
@@ -1864,7 +3045,7 @@ static PyObject* fraction_Float_subtract(FractionObject* self,
 
 static FractionObject* fraction_Long_subtract(FractionObject* self,
                                               PyObject* other) {
-  PyObject* tmp = PyNumber_Multiply(other, self->denominator);
+  PyObject* tmp = Longs_multiply(other, self->denominator);
   if (tmp == NULL) return NULL;
   PyObject* result_numerator = PyNumber_Subtract(self->numerator, tmp);
   Py_DECREF(tmp);
@@ -1875,7 +3056,7 @@ static FractionObject* fraction_Long_subtract(FractionObject* self,
     Py_DECREF(result_denominator);
     Py_DECREF(result_numerator);
   }
-  return construct_fraction(&FractionType, result_numerator,
+  return construct_fraction(Py_TYPE(self), result_numerator,
                             result_denominator);
 }
 
@@ -1886,22 +3067,24 @@ static FractionObject* fraction_Rational_subtract(FractionObject* self,
                                               &other_denominator) < 0)
     return NULL;
   FractionObject* result = Fractions_components_subtract(
-      self->numerator, self->denominator, other_numerator, other_denominator);
+      Py_TYPE(self), self->numerator, self->denominator, other_numerator,
+      other_denominator);
   Py_DECREF(other_denominator);
   Py_DECREF(other_numerator);
   return result;
 }
 
-static PyObject* fraction_subtract(PyObject* self, PyObject* other) {
-  if (PyObject_TypeCheck(self, &FractionType)) {
-    if (PyObject_TypeCheck(other, &FractionType))
+static PyObject* fraction_subtract_exact(PyObject* self, PyObject* other) {
+  STATS_COUNT_OPERATION(OPERATION_SUBTRACT, self, other);
+  if (is_fraction(self)) {
+    if (is_fraction(other))
       return (PyObject*)Fractions_subtract((FractionObject*)self,
                                            (FractionObject*)other);
     else if (PyLong_Check(other))
       return (PyObject*)fraction_Long_subtract((FractionObject*)self, other);
     else if (PyFloat_Check(other))
       return (PyObject*)fraction_Float_subtract((FractionObject*)self, other);
-    else if (PyObject_IsInstance(other, Rational))
+    else if (is_rational(Py_TYPE(self), other))
       return (PyObject*)fraction_Rational_subtract((FractionObject*)self,
                                                    other);
   } else if (PyLong_Check(self)) {
@@ -1919,7 +3102,7 @@ static PyObject* fraction_subtract(PyObject* self, PyObject* other) {
     PyObject* result = PyNumber_Negative(tmp);
     Py_DECREF(tmp);
     return result;
-  } else if (PyObject_IsInstance(self, Rational)) {
+  } else if (is_rational(Py_TYPE(other), self)) {
     FractionObject* result =
         fraction_Rational_subtract((FractionObject*)other, self);
     if (result == NULL) return NULL;
@@ -1931,20 +3114,82 @@ static PyObject* fraction_subtract(PyObject* self, PyObject* other) {
   Py_RETURN_NOTIMPLEMENTED;
 }
 
-static FractionObject* fraction_limit_denominator_impl(
-    FractionObject* self, PyObject* max_denominator) {
+static int validate_max_denominator(PyObject* max_denominator) {
   PyObject* tmp = PyLong_FromLong(1);
-  if (tmp == NULL) return NULL;
+  if (tmp == NULL) return -1;
   int comparison_signal = PyObject_RichCompareBool(max_denominator, tmp, Py_LT);
   Py_DECREF(tmp);
   if (comparison_signal < 0)
-    return NULL;
+    return -1;
   else if (comparison_signal) {
     PyErr_SetString(PyExc_ValueError,
                     "`max_denominator` should not be less than 1.");
-    return NULL;
+    return -1;
+  }
+  return 0;
+}
+
+/* Continued-fraction loop of `fraction_limit_denominator_impl`
+   on machine words, returns 0 if some term does not fit. */
+static int int64_limit_denominator(long long numerator, long long denominator,
+                                   long long max_denominator,
+                                   long long* result_numerator,
+                                   long long* result_denominator) {
+  long long first_bound_numerator = 0, first_bound_denominator = 1,
+            second_bound_numerator = 1, second_bound_denominator = 0;
+  while (1) {
+    long long quotient, remainder;
+    int64_floor_divmod(numerator, denominator, &quotient, &remainder);
+    /* denominators are non-negative, so overflow means exceeding the bound */
+    long long candidate_denominator;
+    if (!int64_multiply(quotient, second_bound_denominator,
+                        &candidate_denominator) ||
+        !int64_add(first_bound_denominator, candidate_denominator,
+                   &candidate_denominator) ||
+        candidate_denominator > max_denominator)
+      break;
+    long long candidate_numerator;
+    if (!int64_multiply(quotient, second_bound_numerator,
+                        &candidate_numerator) ||
+        !int64_add(first_bound_numerator, candidate_numerator,
+                   &candidate_numerator))
+      return 0;
+    first_bound_numerator = second_bound_numerator;
+    first_bound_denominator = second_bound_denominator;
+    second_bound_numerator = candidate_numerator;
+    second_bound_denominator = candidate_denominator;
+    numerator = denominator;
+    denominator = remainder;
+  }
+  long long scale =
+      (max_denominator - first_bound_denominator) / second_bound_denominator;
+  long long scaled_numerator;
+  if (!int64_multiply(scale, second_bound_numerator, &scaled_numerator) ||
+      !int64_add(first_bound_numerator, scaled_numerator, &scaled_numerator))
+    return 0;
+  /* with `t = numerator / denominator` being the remaining complete quotient
+     the second bound is not farther from the value than the first one
+     iff `q0 + 2 * k * q1 <= q1 * t` */
+  if (uint64_products_less_equal(
+          (unsigned long long)denominator,
+          (unsigned long long)first_bound_denominator +
+              2ULL * (unsigned long long)scale *
+                  (unsigned long long)second_bound_denominator,
+          (unsigned long long)second_bound_denominator,
+          (unsigned long long)numerator)) {
+    *result_numerator = second_bound_numerator;
+    *result_denominator = second_bound_denominator;
+  } else {
+    *result_numerator = scaled_numerator;
+    *result_denominator =
+        first_bound_denominator + scale * second_bound_denominator;
   }
-  comparison_signal =
+  return 1;
+}
+
+static FractionObject* fraction_limit_denominator_impl(
+    FractionObject* self, PyObject* max_denominator) {
+  int comparison_signal =
       PyObject_RichCompareBool(self->denominator, max_denominator, Py_LE);
   if (comparison_signal < 0)
     return NULL;
@@ -1952,6 +3197,22 @@ static FractionObject* fraction_limit_denominator_impl(
     Py_INCREF(self);
     return self;
   }
+  if (PyLong_Check(max_denominator)) {
+    long long small_numerator, small_denominator, small_max_denominator,
+        result_numerator, result_denominator;
+    int signal;
+    if ((signal = Long_to_int64(self->numerator, &small_numerator)) > 0 &&
+        (signal = Long_to_int64(self->denominator, &small_denominator)) > 0 &&
+        (signal = Long_to_int64(max_denominator, &small_max_denominator)) >
+            0 &&
+        int64_limit_denominator(small_numerator, small_denominator,
+                                small_max_denominator, &result_numerator,
+                                &result_denominator))
+      return construct_fraction_from_small_components(
+          Py_TYPE(self), result_numerator, result_denominator);
+    if (signal < 0) return NULL;
+  }
+  PyObject* tmp;
   PyObject *denominator = self->denominator, *numerator = self->numerator;
   Py_INCREF(denominator);
   Py_INCREF(numerator);
@@ -1998,6 +3259,7 @@ static FractionObject* fraction_limit_denominator_impl(
       Py_DECREF(quotient);
       goto loop_error;
     }
+    Py_DECREF(numerator);
     numerator = denominator;
     denominator = other_tmp;
     Py_DECREF(first_bound_denominator);
@@ -2009,6 +3271,7 @@ static FractionObject* fraction_limit_denominator_impl(
     other_tmp = PyNumber_Add(first_bound_numerator, tmp);
     Py_DECREF(tmp);
     if (other_tmp == NULL) goto loop_error;
+    Py_DECREF(first_bound_numerator);
     first_bound_numerator = second_bound_numerator;
     second_bound_numerator = other_tmp;
   }
@@ -2033,27 +3296,22 @@ static FractionObject* fraction_limit_denominator_impl(
   Py_DECREF(first_bound_numerator);
   first_bound_numerator = other_tmp;
   tmp = PyNumber_Multiply(scale, second_bound_denominator);
-  if (tmp == NULL) {
-    Py_DECREF(scale);
-    goto error;
-  }
+  Py_DECREF(scale);
+  if (tmp == NULL) goto error;
   other_tmp = PyNumber_Add(first_bound_denominator, tmp);
   Py_DECREF(tmp);
-  if (other_tmp == NULL) {
-    Py_DECREF(scale);
-    goto error;
-  }
+  if (other_tmp == NULL) goto error;
   Py_DECREF(first_bound_denominator);
   first_bound_denominator = other_tmp;
   FractionObject* first_bound = construct_fraction(
-      &FractionType, first_bound_numerator, first_bound_denominator);
+      Py_TYPE(self), first_bound_numerator, first_bound_denominator);
   if (first_bound == NULL) {
     Py_DECREF(second_bound_denominator);
     Py_DECREF(second_bound_numerator);
     return NULL;
   };
   FractionObject* second_bound = construct_fraction(
-      &FractionType, second_bound_numerator, second_bound_denominator);
+      Py_TYPE(self), second_bound_numerator, second_bound_denominator);
   if (second_bound == NULL) {
     Py_DECREF(first_bound);
     return NULL;
@@ -2124,77 +3382,977 @@ static PyObject* fraction_limit_denominator(FractionObject* self,
         (PyObject*)fraction_limit_denominator_impl(self, max_denominator);
     Py_DECREF(max_denominator);
     return result;
-  } else
-    return (PyObject*)fraction_limit_denominator_impl(self, max_denominator);
+  } else if (validate_max_denominator(max_denominator) < 0)
+    return NULL;
+  return (PyObject*)fraction_limit_denominator_impl(self, max_denominator);
 }
 
-static FractionObject* Fractions_components_true_divide(
-    PyObject* numerator, PyObject* denominator, PyObject* other_numerator,
-    PyObject* other_denominator) {
-  if (PyObject_Not(other_numerator)) {
-    PyErr_Format(PyExc_ZeroDivisionError, "Fraction(%S, 0)", numerator);
-    return NULL;
-  }
-  PyObject* gcd = _PyLong_GCD(numerator, other_numerator);
-  if (gcd == NULL) return NULL;
-  numerator = PyNumber_FloorDivide(numerator, gcd);
-  if (numerator == NULL) {
-    Py_DECREF(gcd);
-    return NULL;
+static PyObject* Longs_multiply_add(PyObject* first, PyObject* second,
+                                    PyObject* addend) {
+  PyObject* product = PyNumber_Multiply(first, second);
+  if (product == NULL) return NULL;
+  PyObject* result = PyNumber_Add(product, addend);
+  Py_DECREF(product);
+  return result;
+}
+
+/* State of the Euclidean algorithm over fraction components,
+   kept on machine words while they fit. */
+typedef struct {
+  PyObject* numerator; /* `NULL` while components are small */
+  PyObject* denominator;
+  long long small_numerator;
+  long long small_denominator;
+} EuclidState;
+
+static void euclid_state_clear(EuclidState* self) {
+  Py_CLEAR(self->numerator);
+  Py_CLEAR(self->denominator);
+}
+
+static int euclid_state_init(EuclidState* self, PyObject* numerator,
+                             PyObject* denominator) {
+  self->numerator = self->denominator = NULL;
+  int signal;
+  if ((signal = Long_to_int64(numerator, &self->small_numerator)) > 0 &&
+      (signal = Long_to_int64(denominator, &self->small_denominator)) > 0)
+    return 0;
+  if (signal < 0) return -1;
+  Py_INCREF(numerator);
+  self->numerator = numerator;
+  Py_INCREF(denominator);
+  self->denominator = denominator;
+  return 0;
+}
+
+/* Produces the next partial quotient either in `small_term`
+   (with `term` set to `NULL`) or in `term`,
+   returns 0 if the expansion is exhausted. */
+static int euclid_state_next(EuclidState* self, long long* small_term,
+                             PyObject** term) {
+  if (self->numerator == NULL) {
+    if (self->small_denominator == 0) return 0;
+    long long remainder;
+    int64_floor_divmod(self->small_numerator, self->small_denominator,
+                       small_term, &remainder);
+    self->small_numerator = self->small_denominator;
+    self->small_denominator = remainder;
+    *term = NULL;
+    return 1;
   }
-  other_numerator = PyNumber_FloorDivide(other_numerator, gcd);
-  Py_DECREF(gcd);
-  if (other_numerator == NULL) {
-    Py_DECREF(numerator);
-    return NULL;
+  PyObject *quotient, *remainder;
+  if (Longs_divmod(self->numerator, self->denominator, &quotient,
+                   &remainder) < 0)
+    return -1;
+  Py_DECREF(self->numerator);
+  self->numerator = self->denominator;
+  self->denominator = remainder;
+  long long small_numerator, small_denominator;
+  int signal;
+  if ((signal = Long_to_int64(self->numerator, &small_numerator)) > 0 &&
+      (signal = Long_to_int64(self->denominator, &small_denominator)) > 0) {
+    euclid_state_clear(self);
+    self->small_numerator = small_numerator;
+    self->small_denominator = small_denominator;
+  } else if (signal < 0) {
+    Py_DECREF(quotient);
+    return -1;
   }
-  gcd = _PyLong_GCD(denominator, other_denominator);
-  if (gcd == NULL) return NULL;
-  denominator = PyNumber_FloorDivide(denominator, gcd);
+  *term = quotient;
+  return 1;
+}
+
+/* Convergents are laid out as previous numerator & denominator
+   followed by current ones, appending a partial quotient shifts them. */
+static int int64_convergents_append(long long convergents[4],
+                                    long long term) {
+  long long numerator, denominator;
+  if (!int64_multiply(term, convergents[2], &numerator) ||
+      !int64_add(numerator, convergents[0], &numerator) ||
+      !int64_multiply(term, convergents[3], &denominator) ||
+      !int64_add(denominator, convergents[1], &denominator))
+    return 0;
+  convergents[0] = convergents[2];
+  convergents[1] = convergents[3];
+  convergents[2] = numerator;
+  convergents[3] = denominator;
+  return 1;
+}
+
+static int Longs_convergents_append(PyObject* convergents[4], PyObject* term) {
+  PyObject* numerator =
+      Longs_multiply_add(term, convergents[2], convergents[0]);
+  if (numerator == NULL) return -1;
+  PyObject* denominator =
+      Longs_multiply_add(term, convergents[3], convergents[1]);
   if (denominator == NULL) {
-    Py_DECREF(gcd);
-    Py_DECREF(other_numerator);
-    Py_DECREF(numerator);
-    return NULL;
-  }
-  other_denominator = PyNumber_FloorDivide(other_denominator, gcd);
-  Py_DECREF(gcd);
-  if (other_denominator == NULL) {
-    Py_DECREF(denominator);
-    Py_DECREF(other_numerator);
     Py_DECREF(numerator);
-    return NULL;
+    return -1;
   }
-  PyObject* result_numerator = PyNumber_Multiply(numerator, other_denominator);
-  Py_DECREF(other_denominator);
-  Py_DECREF(numerator);
-  if (result_numerator == NULL) {
-    Py_DECREF(other_numerator);
-    Py_DECREF(denominator);
-    return NULL;
+  Py_DECREF(convergents[0]);
+  Py_DECREF(convergents[1]);
+  convergents[0] = convergents[2];
+  convergents[1] = convergents[3];
+  convergents[2] = numerator;
+  convergents[3] = denominator;
+  return 0;
+}
+
+typedef struct {
+  PyObject_HEAD EuclidState euclid;
+  /* `convergents` are `NULL` while the values are small */
+  PyObject* convergents[4];
+  long long small_convergents[4];
+} ContinuedFractionIteratorObject;
+
+static void continued_fraction_iterator_dealloc(
+    ContinuedFractionIteratorObject* self) {
+  euclid_state_clear(&self->euclid);
+  for (size_t index = 0; index < 4; ++index)
+    Py_XDECREF(self->convergents[index]);
+  PyTypeObject* type = Py_TYPE(self);
+  type->tp_free((PyObject*)self);
+  Py_DECREF(type);
+}
+
+static PyObject* continued_fraction_iterator_new(PyTypeObject* cls,
+                                                 FractionObject* fraction) {
+  ContinuedFractionIteratorObject* result =
+      PyObject_New(ContinuedFractionIteratorObject, cls);
+  if (result == NULL) return NULL;
+  static const long long initial_convergents[4] = {0, 1, 1, 0};
+  for (size_t index = 0; index < 4; ++index) {
+    result->convergents[index] = NULL;
+    result->small_convergents[index] = initial_convergents[index];
   }
-  PyObject* result_denominator =
-      PyNumber_Multiply(denominator, other_numerator);
-  Py_DECREF(other_numerator);
-  Py_DECREF(denominator);
-  if (result_denominator == NULL) {
-    Py_DECREF(result_numerator);
+  if (euclid_state_init(&result->euclid, fraction->numerator,
+                        fraction->denominator) < 0) {
+    Py_DECREF(result);
     return NULL;
   }
-  if (normalize_fraction_components_signs(&result_numerator,
-                                          &result_denominator) < 0) {
-    Py_INCREF(result_denominator);
-    Py_INCREF(result_numerator);
+  return (PyObject*)result;
+}
+
+static PyObject* continued_fraction_iterator_next(
+    ContinuedFractionIteratorObject* self) {
+  long long small_term = 0;
+  PyObject* term;
+  if (euclid_state_next(&self->euclid, &small_term, &term) <= 0) return NULL;
+  return term == NULL ? PyLong_FromLongLong(small_term) : term;
+}
+
+DEFINE_LOCKED_ITERNEXT(continued_fraction_iterator_next,
+                       ContinuedFractionIteratorObject)
+
+static PyObject* convergents_iterator_next(
+    ContinuedFractionIteratorObject* self) {
+  PyTypeObject* cls = get_type_state(Py_TYPE(self))->fraction_type;
+  long long small_term = 0;
+  PyObject* term;
+  if (euclid_state_next(&self->euclid, &small_term, &term) <= 0) return NULL;
+  PyObject** convergents = self->convergents;
+  long long* small_convergents = self->small_convergents;
+  if (convergents[0] == NULL) {
+    if (term == NULL && int64_convergents_append(small_convergents, small_term))
+      return (PyObject*)construct_fraction_from_small_components(
+          cls, small_convergents[2], small_convergents[3]);
+    for (size_t index = 0; index < 4; ++index) {
+      convergents[index] = PyLong_FromLongLong(small_convergents[index]);
+      if (convergents[index] == NULL) {
+        for (size_t offset = 0; offset < index; ++offset)
+          Py_CLEAR(convergents[offset]);
+        Py_XDECREF(term);
+        return NULL;
+      }
+    }
+  }
+  if (term == NULL) {
+    term = PyLong_FromLongLong(small_term);
+    if (term == NULL) return NULL;
+  }
+  int signal = Longs_convergents_append(convergents, term);
+  Py_DECREF(term);
+  if (signal < 0) return NULL;
+  Py_INCREF(convergents[2]);
+  Py_INCREF(convergents[3]);
+  return (PyObject*)construct_fraction(cls, convergents[2], convergents[3]);
+}
+
+DEFINE_LOCKED_ITERNEXT(convergents_iterator_next,
+                       ContinuedFractionIteratorObject)
+
+#define ITERATOR_TYPE_FLAGS                                 \
+  (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION | \
+   Py_TPFLAGS_IMMUTABLETYPE)
+
+static PyType_Slot continued_fraction_iterator_slots[] = {
+    {Py_tp_dealloc, (void*)continued_fraction_iterator_dealloc},
+    {Py_tp_iter, (void*)PyObject_SelfIter},
+    {Py_tp_iternext,
+     (void*)LOCKED_ITERNEXT(continued_fraction_iterator_next)},
+    {0, NULL},
+};
+
+static PyType_Spec continued_fraction_iterator_spec = {
+    .basicsize = sizeof(ContinuedFractionIteratorObject),
+    .flags = ITERATOR_TYPE_FLAGS,
+    .name = "cfractions.ContinuedFractionIterator",
+    .slots = continued_fraction_iterator_slots,
+};
+
+static PyType_Slot convergents_iterator_slots[] = {
+    {Py_tp_dealloc, (void*)continued_fraction_iterator_dealloc},
+    {Py_tp_iter, (void*)PyObject_SelfIter},
+    {Py_tp_iternext, (void*)LOCKED_ITERNEXT(convergents_iterator_next)},
+    {0, NULL},
+};
+
+static PyType_Spec convergents_iterator_spec = {
+    .basicsize = sizeof(ContinuedFractionIteratorObject),
+    .flags = ITERATOR_TYPE_FLAGS,
+    .name = "cfractions.ConvergentsIterator",
+    .slots = convergents_iterator_slots,
+};
+
+static PyObject* fraction_continued_fraction(FractionObject* self,
+                                             PyObject* Py_UNUSED(args)) {
+  return continued_fraction_iterator_new(
+      get_type_state(Py_TYPE(self))->continued_fraction_iterator_type, self);
+}
+
+static PyObject* fraction_convergents(FractionObject* self,
+                                      PyObject* Py_UNUSED(args)) {
+  return continued_fraction_iterator_new(
+      get_type_state(Py_TYPE(self))->convergents_iterator_type, self);
+}
+
+#define CONTINUED_FRACTION_LEAF_SIZE 16
+
+/* Continued fraction terms product is a product of `[[term, 1], [1, 0]]`
+   matrices, which are stored in row-major order. */
+static int int64_continued_fraction_terms_product(PyObject** terms,
+                                                  Py_ssize_t size,
+                                                  long long result[4]) {
+  long long matrix[4] = {1, 0, 0, 1};
+  for (Py_ssize_t index = 0; index < size; ++index) {
+    long long term, first_entry, second_entry;
+    int signal = Long_to_int64(terms[index], &term);
+    if (signal <= 0) return signal;
+    if (!int64_multiply(matrix[0], term, &first_entry) ||
+        !int64_add(first_entry, matrix[1], &first_entry) ||
+        !int64_multiply(matrix[2], term, &second_entry) ||
+        !int64_add(second_entry, matrix[3], &second_entry))
+      return 0;
+    matrix[1] = matrix[0];
+    matrix[0] = first_entry;
+    matrix[3] = matrix[2];
+    matrix[2] = second_entry;
+  }
+  for (size_t index = 0; index < 4; ++index) result[index] = matrix[index];
+  return 1;
+}
+
+static void Longs_matrix_clear(PyObject* matrix[4]) {
+  for (size_t index = 0; index < 4; ++index) Py_CLEAR(matrix[index]);
+}
+
+static int Longs_continued_fraction_terms_product(PyObject** terms,
+                                                  Py_ssize_t size,
+                                                  PyObject* result[4]) {
+  PyObject* matrix[4] = {PyLong_FromLong(1), PyLong_FromLong(0),
+                         PyLong_FromLong(0), PyLong_FromLong(1)};
+  if (matrix[0] == NULL || matrix[1] == NULL || matrix[2] == NULL ||
+      matrix[3] == NULL)
+    goto error;
+  for (Py_ssize_t index = 0; index < size; ++index) {
+    PyObject* first_entry =
+        Longs_multiply_add(matrix[0], terms[index], matrix[1]);
+    if (first_entry == NULL) goto error;
+    PyObject* second_entry =
+        Longs_multiply_add(matrix[2], terms[index], matrix[3]);
+    if (second_entry == NULL) {
+      Py_DECREF(first_entry);
+      goto error;
+    }
+    Py_SETREF(matrix[1], matrix[0]);
+    matrix[0] = first_entry;
+    Py_SETREF(matrix[3], matrix[2]);
+    matrix[2] = second_entry;
+  }
+  for (size_t index = 0; index < 4; ++index) result[index] = matrix[index];
+  return 0;
+error:
+  for (size_t index = 0; index < 4; ++index) Py_XDECREF(matrix[index]);
+  return -1;
+}
+
+static PyObject* Longs_dot_product(PyObject* first, PyObject* second,
+                                   PyObject* third, PyObject* fourth) {
+  PyObject* product = PyNumber_Multiply(third, fourth);
+  if (product == NULL) return NULL;
+  PyObject* result = Longs_multiply_add(first, second, product);
+  Py_DECREF(product);
+  return result;
+}
+
+static int Longs_matrices_multiply(PyObject* left[4], PyObject* right[4],
+                                   PyObject* result[4]) {
+  for (size_t row = 0; row < 2; ++row)
+    for (size_t column = 0; column < 2; ++column) {
+      result[2 * row + column] =
+          Longs_dot_product(left[2 * row], right[column], left[2 * row + 1],
+                            right[2 + column]);
+      if (result[2 * row + column] == NULL) {
+        for (size_t index = 0; index < 2 * row + column; ++index)
+          Py_CLEAR(result[index]);
+        return -1;
+      }
+    }
+  return 0;
+}
+
+/* Multiplies matrices of continued fraction terms as a balanced tree,
+   so operands of big multiplications have comparable sizes. */
+static int continued_fraction_terms_product(PyObject** terms, Py_ssize_t size,
+                                            PyObject* result[4]) {
+  if (size <= CONTINUED_FRACTION_LEAF_SIZE) {
+    long long small_result[4];
+    int signal =
+        int64_continued_fraction_terms_product(terms, size, small_result);
+    if (signal < 0) return -1;
+    if (!signal)
+      return Longs_continued_fraction_terms_product(terms, size, result);
+    for (size_t index = 0; index < 4; ++index) {
+      result[index] = PyLong_FromLongLong(small_result[index]);
+      if (result[index] == NULL) {
+        for (size_t offset = 0; offset < index; ++offset)
+          Py_CLEAR(result[offset]);
+        return -1;
+      }
+    }
+    return 0;
+  }
+  Py_ssize_t middle = size / 2;
+  PyObject *left[4], *right[4];
+  if (continued_fraction_terms_product(terms, middle, left) < 0) return -1;
+  if (continued_fraction_terms_product(terms + middle, size - middle, right) <
+      0) {
+    Longs_matrix_clear(left);
+    return -1;
+  }
+  int signal = Longs_matrices_multiply(left, right, result);
+  Longs_matrix_clear(left);
+  Longs_matrix_clear(right);
+  return signal;
+}
+
+static PyObject* fraction_from_continued_fraction(PyTypeObject* cls,
+                                                  PyObject* terms) {
+  PyObject* sequence =
+      sequence_fast_snapshot(terms, "Terms should be an iterable of integers.");
+  if (sequence == NULL) return NULL;
+  Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
+  PyObject** items = PySequence_Fast_ITEMS(sequence);
+  if (size == 0) {
+    PyErr_SetString(PyExc_ValueError, "Terms should not be empty.");
+    goto error;
+  }
+  for (Py_ssize_t index = 0; index < size; ++index) {
+    if (!PyLong_Check(items[index])) {
+      PyErr_Format(PyExc_TypeError, "Terms should be integers, but got %R.",
+                   items[index]);
+      goto error;
+    }
+    if (index > 0 && _PyLong_Sign(items[index]) <= 0) {
+      PyErr_Format(PyExc_ValueError,
+                   "Terms after the first one should be positive, "
+                   "but got %R.",
+                   items[index]);
+      goto error;
+    }
+  }
+  PyObject* product[4];
+  if (continued_fraction_terms_product(items, size, product) < 0) goto error;
+  Py_DECREF(sequence);
+  Py_DECREF(product[1]);
+  Py_DECREF(product[3]);
+  return (PyObject*)construct_fraction(cls, product[0], product[2]);
+error:
+  Py_DECREF(sequence);
+  return NULL;
+}
+
+/* Searches for the fraction with the smallest denominator
+   between non-negative bounds `bounds[0] / bounds[1]`
+   and `bounds[2] / bounds[3]` by walking their continued fraction
+   expansions simultaneously: while the bounds share the integral part
+   it becomes the next partial quotient and the search continues
+   between reciprocals of the fractional parts.
+   Returns 0 on overflow. */
+static int int64_simplest_between(const long long bounds[4], int inclusive,
+                                  long long result[2]) {
+  long long convergents[4] = {0, 1, 1, 0};
+  long long lower_numerator = bounds[0], lower_denominator = bounds[1],
+            upper_numerator = bounds[2], upper_denominator = bounds[3],
+            term = 0;
+  while (1) {
+    long long lower_quotient = lower_numerator / lower_denominator,
+              lower_remainder = lower_numerator % lower_denominator,
+              upper_quotient = upper_numerator / upper_denominator,
+              upper_remainder = upper_numerator % upper_denominator;
+    if (inclusive && lower_remainder == 0) {
+      term = lower_quotient;
+      break;
+    }
+    long long gap = upper_quotient - lower_quotient;
+    if (inclusive ? gap > 0 : gap > 1 || (gap == 1 && upper_remainder)) {
+      term = lower_quotient + 1;
+      break;
+    }
+    /* integral parts coincide unless the open upper bound
+       is the successor of the lower one */
+    long long rest = upper_remainder ? upper_remainder : upper_denominator;
+    if (!int64_convergents_append(convergents, lower_quotient)) return 0;
+    if (lower_remainder == 0) {
+      /* the rest of the open interval is unbounded above */
+      term = upper_denominator / rest;
+      if (term == LLONG_MAX) return 0;
+      ++term;
+      break;
+    }
+    lower_numerator = upper_denominator;
+    upper_numerator = lower_denominator;
+    lower_denominator = rest;
+    upper_denominator = lower_remainder;
+  }
+  if (!int64_convergents_append(convergents, term)) return 0;
+  result[0] = convergents[2];
+  result[1] = convergents[3];
+  return 1;
+}
+
+static int Longs_simplest_between(PyObject* const bounds[4], int inclusive,
+                                  PyObject** result_numerator,
+                                  PyObject** result_denominator) {
+  static const long initial_convergents[4] = {0, 1, 1, 0};
+  PyObject *convergents[4] = {NULL, NULL, NULL, NULL},
+           *current[4] = {NULL, NULL, NULL, NULL};
+  PyObject *lower_quotient = NULL, *lower_remainder = NULL,
+           *upper_quotient = NULL, *upper_remainder = NULL,
+           *successor = NULL, *term = NULL;
+  int signal = -1;
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) return -1;
+  for (size_t index = 0; index < 4; ++index) {
+    convergents[index] = PyLong_FromLong(initial_convergents[index]);
+    if (convergents[index] == NULL) goto done;
+    Py_INCREF(bounds[index]);
+    current[index] = bounds[index];
+  }
+  while (1) {
+    if (Longs_divmod(current[0], current[1], &lower_quotient,
+                     &lower_remainder) < 0 ||
+        Longs_divmod(current[2], current[3], &upper_quotient,
+                     &upper_remainder) < 0)
+      goto done;
+    if (inclusive && !_PyLong_Sign(lower_remainder)) {
+      term = lower_quotient;
+      lower_quotient = NULL;
+      break;
+    }
+    successor = PyNumber_Add(lower_quotient, one);
+    if (successor == NULL) goto done;
+    int is_successor_inside = PyObject_RichCompareBool(
+        successor, upper_quotient, inclusive ? Py_LE : Py_LT);
+    if (is_successor_inside < 0) goto done;
+    if (!is_successor_inside && !inclusive &&
+        _PyLong_Sign(upper_remainder) &&
+        (is_successor_inside =
+             PyObject_RichCompareBool(successor, upper_quotient, Py_EQ)) < 0)
+      goto done;
+    if (is_successor_inside) {
+      term = successor;
+      successor = NULL;
+      break;
+    }
+    PyObject* rest =
+        _PyLong_Sign(upper_remainder) ? upper_remainder : current[3];
+    if (Longs_convergents_append(convergents, lower_quotient) < 0) goto done;
+    if (!_PyLong_Sign(lower_remainder)) {
+      PyObject* quotient = PyNumber_FloorDivide(current[3], rest);
+      if (quotient == NULL) goto done;
+      term = PyNumber_Add(quotient, one);
+      Py_DECREF(quotient);
+      break;
+    }
+    Py_INCREF(rest);
+    Py_DECREF(current[0]);
+    Py_DECREF(current[2]);
+    current[0] = current[3];
+    current[2] = current[1];
+    current[1] = rest;
+    current[3] = lower_remainder;
+    lower_remainder = NULL;
+    Py_CLEAR(lower_quotient);
+    Py_CLEAR(upper_quotient);
+    Py_CLEAR(upper_remainder);
+    Py_CLEAR(successor);
+  }
+  if (term == NULL || Longs_convergents_append(convergents, term) < 0)
+    goto done;
+  *result_numerator = convergents[2];
+  *result_denominator = convergents[3];
+  convergents[2] = convergents[3] = NULL;
+  signal = 0;
+done:
+  for (size_t index = 0; index < 4; ++index) {
+    Py_XDECREF(convergents[index]);
+    Py_XDECREF(current[index]);
+  }
+  Py_XDECREF(lower_quotient);
+  Py_XDECREF(lower_remainder);
+  Py_XDECREF(upper_quotient);
+  Py_XDECREF(upper_remainder);
+  Py_XDECREF(successor);
+  Py_XDECREF(term);
+  Py_DECREF(one);
+  return signal;
+}
+
+static int simplest_between_components(PyObject* const bounds[4],
+                                       int inclusive,
+                                       PyObject** result_numerator,
+                                       PyObject** result_denominator) {
+  long long small_bounds[4], small_result[2];
+  int signal = 1;
+  for (size_t index = 0; index < 4 && signal > 0; ++index)
+    signal = Long_to_int64(bounds[index], &small_bounds[index]);
+  if (signal < 0) return -1;
+  if (!signal || !int64_simplest_between(small_bounds, inclusive, small_result))
+    return Longs_simplest_between(bounds, inclusive, result_numerator,
+                                  result_denominator);
+  PyObject* numerator = PyLong_FromLongLong(small_result[0]);
+  if (numerator == NULL) return -1;
+  PyObject* denominator = PyLong_FromLongLong(small_result[1]);
+  if (denominator == NULL) {
+    Py_DECREF(numerator);
+    return -1;
+  }
+  *result_numerator = numerator;
+  *result_denominator = denominator;
+  return 0;
+}
+
+/* Components of `numerator * 2 ** exponent`,
+   returns 0 if they do not fit in machine words. */
+static int int64_binary_fraction_components(long long numerator, int exponent,
+                                            long long components[2]) {
+  if (exponent >= 0) {
+    if (exponent > 62 || numerator > LLONG_MAX >> exponent) return 0;
+    components[0] = numerator << exponent;
+    components[1] = 1;
+  } else {
+    if (exponent < -62) return 0;
+    components[0] = numerator;
+    components[1] = 1LL << -exponent;
+  }
+  return 1;
+}
+
+static int Long_binary_fraction_components(long long numerator, int exponent,
+                                           PyObject** components) {
+  PyObject* shift = PyLong_FromLong(abs(exponent));
+  if (shift == NULL) return -1;
+  components[0] = PyLong_FromLongLong(numerator);
+  components[1] = PyLong_FromLong(1);
+  int index = exponent >= 0 ? 0 : 1;
+  PyObject* shifted = components[0] && components[1]
+                          ? PyNumber_Lshift(components[index], shift)
+                          : NULL;
+  Py_DECREF(shift);
+  if (shifted == NULL) {
+    Py_XDECREF(components[0]);
+    Py_XDECREF(components[1]);
+    return -1;
+  }
+  Py_SETREF(components[index], shifted);
+  return 0;
+}
+
+static PyObject* fraction_from_float_shortest(PyTypeObject* cls,
+                                              PyObject* value) {
+  if (!PyFloat_Check(value)) {
+    PyErr_Format(PyExc_TypeError, "Value should be a float, but got %R.",
+                 value);
     return NULL;
   }
-  return construct_fraction(&FractionType, result_numerator,
-                            result_denominator);
+  double number = PyFloat_AS_DOUBLE(value);
+  if (isinf(number)) {
+    PyErr_SetString(PyExc_OverflowError,
+                    "Cannot construct Fraction from infinity.");
+    return NULL;
+  }
+  if (isnan(number)) {
+    PyErr_SetString(PyExc_ValueError, "Cannot construct Fraction from NaN.");
+    return NULL;
+  }
+  if (number == 0.0)
+    return (PyObject*)construct_fraction_from_small_components(cls, 0, 1);
+  int exponent;
+  long long mantissa =
+      (long long)ldexp(frexp(fabs(number), &exponent), DBL_MANT_DIG);
+  exponent -= DBL_MANT_DIG;
+  static const int min_exponent = DBL_MIN_EXP - DBL_MANT_DIG;
+  if (exponent < min_exponent) {
+    mantissa >>= min_exponent - exponent;
+    exponent = min_exponent;
+  }
+  /* the number is what its half-ulp neighbourhood rounds to,
+     ties are included for even mantissas,
+     the neighbourhood is narrower below powers of two */
+  int is_power_of_two = mantissa == 1LL << (DBL_MANT_DIG - 1) &&
+                        exponent > min_exponent;
+  long long lower_numerator = is_power_of_two ? 4 * mantissa - 1
+                                              : 2 * mantissa - 1,
+            upper_numerator = 2 * mantissa + 1;
+  int lower_exponent = exponent - (is_power_of_two ? 2 : 1),
+      upper_exponent = exponent - 1, inclusive = !(mantissa & 1);
+  long long small_bounds[4], small_result[2];
+  PyObject *numerator, *denominator;
+  if (int64_binary_fraction_components(lower_numerator, lower_exponent,
+                                       small_bounds) &&
+      int64_binary_fraction_components(upper_numerator, upper_exponent,
+                                       small_bounds + 2) &&
+      int64_simplest_between(small_bounds, inclusive, small_result)) {
+    numerator = PyLong_FromLongLong(number < 0 ? -small_result[0]
+                                               : small_result[0]);
+    if (numerator == NULL) return NULL;
+    denominator = PyLong_FromLongLong(small_result[1]);
+    if (denominator == NULL) {
+      Py_DECREF(numerator);
+      return NULL;
+    }
+    return (PyObject*)construct_fraction(cls, numerator, denominator);
+  }
+  PyObject* bounds[4];
+  if (Long_binary_fraction_components(lower_numerator, lower_exponent,
+                                      bounds) < 0)
+    return NULL;
+  if (Long_binary_fraction_components(upper_numerator, upper_exponent,
+                                      bounds + 2) < 0) {
+    Py_DECREF(bounds[0]);
+    Py_DECREF(bounds[1]);
+    return NULL;
+  }
+  int signal = simplest_between_components(bounds, inclusive, &numerator,
+                                           &denominator);
+  for (size_t index = 0; index < 4; ++index) Py_DECREF(bounds[index]);
+  if (signal < 0) return NULL;
+  if (number < 0) {
+    Py_SETREF(numerator, PyNumber_Negative(numerator));
+    if (numerator == NULL) {
+      Py_DECREF(denominator);
+      return NULL;
+    }
+  }
+  return (PyObject*)construct_fraction(cls, numerator, denominator);
+}
+
+/* Fills the list with the following elements of the iterator,
+   returns the number of written elements. */
+static PyObject* fractions_iterator_fill(PyObject* self, PyObject* target) {
+  if (!PyList_Check(target)) {
+    PyErr_Format(PyExc_TypeError, "Target should be a list, but got %R.",
+                 target);
+    return NULL;
+  }
+  iternextfunc next = Py_TYPE(self)->tp_iternext;
+  Py_ssize_t index = 0;
+  for (; index < PyList_GET_SIZE(target); ++index) {
+    PyObject* element = next(self);
+    if (element == NULL) {
+      if (PyErr_Occurred()) return NULL;
+      break;
+    }
+    if (PyList_SetItem(target, index, element) < 0) return NULL;
+  }
+  return PyLong_FromSsize_t(index);
+}
+
+static PyMethodDef fractions_iterator_methods[] = {
+    {"fill", (PyCFunction)fractions_iterator_fill, METH_O, NULL},
+    {NULL, NULL, 0, NULL} /* sentinel */
+};
+
+typedef struct {
+  PyObject_HEAD long long order;
+  /* the next term followed by its successor,
+     all terms are reduced, so they are produced without GCD */
+  long long terms[4];
+} FareyIteratorObject;
+
+/* Orders up to this one keep the successors computation
+   within machine words. */
+#define MAX_FAREY_ORDER (LLONG_MAX / 4)
+
+static PyObject* farey_iterator_next(FareyIteratorObject* self) {
+  long long* terms = self->terms;
+  if (terms[0] > terms[1]) return NULL;
+  PyObject* result = (PyObject*)construct_fraction_from_small_components(
+      get_type_state(Py_TYPE(self))->fraction_type, terms[0], terms[1]);
+  if (result == NULL) return NULL;
+  long long factor = (self->order + terms[1]) / terms[3],
+            numerator = factor * terms[2] - terms[0],
+            denominator = factor * terms[3] - terms[1];
+  terms[0] = terms[2];
+  terms[1] = terms[3];
+  terms[2] = numerator;
+  terms[3] = denominator;
+  return result;
+}
+
+DEFINE_LOCKED_ITERNEXT(farey_iterator_next, FareyIteratorObject)
+
+static void farey_iterator_dealloc(FareyIteratorObject* self) {
+  PyTypeObject* type = Py_TYPE(self);
+  PyObject_Del(self);
+  Py_DECREF(type);
+}
+
+static PyType_Slot farey_iterator_slots[] = {
+    {Py_tp_dealloc, (void*)farey_iterator_dealloc},
+    {Py_tp_iter, (void*)PyObject_SelfIter},
+    {Py_tp_iternext, (void*)LOCKED_ITERNEXT(farey_iterator_next)},
+    {Py_tp_methods, fractions_iterator_methods},
+    {0, NULL},
+};
+
+static PyType_Spec farey_iterator_spec = {
+    .basicsize = sizeof(FareyIteratorObject),
+    .flags = ITERATOR_TYPE_FLAGS,
+    .name = "cfractions.FareyIterator",
+    .slots = farey_iterator_slots,
+};
+
+/* Interval of the Stern-Brocot tree with its left bound numerator
+   & denominator followed by the right bound ones. */
+typedef struct {
+  PyObject* bounds[4]; /* `NULL` while the iterator is small */
+  long long small_bounds[4];
+  Py_ssize_t level;
+} MediantsInterval;
+
+static void mediants_interval_clear(MediantsInterval* self) {
+  for (size_t index = 0; index < 4; ++index) Py_CLEAR(self->bounds[index]);
+}
+
+/* Walks the Stern-Brocot subtree between the bounds in order
+   keeping right subtrees of the pending nodes on the stack,
+   mediants of adjacent bounds are reduced, so no GCD is run for them. */
+typedef struct {
+  PyObject_HEAD Py_ssize_t depth;
+  Py_ssize_t size;
+  Py_ssize_t capacity;
+  int is_small;
+  int is_reduced;
+  MediantsInterval current;
+  MediantsInterval* stack;
+} MediantsIteratorObject;
+
+static void mediants_iterator_dealloc(MediantsIteratorObject* self) {
+  mediants_interval_clear(&self->current);
+  for (Py_ssize_t index = 0; index < self->size; ++index)
+    mediants_interval_clear(&self->stack[index]);
+  PyMem_Free(self->stack);
+  PyTypeObject* type = Py_TYPE(self);
+  PyObject_Del(self);
+  Py_DECREF(type);
+}
+
+static int mediants_iterator_push(MediantsIteratorObject* self) {
+  if (self->size == self->capacity) {
+    Py_ssize_t capacity = self->capacity ? 2 * self->capacity : 16;
+    MediantsInterval* stack =
+        PyMem_Resize(self->stack, MediantsInterval, (size_t)capacity);
+    if (stack == NULL) {
+      PyErr_NoMemory();
+      return -1;
+    }
+    self->stack = stack;
+    self->capacity = capacity;
+  }
+  MediantsInterval* current = &self->current;
+  MediantsInterval* interval = &self->stack[self->size];
+  interval->level = current->level + 1;
+  if (self->is_small) {
+    for (size_t index = 0; index < 2; ++index) {
+      interval->bounds[index] = interval->bounds[index + 2] = NULL;
+      interval->small_bounds[index] = current->small_bounds[index] +
+                                      current->small_bounds[index + 2];
+      interval->small_bounds[index + 2] = current->small_bounds[index + 2];
+      current->small_bounds[index + 2] = interval->small_bounds[index];
+    }
+  } else {
+    for (size_t index = 0; index < 2; ++index) {
+      PyObject* mediant_component = PyNumber_Add(
+          current->bounds[index], current->bounds[index + 2]);
+      if (mediant_component == NULL) {
+        if (index) Py_DECREF(interval->bounds[0]);
+        return -1;
+      }
+      interval->bounds[index] = mediant_component;
+    }
+    for (size_t index = 0; index < 2; ++index) {
+      interval->bounds[index + 2] = current->bounds[index + 2];
+      Py_INCREF(interval->bounds[index]);
+      current->bounds[index + 2] = interval->bounds[index];
+    }
+  }
+  ++current->level;
+  ++self->size;
+  return 0;
+}
+
+static PyObject* mediants_iterator_next(MediantsIteratorObject* self) {
+  while (self->current.level <= self->depth)
+    if (mediants_iterator_push(self) < 0) return NULL;
+  if (self->size == 0) return NULL;
+  PyTypeObject* cls = get_type_state(Py_TYPE(self))->fraction_type;
+  mediants_interval_clear(&self->current);
+  self->current = self->stack[--self->size];
+  if (self->is_small) {
+    long long numerator = self->current.small_bounds[0],
+              denominator = self->current.small_bounds[1];
+    if (!self->is_reduced) {
+      long long gcd = (long long)uint64_gcd(
+          numerator < 0 ? 0ULL - (unsigned long long)numerator
+                        : (unsigned long long)numerator,
+          (unsigned long long)denominator);
+      numerator /= gcd;
+      denominator /= gcd;
+    }
+    return (PyObject*)construct_fraction_from_small_components(
+        cls, numerator, denominator);
+  }
+  PyObject *numerator = self->current.bounds[0],
+           *denominator = self->current.bounds[1];
+  Py_INCREF(numerator);
+  Py_INCREF(denominator);
+  if (!self->is_reduced &&
+      normalize_fraction_components_moduli(&numerator, &denominator) < 0) {
+    Py_DECREF(denominator);
+    Py_DECREF(numerator);
+    return NULL;
+  }
+  return (PyObject*)construct_fraction(cls, numerator, denominator);
+}
+
+DEFINE_LOCKED_ITERNEXT(mediants_iterator_next, MediantsIteratorObject)
+
+static PyType_Slot mediants_iterator_slots[] = {
+    {Py_tp_dealloc, (void*)mediants_iterator_dealloc},
+    {Py_tp_iter, (void*)PyObject_SelfIter},
+    {Py_tp_iternext, (void*)LOCKED_ITERNEXT(mediants_iterator_next)},
+    {Py_tp_methods, fractions_iterator_methods},
+    {0, NULL},
+};
+
+static PyType_Spec mediants_iterator_spec = {
+    .basicsize = sizeof(MediantsIteratorObject),
+    .flags = ITERATOR_TYPE_FLAGS,
+    .name = "cfractions.MediantsIterator",
+    .slots = mediants_iterator_slots,
+};
+
+/* Checks if mediants up to the depth cannot overflow machine words:
+   components of a node on the level `k` are bounded by
+   the `k + 2`-th Fibonacci number times the maximum bounds component. */
+static int mediants_fit_int64(const long long bounds[4], Py_ssize_t depth) {
+  unsigned long long max_component = 1;
+  for (size_t index = 0; index < 4; ++index) {
+    unsigned long long component =
+        bounds[index] < 0 ? 0ULL - (unsigned long long)bounds[index]
+                          : (unsigned long long)bounds[index];
+    if (component > max_component) max_component = component;
+  }
+  unsigned long long limit = (unsigned long long)LLONG_MAX / max_component,
+                     previous_fibonacci = 1, fibonacci = 1;
+  for (Py_ssize_t level = 0; level < depth; ++level) {
+    unsigned long long next_fibonacci = previous_fibonacci + fibonacci;
+    if (next_fibonacci > limit) return 0;
+    previous_fibonacci = fibonacci;
+    fibonacci = next_fibonacci;
+  }
+  return fibonacci <= limit;
+}
+
+static FractionObject* Fractions_components_true_divide(
+    PyTypeObject* cls, PyObject* numerator, PyObject* denominator,
+    PyObject* other_numerator, PyObject* other_denominator) {
+  if (PyObject_Not(other_numerator)) {
+    PyErr_Format(PyExc_ZeroDivisionError, "Fraction(%S, 0)", numerator);
+    return NULL;
+  }
+  PyObject* gcd = Longs_gcd(numerator, other_numerator);
+  if (gcd == NULL) return NULL;
+  numerator = Longs_floor_divide(numerator, gcd);
+  if (numerator == NULL) {
+    Py_DECREF(gcd);
+    return NULL;
+  }
+  other_numerator = Longs_floor_divide(other_numerator, gcd);
+  Py_DECREF(gcd);
+  if (other_numerator == NULL) {
+    Py_DECREF(numerator);
+    return NULL;
+  }
+  gcd = Longs_gcd(denominator, other_denominator);
+  if (gcd == NULL) return NULL;
+  denominator = Longs_floor_divide(denominator, gcd);
+  if (denominator == NULL) {
+    Py_DECREF(gcd);
+    Py_DECREF(other_numerator);
+    Py_DECREF(numerator);
+    return NULL;
+  }
+  other_denominator = Longs_floor_divide(other_denominator, gcd);
+  Py_DECREF(gcd);
+  if (other_denominator == NULL) {
+    Py_DECREF(denominator);
+    Py_DECREF(other_numerator);
+    Py_DECREF(numerator);
+    return NULL;
+  }
+  PyObject* result_numerator = Longs_multiply(numerator, other_denominator);
+  Py_DECREF(other_denominator);
+  Py_DECREF(numerator);
+  if (result_numerator == NULL) {
+    Py_DECREF(other_numerator);
+    Py_DECREF(denominator);
+    return NULL;
+  }
+  PyObject* result_denominator =
+      Longs_multiply(denominator, other_numerator);
+  Py_DECREF(other_numerator);
+  Py_DECREF(denominator);
+  if (result_denominator == NULL) {
+    Py_DECREF(result_numerator);
+    return NULL;
+  }
+  if (normalize_fraction_components_signs(&result_numerator,
+                                          &result_denominator) < 0) {
+    Py_INCREF(result_denominator);
+    Py_INCREF(result_numerator);
+    return NULL;
+  }
+  return construct_fraction(cls, result_numerator, result_denominator);
 }
 
 static FractionObject* Fractions_true_divide(FractionObject* self,
                                              FractionObject* other) {
-  return Fractions_components_true_divide(self->numerator, self->denominator,
-                                          other->numerator, other->denominator);
+  return Fractions_components_true_divide(Py_TYPE(self), self->numerator,
+                                          self->denominator, other->numerator,
+                                          other->denominator);
 }
 
 static FractionObject* fraction_Long_true_divide(FractionObject* self,
@@ -2203,21 +4361,21 @@ static FractionObject* fraction_Long_true_divide(FractionObject* self,
     PyErr_Format(PyExc_ZeroDivisionError, "Fraction(%S, 0)", self->numerator);
     return NULL;
   }
-  PyObject* gcd = _PyLong_GCD(self->numerator, other);
+  PyObject* gcd = Longs_gcd(self->numerator, other);
   if (gcd == NULL) return NULL;
-  PyObject* result_numerator = PyNumber_FloorDivide(self->numerator, gcd);
+  PyObject* result_numerator = Longs_floor_divide(self->numerator, gcd);
   if (result_numerator == NULL) {
     Py_DECREF(gcd);
     return NULL;
   }
-  PyObject* other_normalized = PyNumber_FloorDivide(other, gcd);
+  PyObject* other_normalized = Longs_floor_divide(other, gcd);
   Py_DECREF(gcd);
   if (other_normalized == NULL) {
     Py_DECREF(result_numerator);
     return NULL;
   }
   PyObject* result_denominator =
-      PyNumber_Multiply(self->denominator, other_normalized);
+      Longs_multiply(self->denominator, other_normalized);
   Py_DECREF(other_normalized);
   if (result_denominator == NULL) {
     Py_DECREF(result_numerator);
@@ -2229,7 +4387,7 @@ static FractionObject* fraction_Long_true_divide(FractionObject* self,
     Py_INCREF(result_numerator);
     return NULL;
   }
-  return construct_fraction(&FractionType, result_numerator,
+  return construct_fraction(Py_TYPE(self), result_numerator,
                             result_denominator);
 }
 
@@ -2239,21 +4397,21 @@ static FractionObject* Long_fraction_true_divide(PyObject* self,
     PyErr_Format(PyExc_ZeroDivisionError, "Fraction(%S, 0)", self);
     return NULL;
   }
-  PyObject* gcd = _PyLong_GCD(self, other->numerator);
+  PyObject* gcd = Longs_gcd(self, other->numerator);
   if (gcd == NULL) return NULL;
-  PyObject* result_denominator = PyNumber_FloorDivide(other->numerator, gcd);
+  PyObject* result_denominator = Longs_floor_divide(other->numerator, gcd);
   if (result_denominator == NULL) {
     Py_DECREF(gcd);
     return NULL;
   }
-  PyObject* self_normalized = PyNumber_FloorDivide(self, gcd);
+  PyObject* self_normalized = Longs_floor_divide(self, gcd);
   Py_DECREF(gcd);
   if (self_normalized == NULL) {
     Py_DECREF(result_denominator);
     return NULL;
   }
   PyObject* result_numerator =
-      PyNumber_Multiply(self_normalized, other->denominator);
+      Longs_multiply(self_normalized, other->denominator);
   Py_DECREF(self_normalized);
   if (result_numerator == NULL) {
     Py_DECREF(result_denominator);
@@ -2265,7 +4423,7 @@ static FractionObject* Long_fraction_true_divide(PyObject* self,
     Py_INCREF(result_numerator);
     return NULL;
   }
-  return construct_fraction(&FractionType, result_numerator,
+  return construct_fraction(Py_TYPE(other), result_numerator,
                             result_denominator);
 }
 
@@ -2276,7 +4434,8 @@ static FractionObject* fraction_Rational_true_divide(FractionObject* self,
                                               &other_denominator) < 0)
     return NULL;
   FractionObject* result = Fractions_components_true_divide(
-      self->numerator, self->denominator, other_numerator, other_denominator);
+      Py_TYPE(self), self->numerator, self->denominator, other_numerator,
+      other_denominator);
   Py_DECREF(other_denominator);
   Py_DECREF(other_numerator);
   return result;
@@ -2289,15 +4448,17 @@ static FractionObject* Rational_fraction_true_divide(PyObject* self,
       0)
     return NULL;
   FractionObject* result = Fractions_components_true_divide(
-      numerator, denominator, other->numerator, other->denominator);
+      Py_TYPE(other), numerator, denominator, other->numerator,
+      other->denominator);
   Py_DECREF(denominator);
   Py_DECREF(numerator);
   return result;
 }
 
-static PyObject* fraction_true_divide(PyObject* self, PyObject* other) {
-  if (PyObject_TypeCheck(self, &FractionType)) {
-    if (PyObject_TypeCheck(other, &FractionType))
+static PyObject* fraction_true_divide_exact(PyObject* self, PyObject* other) {
+  STATS_COUNT_OPERATION(OPERATION_TRUE_DIVIDE, self, other);
+  if (is_fraction(self)) {
+    if (is_fraction(other))
       return (PyObject*)Fractions_true_divide((FractionObject*)self,
                                               (FractionObject*)other);
     else if (PyLong_Check(other))
@@ -2308,7 +4469,7 @@ static PyObject* fraction_true_divide(PyObject* self, PyObject* other) {
       PyObject* result = PyNumber_TrueDivide(tmp, other);
       Py_DECREF(tmp);
       return result;
-    } else if (PyObject_IsInstance(other, Rational))
+    } else if (is_rational(Py_TYPE(self), other))
       return (PyObject*)fraction_Rational_true_divide((FractionObject*)self,
                                                       other);
   } else if (PyLong_Check(self))
@@ -2319,7 +4480,7 @@ static PyObject* fraction_true_divide(PyObject* self, PyObject* other) {
     PyObject* result = PyNumber_TrueDivide(self, tmp);
     Py_DECREF(tmp);
     return result;
-  } else if (PyObject_IsInstance(self, Rational))
+  } else if (is_rational(Py_TYPE(other), self))
     return (PyObject*)Rational_fraction_true_divide(self,
                                                     (FractionObject*)other);
   Py_RETURN_NOTIMPLEMENTED;
@@ -2330,244 +4491,3497 @@ static FractionObject* fraction_positive(FractionObject* self) {
   return self;
 }
 
-static PyObject* fraction_round_plain(FractionObject* self) {
-  PyObject *quotient, *remainder;
-  int divmod_signal =
-      Longs_divmod(self->numerator, self->denominator, &quotient, &remainder);
-  if (divmod_signal < 0) return NULL;
-  PyObject* scalar = PyLong_FromLong(2);
-  if (scalar == NULL) {
-    Py_DECREF(remainder);
-    Py_DECREF(quotient);
+#define MAX_INT64_POWER_OF_TEN_EXPONENT 18
+
+static const long long
+    int64_powers_of_ten[MAX_INT64_POWER_OF_TEN_EXPONENT + 1] = {
+        1LL,
+        10LL,
+        100LL,
+        1000LL,
+        10000LL,
+        100000LL,
+        1000000LL,
+        10000000LL,
+        100000000LL,
+        1000000000LL,
+        10000000000LL,
+        100000000000LL,
+        1000000000000LL,
+        10000000000000LL,
+        100000000000000LL,
+        1000000000000000LL,
+        10000000000000000LL,
+        100000000000000000LL,
+        1000000000000000000LL};
+
+static PyObject* Long_power_of_ten_uncached(Py_ssize_t exponent) {
+  if (exponent <= MAX_INT64_POWER_OF_TEN_EXPONENT)
+    return PyLong_FromLongLong(int64_powers_of_ten[exponent]);
+  PyObject* base = PyLong_FromLong(10);
+  if (base == NULL) return NULL;
+  PyObject* exponent_object = PyLong_FromSsize_t(exponent);
+  if (exponent_object == NULL) {
+    Py_DECREF(base);
+    return NULL;
+  }
+  PyObject* result = PyNumber_Power(base, exponent_object, Py_None);
+  Py_DECREF(exponent_object);
+  Py_DECREF(base);
+  return result;
+}
+
+static int load_powers_of_ten(ModuleState* state) {
+  for (Py_ssize_t exponent = 0; exponent < POWERS_OF_TEN_CACHE_SIZE;
+       ++exponent) {
+    state->powers_of_ten[exponent] = Long_power_of_ten_uncached(exponent);
+    if (state->powers_of_ten[exponent] == NULL) return -1;
+  }
+  return 0;
+}
+
+static PyObject* Long_power_of_ten(ModuleState* state, Py_ssize_t exponent) {
+  if (exponent >= POWERS_OF_TEN_CACHE_SIZE) {
+    STATS_INCREMENT(powers_of_ten_cache_misses);
+    return Long_power_of_ten_uncached(exponent);
+  }
+  STATS_INCREMENT(powers_of_ten_cache_hits);
+  Py_INCREF(state->powers_of_ten[exponent]);
+  return state->powers_of_ten[exponent];
+}
+
+typedef enum {
+  ROUND_CEILING,
+  ROUND_DOWN,
+  ROUND_FLOOR,
+  ROUND_HALF_DOWN,
+  ROUND_HALF_EVEN,
+  ROUND_HALF_UP,
+  ROUND_UP,
+} RoundingMode;
+
+static const char* rounding_modes_names[] = {
+    "ROUND_CEILING",   "ROUND_DOWN",    "ROUND_FLOOR", "ROUND_HALF_DOWN",
+    "ROUND_HALF_EVEN", "ROUND_HALF_UP", "ROUND_UP",
+};
+
+static int parse_rounding_mode(PyObject* value, RoundingMode* result) {
+  if (PyUnicode_Check(value))
+    for (size_t index = 0; index < Py_ARRAY_LENGTH(rounding_modes_names);
+         ++index)
+      if (PyUnicode_CompareWithASCIIString(value,
+                                           rounding_modes_names[index]) == 0) {
+        *result = (RoundingMode)index;
+        return 0;
+      }
+  PyErr_Format(PyExc_ValueError, "Invalid rounding mode: %R.", value);
+  return -1;
+}
+
+/* Decides whether the floored quotient with non-zero remainder
+   should be incremented, `remainder_comparison` is the sign of
+   `2 * remainder - divisor`. */
+static int rounding_increments_quotient(RoundingMode mode,
+                                        int is_quotient_negative,
+                                        int is_quotient_odd,
+                                        int remainder_comparison) {
+  switch (mode) {
+    case ROUND_CEILING:
+      return 1;
+    case ROUND_DOWN:
+      return is_quotient_negative;
+    case ROUND_FLOOR:
+      return 0;
+    case ROUND_UP:
+      return !is_quotient_negative;
+    default:
+      break;
+  }
+  if (remainder_comparison != 0) return remainder_comparison > 0;
+  switch (mode) {
+    case ROUND_HALF_DOWN:
+      return is_quotient_negative;
+    case ROUND_HALF_UP:
+      return !is_quotient_negative;
+    default:
+      return is_quotient_odd;
+  }
+}
+
+static int rounding_mode_is_half(RoundingMode mode) {
+  return mode == ROUND_HALF_DOWN || mode == ROUND_HALF_EVEN ||
+         mode == ROUND_HALF_UP;
+}
+
+static long long int64_divide_rounding(long long dividend, long long divisor,
+                                       RoundingMode mode) {
+  long long quotient, remainder;
+  int64_floor_divmod(dividend, divisor, &quotient, &remainder);
+  if (remainder == 0) return quotient;
+  unsigned long long doubled_remainder = 2ULL * (unsigned long long)remainder;
+  int remainder_comparison =
+      doubled_remainder > (unsigned long long)divisor
+          ? 1
+          : (doubled_remainder < (unsigned long long)divisor ? -1 : 0);
+  if (rounding_increments_quotient(mode, quotient < 0, (int)(quotient & 1),
+                                   remainder_comparison))
+    ++quotient;
+  return quotient;
+}
+
+static PyObject* Longs_divide_rounding(PyObject* dividend, PyObject* divisor,
+                                       RoundingMode mode) {
+  int overflow;
+  long long small_dividend = PyLong_AsLongLongAndOverflow(dividend, &overflow);
+  if (small_dividend == -1 && PyErr_Occurred()) return NULL;
+  if (!overflow) {
+    long long small_divisor = PyLong_AsLongLongAndOverflow(divisor, &overflow);
+    if (small_divisor == -1 && PyErr_Occurred()) return NULL;
+    if (!overflow)
+      return PyLong_FromLongLong(
+          int64_divide_rounding(small_dividend, small_divisor, mode));
+  }
+  PyObject *quotient, *remainder;
+  if (Longs_divmod(dividend, divisor, &quotient, &remainder) < 0) return NULL;
+  int is_remainder_zero = PyObject_Not(remainder);
+  if (is_remainder_zero) {
+    Py_DECREF(remainder);
+    if (is_remainder_zero < 0) {
+      Py_DECREF(quotient);
+      return NULL;
+    }
+    return quotient;
+  }
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) {
+    Py_DECREF(remainder);
+    Py_DECREF(quotient);
+    return NULL;
+  }
+  int remainder_comparison = 0, is_quotient_odd = 0;
+  if (rounding_mode_is_half(mode)) {
+    PyObject* doubled_remainder = PyNumber_Add(remainder, remainder);
+    if (doubled_remainder == NULL) goto error;
+    int is_greater =
+        PyObject_RichCompareBool(doubled_remainder, divisor, Py_GT);
+    int is_less = is_greater ? 0
+                             : PyObject_RichCompareBool(doubled_remainder,
+                                                        divisor, Py_LT);
+    Py_DECREF(doubled_remainder);
+    if (is_greater < 0 || is_less < 0) goto error;
+    remainder_comparison = is_greater - is_less;
+    if (remainder_comparison == 0) {
+      PyObject* parity = PyNumber_And(quotient, one);
+      if (parity == NULL) goto error;
+      is_quotient_odd = PyObject_IsTrue(parity);
+      Py_DECREF(parity);
+      if (is_quotient_odd < 0) goto error;
+    }
+  }
+  int is_quotient_negative = is_negative_py_object(quotient);
+  if (is_quotient_negative < 0) goto error;
+  Py_DECREF(remainder);
+  PyObject* result;
+  if (rounding_increments_quotient(mode, is_quotient_negative, is_quotient_odd,
+                                   remainder_comparison))
+    result = PyNumber_Add(quotient, one);
+  else {
+    Py_INCREF(quotient);
+    result = quotient;
+  }
+  Py_DECREF(one);
+  Py_DECREF(quotient);
+  return result;
+error:
+  Py_DECREF(one);
+  Py_DECREF(remainder);
+  Py_DECREF(quotient);
+  return NULL;
+}
+
+static FractionObject* Fractions_components_round(PyTypeObject* cls,
+                                                  PyObject* numerator,
+                                                  PyObject* denominator,
+                                                  Py_ssize_t precision) {
+  int overflow;
+  long long small_numerator =
+      PyLong_AsLongLongAndOverflow(numerator, &overflow);
+  if (small_numerator == -1 && PyErr_Occurred()) return NULL;
+  if (!overflow) {
+    long long small_denominator =
+        PyLong_AsLongLongAndOverflow(denominator, &overflow);
+    if (small_denominator == -1 && PyErr_Occurred()) return NULL;
+    if (!overflow) {
+      if (precision >= 0 && precision <= MAX_INT64_POWER_OF_TEN_EXPONENT) {
+        long long scale = int64_powers_of_ten[precision];
+        if (small_numerator >= -(LLONG_MAX / scale) &&
+            small_numerator <= LLONG_MAX / scale) {
+          long long result_numerator = int64_divide_rounding(
+              small_numerator * scale, small_denominator, ROUND_HALF_EVEN);
+          long long gcd = (long long)uint64_gcd(
+              result_numerator < 0 ? 0ULL - (unsigned long long)result_numerator
+                                   : (unsigned long long)result_numerator,
+              (unsigned long long)scale);
+          return construct_fraction_from_small_components(
+              cls, result_numerator / gcd, scale / gcd);
+        }
+      } else if (precision < 0 &&
+                 precision >= -MAX_INT64_POWER_OF_TEN_EXPONENT) {
+        long long scale = int64_powers_of_ten[-precision];
+        if (small_denominator <= LLONG_MAX / scale) {
+          long long quotient = int64_divide_rounding(
+              small_numerator, small_denominator * scale, ROUND_HALF_EVEN);
+          if (quotient >= -(LLONG_MAX / scale) && quotient <= LLONG_MAX / scale)
+            return construct_fraction_from_small_components(
+                cls, quotient * scale, 1);
+        }
+      }
+    }
+  }
+  PyObject *result_numerator, *result_denominator;
+  if (precision >= 0) {
+    result_denominator = Long_power_of_ten(get_type_state(cls), precision);
+    if (result_denominator == NULL) return NULL;
+    PyObject* scaled_numerator =
+        PyNumber_Multiply(numerator, result_denominator);
+    if (scaled_numerator == NULL) {
+      Py_DECREF(result_denominator);
+      return NULL;
+    }
+    result_numerator = Longs_divide_rounding(scaled_numerator, denominator,
+                                             ROUND_HALF_EVEN);
+    Py_DECREF(scaled_numerator);
+    if (result_numerator == NULL) {
+      Py_DECREF(result_denominator);
+      return NULL;
+    }
+    if (normalize_fraction_components_moduli(&result_numerator,
+                                             &result_denominator) < 0) {
+      Py_DECREF(result_numerator);
+      Py_DECREF(result_denominator);
+      return NULL;
+    }
+  } else {
+    PyObject* scale = Long_power_of_ten(get_type_state(cls), -precision);
+    if (scale == NULL) return NULL;
+    PyObject* scaled_denominator = PyNumber_Multiply(denominator, scale);
+    if (scaled_denominator == NULL) {
+      Py_DECREF(scale);
+      return NULL;
+    }
+    PyObject* quotient =
+        Longs_divide_rounding(numerator, scaled_denominator, ROUND_HALF_EVEN);
+    Py_DECREF(scaled_denominator);
+    if (quotient == NULL) {
+      Py_DECREF(scale);
+      return NULL;
+    }
+    result_numerator = PyNumber_Multiply(quotient, scale);
+    Py_DECREF(quotient);
+    Py_DECREF(scale);
+    if (result_numerator == NULL) return NULL;
+    result_denominator = PyLong_FromLong(1);
+    if (result_denominator == NULL) {
+      Py_DECREF(result_numerator);
+      return NULL;
+    }
+  }
+  return construct_fraction(cls, result_numerator, result_denominator);
+}
+
+static PyObject* fraction_round(FractionObject* self, PyObject* args) {
+  PyObject* precision_object = Py_None;
+  if (!PyArg_ParseTuple(args, "|O", &precision_object)) return NULL;
+  if (precision_object == Py_None)
+    return Longs_divide_rounding(self->numerator, self->denominator,
+                                 ROUND_HALF_EVEN);
+  Py_ssize_t precision =
+      PyNumber_AsSsize_t(precision_object, PyExc_OverflowError);
+  if (precision == -1 && PyErr_Occurred()) return NULL;
+  if (precision < -PY_SSIZE_T_MAX) {
+    PyErr_SetString(PyExc_OverflowError, "`precision` is too small.");
+    return NULL;
+  }
+  return (PyObject*)Fractions_components_round(Py_TYPE(self), self->numerator,
+                                               self->denominator, precision);
+}
+
+/* Parses components of a fraction, an integer or another rational number,
+   returns 0 if the value is not rational. */
+static int parse_rational_components(PyTypeObject* cls, PyObject* value,
+                                     PyObject** result_numerator,
+                                     PyObject** result_denominator) {
+  if (is_fraction(value)) {
+    *result_numerator = ((FractionObject*)value)->numerator;
+    Py_INCREF(*result_numerator);
+    *result_denominator = ((FractionObject*)value)->denominator;
+    Py_INCREF(*result_denominator);
+    return 1;
+  } else if (PyLong_Check(value)) {
+    *result_denominator = PyLong_FromLong(1);
+    if (*result_denominator == NULL) return -1;
+    *result_numerator = value;
+    Py_INCREF(value);
+    return 1;
+  }
+  int is_value_rational = is_rational(cls, value);
+  if (is_value_rational <= 0) return is_value_rational;
+  return parse_fraction_components_from_rational(value, result_numerator,
+                                                 result_denominator) < 0
+             ? -1
+             : 1;
+}
+
+static int parse_quantization_step(PyTypeObject* cls, PyObject* step,
+                                   PyObject** result_numerator,
+                                   PyObject** result_denominator) {
+  PyObject *numerator, *denominator;
+  int signal = parse_rational_components(cls, step, &numerator, &denominator);
+  if (signal < 0) return -1;
+  if (!signal) {
+    PyErr_Format(PyExc_TypeError,
+                 "Step should be a rational number, but got %R.", step);
+    return -1;
+  }
+  PyObject* zero = PyLong_FromLong(0);
+  if (zero == NULL) goto error;
+  int is_positive = PyObject_RichCompareBool(numerator, zero, Py_GT);
+  Py_DECREF(zero);
+  if (is_positive < 0) goto error;
+  if (!is_positive) {
+    PyErr_SetString(PyExc_ValueError, "Step should be positive.");
+    goto error;
+  }
+  *result_numerator = numerator;
+  *result_denominator = denominator;
+  return 0;
+error:
+  Py_DECREF(denominator);
+  Py_DECREF(numerator);
+  return -1;
+}
+
+static FractionObject* Fractions_components_quantize(
+    PyTypeObject* cls, PyObject* numerator, PyObject* denominator,
+    PyObject* step_numerator, PyObject* step_denominator, RoundingMode mode) {
+  long long small_numerator, small_denominator, small_step_numerator,
+      small_step_denominator;
+  int signal;
+  if ((signal = Long_to_int64(numerator, &small_numerator)) > 0 &&
+      (signal = Long_to_int64(denominator, &small_denominator)) > 0 &&
+      (signal = Long_to_int64(step_numerator, &small_step_numerator)) > 0 &&
+      (signal = Long_to_int64(step_denominator, &small_step_denominator)) >
+          0) {
+    long long scaled_numerator, scaled_denominator;
+    if (int64_multiply(small_numerator, small_step_denominator,
+                       &scaled_numerator) &&
+        int64_multiply(small_denominator, small_step_numerator,
+                       &scaled_denominator)) {
+      long long multiplier =
+          int64_divide_rounding(scaled_numerator, scaled_denominator, mode);
+      long long result_denominator = small_step_denominator;
+      if (result_denominator != 1) {
+        long long gcd = (long long)uint64_gcd(
+            multiplier < 0 ? 0ULL - (unsigned long long)multiplier
+                           : (unsigned long long)multiplier,
+            (unsigned long long)result_denominator);
+        multiplier /= gcd;
+        result_denominator /= gcd;
+      }
+      long long result_numerator;
+      if (int64_multiply(multiplier, small_step_numerator, &result_numerator))
+        return construct_fraction_from_small_components(
+            cls, result_numerator, result_denominator);
+    }
+  }
+  if (signal < 0) return NULL;
+  PyObject* scaled_numerator = PyNumber_Multiply(numerator, step_denominator);
+  if (scaled_numerator == NULL) return NULL;
+  PyObject* scaled_denominator = PyNumber_Multiply(denominator, step_numerator);
+  if (scaled_denominator == NULL) {
+    Py_DECREF(scaled_numerator);
+    return NULL;
+  }
+  PyObject* multiplier =
+      Longs_divide_rounding(scaled_numerator, scaled_denominator, mode);
+  Py_DECREF(scaled_denominator);
+  Py_DECREF(scaled_numerator);
+  if (multiplier == NULL) return NULL;
+  PyObject* result_denominator = step_denominator;
+  Py_INCREF(result_denominator);
+  int is_step_integral = is_unit_py_object_bool(step_denominator);
+  if (is_step_integral < 0 ||
+      (!is_step_integral && normalize_fraction_components_moduli(
+                                &multiplier, &result_denominator) < 0)) {
+    Py_DECREF(result_denominator);
+    Py_DECREF(multiplier);
+    return NULL;
+  }
+  PyObject* result_numerator = PyNumber_Multiply(multiplier, step_numerator);
+  Py_DECREF(multiplier);
+  if (result_numerator == NULL) {
+    Py_DECREF(result_denominator);
+    return NULL;
+  }
+  return construct_fraction(cls, result_numerator, result_denominator);
+}
+
+static PyObject* fraction_quantize(FractionObject* self, PyObject* args,
+                                   PyObject* kwargs) {
+  static char* keywords[] = {"", "rounding", NULL};
+  PyObject *step, *rounding_object = NULL;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O:quantize", keywords,
+                                   &step, &rounding_object))
+    return NULL;
+  RoundingMode mode = ROUND_HALF_EVEN;
+  if (rounding_object != NULL &&
+      parse_rounding_mode(rounding_object, &mode) < 0)
+    return NULL;
+  PyObject *step_numerator, *step_denominator;
+  if (parse_quantization_step(Py_TYPE(self), step, &step_numerator,
+                              &step_denominator) < 0)
+    return NULL;
+  FractionObject* result = Fractions_components_quantize(
+      Py_TYPE(self), self->numerator, self->denominator, step_numerator,
+      step_denominator, mode);
+  Py_DECREF(step_denominator);
+  Py_DECREF(step_numerator);
+  return (PyObject*)result;
+}
+
+/* Best rational approximation of irrational root of non-negative fraction,
+   found by narrowing the binary bracket of the root
+   until `limit_denominator` agrees on both its ends,
+   which is enough since `limit_denominator` is monotonic. */
+static FractionObject* Fractions_components_approximate_root(
+    PyTypeObject* cls, PyObject* numerator, PyObject* denominator,
+    long long degree, PyObject* max_denominator) {
+  size_t bits_count = _PyLong_NumBits(max_denominator);
+  if (bits_count == (size_t)-1 && PyErr_Occurred()) return NULL;
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) return NULL;
+  FractionObject* result = NULL;
+  for (unsigned long long precision = 2 * bits_count + 8;; precision *= 2) {
+    FractionObject* bounds_approximations[2] = {NULL, NULL};
+    PyObject* shift = PyLong_FromUnsignedLongLong(precision);
+    if (shift == NULL) break;
+    PyObject* scale = PyNumber_Lshift(one, shift);
+    if (scale == NULL) {
+      Py_DECREF(shift);
+      break;
+    }
+    PyObject* degree_object = PyLong_FromLongLong(degree);
+    if (degree_object == NULL) {
+      Py_DECREF(scale);
+      Py_DECREF(shift);
+      break;
+    }
+    Py_SETREF(shift, PyNumber_Multiply(shift, degree_object));
+    Py_DECREF(degree_object);
+    if (shift == NULL) {
+      Py_DECREF(scale);
+      break;
+    }
+    PyObject* scaled_numerator = PyNumber_Lshift(numerator, shift);
+    Py_DECREF(shift);
+    if (scaled_numerator == NULL) {
+      Py_DECREF(scale);
+      break;
+    }
+    Py_SETREF(scaled_numerator,
+              PyNumber_FloorDivide(scaled_numerator, denominator));
+    if (scaled_numerator == NULL) {
+      Py_DECREF(scale);
+      break;
+    }
+    PyObject* bounds_numerators[2] = {Long_root(scaled_numerator, degree),
+                                      NULL};
+    Py_DECREF(scaled_numerator);
+    if (bounds_numerators[0] != NULL)
+      bounds_numerators[1] = PyNumber_Add(bounds_numerators[0], one);
+    /* the root is strictly between `r / 2 ** p` and `(r + 1) / 2 ** p` */
+    for (size_t index = 0; index < 2; ++index) {
+      if (bounds_numerators[index] == NULL) break;
+      PyObject* bound_denominator = scale;
+      Py_INCREF(bound_denominator);
+      if (normalize_fraction_components_moduli(&bounds_numerators[index],
+                                               &bound_denominator) < 0) {
+        Py_DECREF(bound_denominator);
+        break;
+      }
+      FractionObject* bound = construct_fraction(
+          cls, bounds_numerators[index], bound_denominator);
+      bounds_numerators[index] = NULL;
+      if (bound == NULL) break;
+      bounds_approximations[index] =
+          fraction_limit_denominator_impl(bound, max_denominator);
+      Py_DECREF(bound);
+      if (bounds_approximations[index] == NULL) break;
+    }
+    Py_XDECREF(bounds_numerators[1]);
+    Py_XDECREF(bounds_numerators[0]);
+    Py_DECREF(scale);
+    if (bounds_approximations[1] == NULL) {
+      Py_XDECREF(bounds_approximations[0]);
+      break;
+    }
+    int are_equal = PyObject_RichCompareBool(
+        bounds_approximations[0]->numerator,
+        bounds_approximations[1]->numerator, Py_EQ);
+    if (are_equal > 0)
+      are_equal = PyObject_RichCompareBool(
+          bounds_approximations[0]->denominator,
+          bounds_approximations[1]->denominator, Py_EQ);
+    Py_DECREF(bounds_approximations[1]);
+    if (are_equal != 0) {
+      if (are_equal > 0)
+        result = bounds_approximations[0];
+      else
+        Py_DECREF(bounds_approximations[0]);
+      break;
+    }
+    Py_DECREF(bounds_approximations[0]);
+  }
+  Py_DECREF(one);
+  return result;
+}
+
+static FractionObject* fraction_root_impl(FractionObject* self,
+                                          long long degree,
+                                          PyObject* max_denominator) {
+  if (max_denominator == NULL)
+    max_denominator = PyLong_FromLong(1000000);
+  else {
+    max_denominator = PyNumber_Index(max_denominator);
+    if (max_denominator == NULL) return NULL;
+    if (validate_max_denominator(max_denominator) < 0) {
+      Py_DECREF(max_denominator);
+      return NULL;
+    }
+  }
+  if (max_denominator == NULL) return NULL;
+  FractionObject* result = NULL;
+  int is_negative = is_negative_py_object(self->numerator);
+  if (is_negative < 0) goto exit;
+  if (is_negative && degree % 2 == 0) {
+    PyErr_SetString(PyExc_ValueError,
+                    "Root of even degree should have non-negative base.");
+    goto exit;
+  }
+  PyObject* numerator_modulus = PyNumber_Absolute(self->numerator);
+  if (numerator_modulus == NULL) goto exit;
+  PyObject *root_denominator, *root_numerator;
+  int signal = Long_exact_root(numerator_modulus, degree, &root_numerator);
+  if (signal > 0) {
+    signal = Long_exact_root(self->denominator, degree, &root_denominator);
+    if (signal <= 0) Py_DECREF(root_numerator);
+  }
+  if (signal < 0) {
+    Py_DECREF(numerator_modulus);
+    goto exit;
+  } else if (signal) {
+    Py_DECREF(numerator_modulus);
+    if (is_negative) {
+      Py_SETREF(root_numerator, PyNumber_Negative(root_numerator));
+      if (root_numerator == NULL) {
+        Py_DECREF(root_denominator);
+        goto exit;
+      }
+    }
+    FractionObject* root =
+        construct_fraction(Py_TYPE(self), root_numerator, root_denominator);
+    if (root == NULL) goto exit;
+    result = fraction_limit_denominator_impl(root, max_denominator);
+    Py_DECREF(root);
+    goto exit;
+  }
+  result = Fractions_components_approximate_root(
+      Py_TYPE(self), numerator_modulus, self->denominator, degree,
+      max_denominator);
+  Py_DECREF(numerator_modulus);
+  if (result != NULL && is_negative)
+    Py_SETREF(result, fraction_negative(result));
+exit:
+  Py_DECREF(max_denominator);
+  return result;
+}
+
+static PyObject* fraction_root(FractionObject* self, PyObject* args,
+                               PyObject* kwargs) {
+  static char* keywords[] = {"", "max_denominator", NULL};
+  PyObject *degree_object, *max_denominator = NULL;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O:root", keywords,
+                                   &degree_object, &max_denominator))
+    return NULL;
+  if (!PyLong_Check(degree_object)) {
+    PyErr_Format(PyExc_TypeError, "Degree should be an integer, but got %R.",
+                 degree_object);
+    return NULL;
+  }
+  if (_PyLong_Sign(degree_object) <= 0) {
+    PyErr_SetString(PyExc_ValueError, "Degree should be positive.");
+    return NULL;
+  }
+  long long degree;
+  int signal = Long_to_int64(degree_object, &degree);
+  if (signal < 0) return NULL;
+  if (!signal) {
+    PyErr_SetString(PyExc_OverflowError, "Degree is too large.");
+    return NULL;
+  }
+  return (PyObject*)fraction_root_impl(self, degree, max_denominator);
+}
+
+static PyObject* fraction_sqrt(FractionObject* self, PyObject* args,
+                               PyObject* kwargs) {
+  static char* keywords[] = {"max_denominator", NULL};
+  PyObject* max_denominator = NULL;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O:sqrt", keywords,
+                                   &max_denominator))
+    return NULL;
+  return (PyObject*)fraction_root_impl(self, 2, max_denominator);
+}
+
+static PyObject* fraction_repr(FractionObject* self) {
+  return PyUnicode_FromFormat("Fraction(%R, %R)", self->numerator,
+                              self->denominator);
+}
+
+static PyObject* fraction_str(FractionObject* self) {
+  PyObject* tmp = PyLong_FromLong(1);
+  int comparison_signal =
+      PyObject_RichCompareBool(self->denominator, tmp, Py_EQ);
+  Py_DECREF(tmp);
+  if (comparison_signal < 0)
+    return NULL;
+  else
+    return comparison_signal ? PyUnicode_FromFormat("%S", self->numerator)
+                             : PyUnicode_FromFormat("%S/%S", self->numerator,
+                                                    self->denominator);
+}
+
+static const char digits_characters[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+static int digits_per_chunk(int base, unsigned long long* result_chunk_base) {
+  int result = 0;
+  unsigned long long chunk_base = 1;
+  while (chunk_base <= (unsigned long long)LLONG_MAX / (unsigned)base) {
+    chunk_base *= (unsigned)base;
+    ++result;
+  }
+  *result_chunk_base = chunk_base;
+  return result;
+}
+
+static PyObject* Long_to_PyUnicode(PyObject* value, int base,
+                                   Py_ssize_t min_size) {
+  unsigned long long chunk_base;
+  int chunk_size = digits_per_chunk(base, &chunk_base);
+  PyObject* chunk_base_object = PyLong_FromUnsignedLongLong(chunk_base);
+  if (chunk_base_object == NULL) return NULL;
+  unsigned long long* chunks = NULL;
+  Py_ssize_t chunks_capacity = 0, chunks_count = 0;
+  Py_INCREF(value);
+  while (1) {
+    int comparison_signal =
+        PyObject_RichCompareBool(value, chunk_base_object, Py_LT);
+    if (comparison_signal < 0)
+      goto error;
+    else if (comparison_signal)
+      break;
+    PyObject *quotient, *remainder;
+    if (Longs_divmod(value, chunk_base_object, &quotient, &remainder) < 0)
+      goto error;
+    Py_DECREF(value);
+    value = quotient;
+    unsigned long long chunk = PyLong_AsUnsignedLongLong(remainder);
+    Py_DECREF(remainder);
+    if (chunk == (unsigned long long)-1 && PyErr_Occurred()) goto error;
+    if (chunks_count == chunks_capacity) {
+      Py_ssize_t new_capacity = chunks_capacity ? 2 * chunks_capacity : 8;
+      unsigned long long* new_chunks =
+          PyMem_Resize(chunks, unsigned long long, (size_t)new_capacity);
+      if (new_chunks == NULL) {
+        PyErr_NoMemory();
+        goto error;
+      }
+      chunks = new_chunks;
+      chunks_capacity = new_capacity;
+    }
+    chunks[chunks_count++] = chunk;
+  }
+  unsigned long long head = PyLong_AsUnsignedLongLong(value);
+  if (head == (unsigned long long)-1 && PyErr_Occurred()) goto error;
+  Py_DECREF(value);
+  Py_DECREF(chunk_base_object);
+  Py_ssize_t head_size = 0;
+  for (unsigned long long tmp = head; tmp; tmp /= (unsigned)base) ++head_size;
+  Py_ssize_t size = head_size + chunks_count * chunk_size;
+  if (size < min_size) size = min_size;
+  if (size == 0) size = 1;
+  PyObject* result = PyUnicode_New(size, 127);
+  if (result == NULL) {
+    PyMem_Free(chunks);
+    return NULL;
+  }
+  Py_UCS1* data = PyUnicode_1BYTE_DATA(result);
+  Py_ssize_t position = size;
+  for (Py_ssize_t index = 0; index < chunks_count; ++index) {
+    unsigned long long chunk = chunks[index];
+    for (int offset = 0; offset < chunk_size; ++offset) {
+      data[--position] = (Py_UCS1)digits_characters[chunk % (unsigned)base];
+      chunk /= (unsigned)base;
+    }
+  }
+  PyMem_Free(chunks);
+  for (; head; head /= (unsigned)base)
+    data[--position] = (Py_UCS1)digits_characters[head % (unsigned)base];
+  while (position > 0) data[--position] = '0';
+  return result;
+error:
+  PyMem_Free(chunks);
+  Py_DECREF(value);
+  Py_DECREF(chunk_base_object);
+  return NULL;
+}
+
+static unsigned long long uint64_add_modulo(unsigned long long first,
+                                            unsigned long long second,
+                                            unsigned long long modulus) {
+  return first >= modulus - second ? first - (modulus - second)
+                                   : first + second;
+}
+
+/* Searches for the multiplicative order of the base modulo the modulus
+   (which should be coprime with the base and greater than one),
+   giving up once the limit (if it is non-negative) is exceeded. */
+static int Long_multiplicative_order(PyObject* modulus, int base,
+                                     Py_ssize_t limit, Py_ssize_t* result) {
+  if (_PyLong_NumBits(modulus) <= 64) {
+    unsigned long long modulus_value = PyLong_AsUnsignedLongLong(modulus);
+    if (modulus_value == (unsigned long long)-1 && PyErr_Occurred())
+      return -1;
+    unsigned long long power = (unsigned)base % modulus_value;
+    Py_ssize_t order = 1;
+    for (; power != 1; ++order) {
+      if (order >= limit && limit >= 0) return 0;
+      if (modulus_value <= ULLONG_MAX / (unsigned)base)
+        power = power * (unsigned)base % modulus_value;
+      else {
+        unsigned long long step = power;
+        for (int index = 1; index < base; ++index)
+          power = uint64_add_modulo(power, step, modulus_value);
+      }
+    }
+    if (order > limit && limit >= 0) return 0;
+    *result = order;
+    return 1;
+  }
+  PyObject* base_object = PyLong_FromLong(base);
+  if (base_object == NULL) return -1;
+  PyObject* power = PyNumber_Remainder(base_object, modulus);
+  if (power == NULL) {
+    Py_DECREF(base_object);
+    return -1;
+  }
+  Py_ssize_t order = 1;
+  int signal = 1;
+  while (1) {
+    int is_unit = is_unit_py_object_bool(power);
+    if (is_unit < 0) {
+      signal = -1;
+      break;
+    } else if (is_unit)
+      break;
+    if (order >= limit && limit >= 0) {
+      signal = 0;
+      break;
+    }
+    PyObject* tmp = PyNumber_Multiply(power, base_object);
+    Py_DECREF(power);
+    if (tmp == NULL) {
+      Py_DECREF(base_object);
+      return -1;
+    }
+    power = PyNumber_Remainder(tmp, modulus);
+    Py_DECREF(tmp);
+    if (power == NULL) {
+      Py_DECREF(base_object);
+      return -1;
+    }
+    ++order;
+  }
+  Py_DECREF(power);
+  Py_DECREF(base_object);
+  if (signal > 0 && order > limit && limit >= 0) signal = 0;
+  if (signal > 0) *result = order;
+  return signal;
+}
+
+static PyObject* Long_scaled_floor_divide(PyObject* dividend, PyObject* base,
+                                          Py_ssize_t exponent,
+                                          PyObject* divisor) {
+  PyObject* exponent_object = PyLong_FromSsize_t(exponent);
+  if (exponent_object == NULL) return NULL;
+  PyObject* scale = PyNumber_Power(base, exponent_object, Py_None);
+  Py_DECREF(exponent_object);
+  if (scale == NULL) return NULL;
+  PyObject* tmp = PyNumber_Multiply(dividend, scale);
+  Py_DECREF(scale);
+  if (tmp == NULL) return NULL;
+  PyObject* result = PyNumber_FloorDivide(tmp, divisor);
+  Py_DECREF(tmp);
+  return result;
+}
+
+static PyObject* fraction_to_truncated_PyUnicode(PyObject* sign,
+                                                 PyObject* integral_part,
+                                                 PyObject* remainder,
+                                                 PyObject* denominator,
+                                                 PyObject* base_object,
+                                                 int base,
+                                                 Py_ssize_t digits_count) {
+  PyObject* digits = Long_scaled_floor_divide(remainder, base_object,
+                                              digits_count, denominator);
+  if (digits == NULL) return NULL;
+  PyObject* digits_string =
+      digits_count ? Long_to_PyUnicode(digits, base, digits_count)
+                   : PyUnicode_FromString("");
+  Py_DECREF(digits);
+  if (digits_string == NULL) return NULL;
+  PyObject* result =
+      PyUnicode_FromFormat("%U%U.%U...", sign, integral_part, digits_string);
+  Py_DECREF(digits_string);
+  return result;
+}
+
+static PyObject* fraction_to_decimal_string(FractionObject* self,
+                                            PyObject* args,
+                                            PyObject* kwargs) {
+  static char* keywords[] = {"max_digits", "detect_period", "base", NULL};
+  PyObject* max_digits_object = Py_None;
+  int base = 10, detect_period = 1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O$pi:to_decimal_string",
+                                   keywords, &max_digits_object,
+                                   &detect_period, &base))
+    return NULL;
+  Py_ssize_t max_digits = -1;
+  if (max_digits_object != Py_None) {
+    if (!PyLong_Check(max_digits_object)) {
+      PyErr_SetString(PyExc_TypeError,
+                      "`max_digits` should be either an integer or `None`.");
+      return NULL;
+    }
+    max_digits = PyLong_AsSsize_t(max_digits_object);
+    if (max_digits == -1 && PyErr_Occurred()) return NULL;
+    if (max_digits < 0) {
+      PyErr_SetString(PyExc_ValueError,
+                      "`max_digits` should be non-negative.");
+      return NULL;
+    }
+  }
+  if (base < 2 || base > 36) {
+    PyErr_SetString(PyExc_ValueError,
+                    "`base` should be in range from 2 to 36.");
+    return NULL;
+  }
+  int is_negative = is_negative_fraction(self);
+  if (is_negative < 0) return NULL;
+  PyObject* numerator_modulus = PyNumber_Absolute(self->numerator);
+  if (numerator_modulus == NULL) return NULL;
+  PyObject *integral_part, *remainder;
+  int divmod_signal = Longs_divmod(numerator_modulus, self->denominator,
+                                   &integral_part, &remainder);
+  Py_DECREF(numerator_modulus);
+  if (divmod_signal < 0) return NULL;
+  PyObject* integral_part_string = Long_to_PyUnicode(integral_part, base, 0);
+  Py_DECREF(integral_part);
+  if (integral_part_string == NULL) {
+    Py_DECREF(remainder);
+    return NULL;
+  }
+  PyObject* sign = PyUnicode_FromString(is_negative ? "-" : "");
+  if (sign == NULL) {
+    Py_DECREF(integral_part_string);
+    Py_DECREF(remainder);
+    return NULL;
+  }
+  PyObject *base_object = NULL, *periodic_denominator = NULL, *prefix = NULL,
+           *prefix_string = NULL, *rest = NULL, *result = NULL;
+  if (PyObject_Not(remainder)) {
+    result = PyUnicode_FromFormat("%U%U", sign, integral_part_string);
+    goto finish;
+  }
+  base_object = PyLong_FromLong(base);
+  if (base_object == NULL) goto finish;
+  /* the length of non-repeating part equals to the number of steps
+     needed to strip all prime factors of the base from the denominator */
+  Py_ssize_t prefix_size = 0;
+  periodic_denominator = self->denominator;
+  Py_INCREF(periodic_denominator);
+  while (max_digits < 0 || prefix_size <= max_digits) {
+    PyObject* gcd = Longs_gcd(periodic_denominator, base_object);
+    if (gcd == NULL) goto finish;
+    int is_gcd_unit = is_unit_py_object_bool(gcd);
+    if (is_gcd_unit) {
+      Py_DECREF(gcd);
+      if (is_gcd_unit < 0) goto finish;
+      break;
+    }
+    PyObject* tmp = periodic_denominator;
+    periodic_denominator = PyNumber_FloorDivide(periodic_denominator, gcd);
+    Py_DECREF(tmp);
+    Py_DECREF(gcd);
+    if (periodic_denominator == NULL) goto finish;
+    ++prefix_size;
+  }
+  if (max_digits >= 0 && prefix_size > max_digits) {
+    result = fraction_to_truncated_PyUnicode(
+        sign, integral_part_string, remainder, self->denominator, base_object,
+        base, max_digits);
+    goto finish;
+  }
+  PyObject* prefix_size_object = PyLong_FromSsize_t(prefix_size);
+  if (prefix_size_object == NULL) goto finish;
+  PyObject* scale = PyNumber_Power(base_object, prefix_size_object, Py_None);
+  Py_DECREF(prefix_size_object);
+  if (scale == NULL) goto finish;
+  PyObject* scaled_remainder = PyNumber_Multiply(remainder, scale);
+  Py_DECREF(scale);
+  if (scaled_remainder == NULL) goto finish;
+  divmod_signal = Longs_divmod(scaled_remainder, self->denominator, &prefix,
+                               &rest);
+  Py_DECREF(scaled_remainder);
+  if (divmod_signal < 0) goto finish;
+  prefix_string = prefix_size ? Long_to_PyUnicode(prefix, base, prefix_size)
+                              : PyUnicode_FromString("");
+  if (prefix_string == NULL) goto finish;
+  if (PyObject_Not(rest)) {
+    result = PyUnicode_FromFormat("%U%U.%U", sign, integral_part_string,
+                                  prefix_string);
+    goto finish;
+  } else if (!detect_period) {
+    if (max_digits < 0)
+      PyErr_SetString(PyExc_ValueError,
+                      "Expansion is infinite, "
+                      "`max_digits` should be specified "
+                      "when period detection is disabled.");
+    else
+      result = fraction_to_truncated_PyUnicode(
+          sign, integral_part_string, remainder, self->denominator,
+          base_object, base, max_digits);
+    goto finish;
+  }
+  Py_ssize_t period_size;
+  int order_signal = Long_multiplicative_order(
+      periodic_denominator, base,
+      max_digits < 0 ? -1 : max_digits - prefix_size, &period_size);
+  if (order_signal < 0)
+    goto finish;
+  else if (!order_signal) {
+    result = fraction_to_truncated_PyUnicode(
+        sign, integral_part_string, remainder, self->denominator, base_object,
+        base, max_digits);
+    goto finish;
+  }
+  /* the period is the numerator of the purely periodic remainder
+     brought to the denominator of form `base ** period_size - 1` */
+  PyObject* period_size_object = PyLong_FromSsize_t(period_size);
+  if (period_size_object == NULL) goto finish;
+  PyObject* period_scale =
+      PyNumber_Power(base_object, period_size_object, Py_None);
+  Py_DECREF(period_size_object);
+  if (period_scale == NULL) goto finish;
+  PyObject* one = PyLong_FromLong(1);
+  if (one == NULL) {
+    Py_DECREF(period_scale);
+    goto finish;
+  }
+  PyObject* tmp = PyNumber_Subtract(period_scale, one);
+  Py_DECREF(one);
+  Py_DECREF(period_scale);
+  if (tmp == NULL) goto finish;
+  PyObject* scaled_rest = PyNumber_Multiply(rest, tmp);
+  Py_DECREF(tmp);
+  if (scaled_rest == NULL) goto finish;
+  PyObject* period = PyNumber_FloorDivide(scaled_rest, self->denominator);
+  Py_DECREF(scaled_rest);
+  if (period == NULL) goto finish;
+  PyObject* period_string = Long_to_PyUnicode(period, base, period_size);
+  Py_DECREF(period);
+  if (period_string == NULL) goto finish;
+  result = PyUnicode_FromFormat("%U%U.%U(%U)", sign, integral_part_string,
+                                prefix_string, period_string);
+  Py_DECREF(period_string);
+finish:
+  Py_XDECREF(rest);
+  Py_XDECREF(prefix_string);
+  Py_XDECREF(prefix);
+  Py_XDECREF(periodic_denominator);
+  Py_XDECREF(base_object);
+  Py_DECREF(sign);
+  Py_DECREF(integral_part_string);
+  Py_DECREF(remainder);
+  return result;
+}
+
+static PyObject* fraction_int(FractionObject* self) {
+  int is_negative = is_negative_fraction(self);
+  if (is_negative < 0)
+    return NULL;
+  else
+    return is_negative ? fraction_ceil_impl(self) : fraction_floor_impl(self);
+}
+
+static PyObject* fraction_trunc(FractionObject* self,
+                                PyObject* Py_UNUSED(args)) {
+  return fraction_int(self);
+}
+
+static PyMemberDef fraction_members[] = {
+    {"numerator", T_OBJECT_EX, offsetof(FractionObject, numerator), READONLY,
+     "Numerator of the fraction."},
+    {"denominator", T_OBJECT_EX, offsetof(FractionObject, denominator),
+     READONLY, "Denominator of the fraction."},
+    {NULL, 0, 0, 0, NULL} /* sentinel */
+};
+
+static PyMethodDef fraction_methods[] = {
+    {"as_integer_ratio", (PyCFunction)fraction_as_integer_ratio, METH_NOARGS,
+     NULL},
+    {"is_integer", (PyCFunction)fraction_is_integer, METH_NOARGS, NULL},
+    {"limit_denominator", (PyCFunction)fraction_limit_denominator, METH_VARARGS,
+     NULL},
+    {"continued_fraction", (PyCFunction)fraction_continued_fraction,
+     METH_NOARGS, NULL},
+    {"convergents", (PyCFunction)fraction_convergents, METH_NOARGS, NULL},
+    {"from_bytes", (PyCFunction)fraction_from_bytes, METH_O | METH_CLASS,
+     NULL},
+    {"from_continued_fraction", (PyCFunction)fraction_from_continued_fraction,
+     METH_O | METH_CLASS, NULL},
+    {"from_float_shortest", (PyCFunction)fraction_from_float_shortest,
+     METH_O | METH_CLASS, NULL},
+    {"quantize", (PyCFunction)(void (*)(void))fraction_quantize,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"root", (PyCFunction)(void (*)(void))fraction_root,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"sqrt", (PyCFunction)(void (*)(void))fraction_sqrt,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"to_bytes", (PyCFunction)fraction_to_bytes, METH_NOARGS, NULL},
+    {"to_decimal_string",
+     (PyCFunction)(void (*)(void))fraction_to_decimal_string,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"__ceil__", (PyCFunction)fraction_ceil, METH_NOARGS, NULL},
+    {"__copy__", (PyCFunction)fraction_copy, METH_NOARGS, NULL},
+    {"__deepcopy__", (PyCFunction)fraction_copy, METH_VARARGS, NULL},
+    {"__floor__", (PyCFunction)fraction_floor, METH_NOARGS, NULL},
+    {"__reduce__", (PyCFunction)fraction_reduce, METH_NOARGS, NULL},
+    {"__round__", (PyCFunction)fraction_round, METH_VARARGS, NULL},
+    {"__trunc__", (PyCFunction)fraction_trunc, METH_NOARGS, NULL},
+    {"_restore", (PyCFunction)(void (*)(void))fraction_restore,
+     METH_FASTCALL | METH_CLASS, NULL},
+    {"_unpickle", (PyCFunction)(void (*)(void))fraction_unpickle,
+     METH_FASTCALL | METH_CLASS, NULL},
+    {NULL, NULL, 0, NULL} /* sentinel */
+};
+
+/* Divides by `2 ** (shift + 1)` rounding half up. */
+static PyObject* Long_rounding_shift_right(PyObject* value, PyObject* shift,
+                                           PyObject* one) {
+  PyObject* doubled = PyNumber_Rshift(value, shift);
+  if (doubled == NULL) return NULL;
+  PyObject* tmp = PyNumber_Add(doubled, one);
+  Py_DECREF(doubled);
+  if (tmp == NULL) return NULL;
+  PyObject* result = PyNumber_Rshift(tmp, one);
+  Py_DECREF(tmp);
+  return result;
+}
+
+/* Divides components by the power of two which fits the denominator
+   in `max_bits`, rounding the numerator & truncating the denominator. */
+static FractionObject* fraction_truncate_bits(FractionObject* self,
+                                              size_t max_bits) {
+  size_t bits = _PyLong_NumBits(self->denominator);
+  if (bits == (size_t)-1 && PyErr_Occurred()) return NULL;
+  if (bits <= max_bits) {
+    Py_INCREF(self);
+    return self;
+  }
+  PyObject *numerator = NULL, *denominator = NULL,
+           *shift = PyLong_FromSize_t(bits - max_bits),
+           *one = PyLong_FromLong(1), *rounding_shift = NULL;
+  if (shift == NULL || one == NULL) goto error;
+  rounding_shift = PyNumber_Subtract(shift, one);
+  if (rounding_shift == NULL) goto error;
+  numerator = Long_rounding_shift_right(self->numerator, rounding_shift, one);
+  if (numerator == NULL) goto error;
+  denominator = PyNumber_Rshift(self->denominator, shift);
+  if (denominator == NULL ||
+      normalize_fraction_components_moduli(&numerator, &denominator) < 0)
+    goto error;
+  Py_DECREF(rounding_shift);
+  Py_DECREF(one);
+  Py_DECREF(shift);
+  return construct_fraction(Py_TYPE(self), numerator, denominator);
+error:
+  Py_XDECREF(denominator);
+  Py_XDECREF(numerator);
+  Py_XDECREF(rounding_shift);
+  Py_XDECREF(one);
+  Py_XDECREF(shift);
+  return NULL;
+}
+
+/* Snaps fractions resulting from arithmetic operations
+   to the precision of the innermost `precision_context`, if any,
+   steals a reference to the result. */
+static PyObject* fraction_limit_precision(PyObject* result) {
+  if (result == NULL || !is_fraction(result)) return result;
+  ModuleState* state = get_type_state(Py_TYPE(result));
+  if (!counter_load(&state->is_precision_used)) return result;
+  PyObject* precision;
+  if (PyContextVar_Get(state->precision, NULL, &precision) < 0) {
+    Py_DECREF(result);
+    return NULL;
+  }
+  if (precision == NULL) return result;
+  if (!PyTuple_CheckExact(precision) || PyTuple_GET_SIZE(precision) != 2) {
+    PyErr_Format(PyExc_TypeError,
+                 "Precision should be a pair of `max_denominator` "
+                 "& `max_bits`, but got %R.",
+                 precision);
+    Py_DECREF(precision);
+    Py_DECREF(result);
+    return NULL;
+  }
+  PyObject *max_denominator = PyTuple_GET_ITEM(precision, 0),
+           *max_bits = PyTuple_GET_ITEM(precision, 1);
+  if (max_bits != Py_None) {
+    size_t bits = PyLong_AsSize_t(max_bits);
+    Py_SETREF(result, bits == (size_t)-1 && PyErr_Occurred()
+                          ? NULL
+                          : (PyObject*)fraction_truncate_bits(
+                                (FractionObject*)result, bits));
+  }
+  if (result != NULL && max_denominator != Py_None)
+    Py_SETREF(result, (PyObject*)fraction_limit_denominator_impl(
+                          (FractionObject*)result, max_denominator));
+  Py_DECREF(precision);
+  return result;
+}
+
+#define DEFINE_PRECISION_LIMITED_BINARY_SLOT(name)              \
+  static PyObject* name(PyObject* self, PyObject* other) {      \
+    return fraction_limit_precision(name##_exact(self, other)); \
+  }
+
+DEFINE_PRECISION_LIMITED_BINARY_SLOT(fraction_add)
+DEFINE_PRECISION_LIMITED_BINARY_SLOT(fraction_multiply)
+DEFINE_PRECISION_LIMITED_BINARY_SLOT(fraction_subtract)
+DEFINE_PRECISION_LIMITED_BINARY_SLOT(fraction_true_divide)
+
+#ifdef CFRACTIONS_USDT
+static void to_operand_bits(PyObject* operand, size_t* numerator_bits,
+                            size_t* denominator_bits) {
+  if (is_fraction(operand)) {
+    *numerator_bits =
+        _PyLong_NumBits(((FractionObject*)operand)->numerator);
+    *denominator_bits =
+        _PyLong_NumBits(((FractionObject*)operand)->denominator);
+  } else if (PyLong_Check(operand)) {
+    *numerator_bits = _PyLong_NumBits(operand);
+    *denominator_bits = 1;
+  } else
+    *numerator_bits = *denominator_bits = 0;
+}
+
+static void probe_operation_entry(Operation operation, PyObject* first,
+                                  PyObject* second) {
+  if (!IS_PROBE_ENABLED(operation__entry)) return;
+  size_t bits[4];
+  to_operand_bits(first, &bits[0], &bits[1]);
+  to_operand_bits(second, &bits[2], &bits[3]);
+  PROBE(operation__entry, operations_names[operation], bits[0], bits[1],
+        bits[2], bits[3]);
+}
+
+static PyObject* probe_operation_return(Operation operation,
+                                        PyObject* result) {
+  if (!IS_PROBE_ENABLED(operation__return)) return result;
+  size_t bits[2] = {0, 0};
+  if (result != NULL) to_operand_bits(result, &bits[0], &bits[1]);
+  PROBE(operation__return, operations_names[operation], bits[0], bits[1]);
+  return result;
+}
+
+#define DEFINE_TRACED_BINARY_SLOT(name, operation)                  \
+  static PyObject* name##_traced(PyObject* self, PyObject* other) { \
+    probe_operation_entry(operation, self, other);                  \
+    return probe_operation_return(operation, name(self, other));    \
+  }
+#define TRACED_SLOT(name) name##_traced
+
+DEFINE_TRACED_BINARY_SLOT(fraction_add, OPERATION_ADD)
+DEFINE_TRACED_BINARY_SLOT(fraction_divmod, OPERATION_DIVMOD)
+DEFINE_TRACED_BINARY_SLOT(fraction_floor_divide, OPERATION_FLOOR_DIVIDE)
+DEFINE_TRACED_BINARY_SLOT(fraction_multiply, OPERATION_MULTIPLY)
+DEFINE_TRACED_BINARY_SLOT(fraction_remainder, OPERATION_REMAINDER)
+DEFINE_TRACED_BINARY_SLOT(fraction_subtract, OPERATION_SUBTRACT)
+DEFINE_TRACED_BINARY_SLOT(fraction_true_divide, OPERATION_TRUE_DIVIDE)
+
+static PyObject* fraction_power_traced(PyObject* self, PyObject* exponent,
+                                       PyObject* modulo) {
+  probe_operation_entry(OPERATION_POWER, self, exponent);
+  return probe_operation_return(OPERATION_POWER,
+                                fraction_power(self, exponent, modulo));
+}
+
+static PyObject* fraction_richcompare_traced(FractionObject* self,
+                                             PyObject* other, int op) {
+  probe_operation_entry(OPERATION_COMPARE, (PyObject*)self, other);
+  return probe_operation_return(OPERATION_COMPARE,
+                                fraction_richcompare(self, other, op));
+}
+#else
+#define TRACED_SLOT(name) name
+#endif
+
+static PyType_Slot fraction_slots[] = {
+    {Py_nb_absolute, (void*)fraction_absolute},
+    {Py_nb_add, (void*)TRACED_SLOT(fraction_add)},
+    {Py_nb_bool, (void*)fraction_bool},
+    {Py_nb_divmod, (void*)TRACED_SLOT(fraction_divmod)},
+    {Py_nb_float, (void*)fraction_float},
+    {Py_nb_floor_divide, (void*)TRACED_SLOT(fraction_floor_divide)},
+    {Py_nb_int, (void*)fraction_int},
+    {Py_nb_multiply, (void*)TRACED_SLOT(fraction_multiply)},
+    {Py_nb_negative, (void*)fraction_negative},
+    {Py_nb_positive, (void*)fraction_positive},
+    {Py_nb_power, (void*)TRACED_SLOT(fraction_power)},
+    {Py_nb_remainder, (void*)TRACED_SLOT(fraction_remainder)},
+    {Py_nb_subtract, (void*)TRACED_SLOT(fraction_subtract)},
+    {Py_nb_true_divide, (void*)TRACED_SLOT(fraction_true_divide)},
+    {Py_tp_dealloc, (void*)fraction_dealloc},
+    {Py_tp_doc, (void*)PyDoc_STR(
+                    "Represents rational numbers in the exact form.")},
+    {Py_tp_hash, (void*)fraction_hash},
+    {Py_tp_members, fraction_members},
+    {Py_tp_methods, fraction_methods},
+    {Py_tp_new, (void*)fraction_new},
+    {Py_tp_repr, (void*)fraction_repr},
+    {Py_tp_richcompare, (void*)TRACED_SLOT(fraction_richcompare)},
+    {Py_tp_str, (void*)fraction_str},
+    {0, NULL},
+};
+
+static PyType_Spec fraction_spec = {
+    .basicsize = sizeof(FractionObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE,
+    .name = "cfractions.Fraction",
+    .slots = fraction_slots,
+};
+
+/* Fractions with components reduced only when they are observed
+   (terms accessed, hashing, equality, string conversion, pickling)
+   or when they outgrow the bound inherited from operands,
+   so chains of arithmetic operations skip intermediate GCD computations.
+   Denominators are kept positive, so ordering & float conversion
+   work on unreduced components. */
+
+/* Components bit length below which reduction is never forced. */
+#define LAZY_FRACTION_MIN_REDUCTION_BITS 4096
+
+typedef struct {
+  PyObject_HEAD PyObject* numerator;
+  PyObject* denominator;
+  /* components bit length beyond which they are reduced eagerly */
+  size_t reduction_bits;
+  int is_reduced;
+} LazyFractionObject;
+
+static void lazy_fraction_dealloc(LazyFractionObject* self) {
+  PyTypeObject* type = Py_TYPE(self);
+  Py_DECREF(self->numerator);
+  Py_DECREF(self->denominator);
+  type->tp_free((PyObject*)self);
+  Py_DECREF(type);
+}
+
+static int is_lazy_fraction(PyObject* object) {
+  return Py_TYPE(object)->tp_dealloc == (destructor)lazy_fraction_dealloc;
+}
+
+static size_t Longs_components_bits(PyObject* numerator,
+                                    PyObject* denominator) {
+  return Py_MAX(_PyLong_NumBits(numerator), _PyLong_NumBits(denominator));
+}
+
+static size_t to_lazy_fraction_reduction_bits(PyObject* numerator,
+                                              PyObject* denominator) {
+  size_t bits = Longs_components_bits(numerator, denominator);
+  return Py_MAX(LAZY_FRACTION_MIN_REDUCTION_BITS, 2 * bits);
+}
+
+/* Steals references to components. */
+static LazyFractionObject* construct_lazy_fraction(PyTypeObject* cls,
+                                                   PyObject* numerator,
+                                                   PyObject* denominator,
+                                                   size_t reduction_bits,
+                                                   int is_reduced) {
+  if (!is_reduced &&
+      Longs_components_bits(numerator, denominator) > reduction_bits) {
+    if (normalize_fraction_components_moduli(&numerator, &denominator) < 0) {
+      Py_DECREF(denominator);
+      Py_DECREF(numerator);
+      return NULL;
+    }
+    is_reduced = 1;
+    reduction_bits = to_lazy_fraction_reduction_bits(numerator, denominator);
+  }
+  LazyFractionObject* result = (LazyFractionObject*)(cls->tp_alloc(cls, 0));
+  if (result == NULL) {
+    Py_DECREF(denominator);
+    Py_DECREF(numerator);
+    return NULL;
+  }
+  result->numerator = numerator;
+  result->denominator = denominator;
+  result->reduction_bits = reduction_bits;
+  result->is_reduced = is_reduced;
+  return result;
+}
+
+/* Components are replaced on reduction,
+   so they are read together to never mix up old & new ones. */
+static void lazy_fraction_get_components(LazyFractionObject* self,
+                                         PyObject** result_numerator,
+                                         PyObject** result_denominator,
+                                         size_t* result_reduction_bits,
+                                         int* result_is_reduced) {
+#ifdef Py_GIL_DISABLED
+  Py_BEGIN_CRITICAL_SECTION(self);
+#endif
+  Py_INCREF(self->numerator);
+  *result_numerator = self->numerator;
+  Py_INCREF(self->denominator);
+  *result_denominator = self->denominator;
+  *result_reduction_bits = self->reduction_bits;
+  *result_is_reduced = self->is_reduced;
+#ifdef Py_GIL_DISABLED
+  Py_END_CRITICAL_SECTION();
+#endif
+}
+
+/* Returns new references to reduced components
+   and stores them in the object for subsequent observations. */
+static int lazy_fraction_reduce(LazyFractionObject* self,
+                                PyObject** result_numerator,
+                                PyObject** result_denominator) {
+  PyObject *numerator, *denominator;
+  size_t reduction_bits;
+  int is_reduced;
+  lazy_fraction_get_components(self, &numerator, &denominator,
+                               &reduction_bits, &is_reduced);
+  if (!is_reduced) {
+    if (normalize_fraction_components_moduli(&numerator, &denominator) < 0) {
+      Py_DECREF(denominator);
+      Py_DECREF(numerator);
+      return -1;
+    }
+    PyObject *old_numerator, *old_denominator;
+#ifdef Py_GIL_DISABLED
+    Py_BEGIN_CRITICAL_SECTION(self);
+#endif
+    old_numerator = self->numerator;
+    old_denominator = self->denominator;
+    Py_INCREF(numerator);
+    self->numerator = numerator;
+    Py_INCREF(denominator);
+    self->denominator = denominator;
+    self->reduction_bits =
+        to_lazy_fraction_reduction_bits(numerator, denominator);
+    self->is_reduced = 1;
+#ifdef Py_GIL_DISABLED
+    Py_END_CRITICAL_SECTION();
+#endif
+    Py_DECREF(old_denominator);
+    Py_DECREF(old_numerator);
+  }
+  *result_numerator = numerator;
+  *result_denominator = denominator;
+  return 0;
+}
+
+static PyObject* lazy_fraction_to_fraction(LazyFractionObject* self,
+                                           PyObject* Py_UNUSED(args)) {
+  PyObject *numerator, *denominator;
+  if (lazy_fraction_reduce(self, &numerator, &denominator) < 0) return NULL;
+  return (PyObject*)construct_fraction(
+      get_type_state(Py_TYPE(self))->fraction_type, numerator, denominator);
+}
+
+/* Returns 1 with new references to components of lazy fractions,
+   fractions & integers, 0 for other operands. */
+static int parse_lazy_fraction_operand(PyObject* operand,
+                                       PyObject** result_numerator,
+                                       PyObject** result_denominator,
+                                       size_t* result_reduction_bits) {
+  if (is_lazy_fraction(operand)) {
+    int is_reduced;
+    lazy_fraction_get_components((LazyFractionObject*)operand,
+                                 result_numerator, result_denominator,
+                                 result_reduction_bits, &is_reduced);
+    return 1;
+  } else if (is_fraction(operand)) {
+    FractionObject* fraction = (FractionObject*)operand;
+    Py_INCREF(fraction->numerator);
+    *result_numerator = fraction->numerator;
+    Py_INCREF(fraction->denominator);
+    *result_denominator = fraction->denominator;
+  } else if (PyLong_Check(operand)) {
+    *result_denominator = PyLong_FromLong(1);
+    if (*result_denominator == NULL) return -1;
+    Py_INCREF(operand);
+    *result_numerator = operand;
+  } else
+    return 0;
+  *result_reduction_bits =
+      to_lazy_fraction_reduction_bits(*result_numerator, *result_denominator);
+  return 1;
+}
+
+static PyObject* Longs_cross_combine(PyObject* first_numerator,
+                                     PyObject* first_denominator,
+                                     PyObject* second_numerator,
+                                     PyObject* second_denominator,
+                                     binaryfunc combine) {
+  PyObject* first = Longs_multiply(first_numerator, second_denominator);
+  if (first == NULL) return NULL;
+  PyObject* second = Longs_multiply(second_numerator, first_denominator);
+  if (second == NULL) {
+    Py_DECREF(first);
+    return NULL;
+  }
+  PyObject* result = combine(first, second);
+  Py_DECREF(second);
+  Py_DECREF(first);
+  return result;
+}
+
+static int Longs_components_operation(
+    Operation operation, PyObject* first_numerator,
+    PyObject* first_denominator, PyObject* second_numerator,
+    PyObject* second_denominator, PyObject** result_numerator,
+    PyObject** result_denominator) {
+  PyObject *numerator, *denominator;
+  switch (operation) {
+    case OPERATION_ADD:
+    case OPERATION_SUBTRACT:
+      numerator = Longs_cross_combine(
+          first_numerator, first_denominator, second_numerator,
+          second_denominator,
+          operation == OPERATION_ADD ? PyNumber_Add : PyNumber_Subtract);
+      if (numerator == NULL) return -1;
+      denominator = Longs_multiply(first_denominator, second_denominator);
+      break;
+    case OPERATION_MULTIPLY:
+      numerator = Longs_multiply(first_numerator, second_numerator);
+      if (numerator == NULL) return -1;
+      denominator = Longs_multiply(first_denominator, second_denominator);
+      break;
+    default: {
+      int sign = _PyLong_Sign(second_numerator);
+      if (!sign) {
+        PyErr_Format(PyExc_ZeroDivisionError, "LazyFraction(%S, 0)",
+                     first_numerator);
+        return -1;
+      }
+      numerator = Longs_multiply(first_numerator, second_denominator);
+      if (numerator == NULL) return -1;
+      denominator = Longs_multiply(first_denominator, second_numerator);
+      if (denominator != NULL && sign < 0) {
+        if (normalize_fraction_components_signs(&numerator, &denominator) <
+            0) {
+          Py_DECREF(denominator);
+          Py_DECREF(numerator);
+          return -1;
+        }
+      }
+    }
+  }
+  if (denominator == NULL) {
+    Py_DECREF(numerator);
+    return -1;
+  }
+  *result_numerator = numerator;
+  *result_denominator = denominator;
+  return 0;
+}
+
+static PyObject* lazy_fraction_operand_to_fraction(PyObject* operand) {
+  if (is_lazy_fraction(operand))
+    return lazy_fraction_to_fraction((LazyFractionObject*)operand, NULL);
+  Py_INCREF(operand);
+  return operand;
+}
+
+/* Operands which are neither lazy fractions, fractions nor integers
+   as well as operations beyond the field ones are handled by fractions. */
+static PyObject* lazy_fraction_binary_operation_fallback(PyObject* first,
+                                                         PyObject* second,
+                                                         binaryfunc function) {
+  PyObject* first_operand = lazy_fraction_operand_to_fraction(first);
+  if (first_operand == NULL) return NULL;
+  PyObject* second_operand = lazy_fraction_operand_to_fraction(second);
+  if (second_operand == NULL) {
+    Py_DECREF(first_operand);
+    return NULL;
+  }
+  PyObject* result = function(first_operand, second_operand);
+  Py_DECREF(second_operand);
+  Py_DECREF(first_operand);
+  return result;
+}
+
+static PyObject* lazy_fraction_binary_operation(Operation operation,
+                                                PyObject* first,
+                                                PyObject* second,
+                                                binaryfunc fallback) {
+  PyTypeObject* cls = Py_TYPE(is_lazy_fraction(first) ? first : second);
+  PyObject *components[4], *result_numerator, *result_denominator;
+  size_t reduction_bits[2];
+  int signal = parse_lazy_fraction_operand(first, &components[0],
+                                           &components[1], &reduction_bits[0]);
+  if (signal < 0) return NULL;
+  if (!signal)
+    return lazy_fraction_binary_operation_fallback(first, second, fallback);
+  signal = parse_lazy_fraction_operand(second, &components[2], &components[3],
+                                       &reduction_bits[1]);
+  if (signal <= 0) {
+    Py_DECREF(components[1]);
+    Py_DECREF(components[0]);
+    return signal < 0 ? NULL
+                      : lazy_fraction_binary_operation_fallback(first, second,
+                                                                fallback);
+  }
+  signal = Longs_components_operation(
+      operation, components[0], components[1], components[2], components[3],
+      &result_numerator, &result_denominator);
+  for (size_t index = 0; index < 4; ++index) Py_DECREF(components[index]);
+  if (signal < 0) return NULL;
+  return (PyObject*)construct_lazy_fraction(
+      cls, result_numerator, result_denominator,
+      Py_MAX(reduction_bits[0], reduction_bits[1]), 0);
+}
+
+static PyObject* lazy_fraction_add(PyObject* self, PyObject* other) {
+  return lazy_fraction_binary_operation(OPERATION_ADD, self, other,
+                                        PyNumber_Add);
+}
+
+static PyObject* lazy_fraction_subtract(PyObject* self, PyObject* other) {
+  return lazy_fraction_binary_operation(OPERATION_SUBTRACT, self, other,
+                                        PyNumber_Subtract);
+}
+
+static PyObject* lazy_fraction_multiply(PyObject* self, PyObject* other) {
+  return lazy_fraction_binary_operation(OPERATION_MULTIPLY, self, other,
+                                        PyNumber_Multiply);
+}
+
+static PyObject* lazy_fraction_true_divide(PyObject* self, PyObject* other) {
+  return lazy_fraction_binary_operation(OPERATION_TRUE_DIVIDE, self, other,
+                                        PyNumber_TrueDivide);
+}
+
+static PyObject* lazy_fraction_divmod(PyObject* self, PyObject* other) {
+  return lazy_fraction_binary_operation_fallback(self, other, PyNumber_Divmod);
+}
+
+static PyObject* lazy_fraction_floor_divide(PyObject* self, PyObject* other) {
+  return lazy_fraction_binary_operation_fallback(self, other,
+                                                 PyNumber_FloorDivide);
+}
+
+static PyObject* lazy_fraction_remainder(PyObject* self, PyObject* other) {
+  return lazy_fraction_binary_operation_fallback(self, other,
+                                                 PyNumber_Remainder);
+}
+
+static PyObject* lazy_fraction_power(PyObject* base, PyObject* exponent,
+                                     PyObject* modulo) {
+  PyObject* base_operand = lazy_fraction_operand_to_fraction(base);
+  if (base_operand == NULL) return NULL;
+  PyObject* exponent_operand = lazy_fraction_operand_to_fraction(exponent);
+  if (exponent_operand == NULL) {
+    Py_DECREF(base_operand);
+    return NULL;
+  }
+  PyObject* result = PyNumber_Power(base_operand, exponent_operand, modulo);
+  Py_DECREF(exponent_operand);
+  Py_DECREF(base_operand);
+  return result;
+}
+
+static PyObject* lazy_fraction_negative(LazyFractionObject* self) {
+  PyObject *numerator, *denominator;
+  size_t reduction_bits;
+  int is_reduced;
+  lazy_fraction_get_components(self, &numerator, &denominator,
+                               &reduction_bits, &is_reduced);
+  PyObject* tmp = numerator;
+  numerator = PyNumber_Negative(numerator);
+  Py_DECREF(tmp);
+  if (numerator == NULL) {
+    Py_DECREF(denominator);
+    return NULL;
+  }
+  return (PyObject*)construct_lazy_fraction(
+      Py_TYPE(self), numerator, denominator, reduction_bits, is_reduced);
+}
+
+static PyObject* lazy_fraction_positive(LazyFractionObject* self) {
+  Py_INCREF(self);
+  return (PyObject*)self;
+}
+
+static int lazy_fraction_sign(LazyFractionObject* self) {
+  PyObject *numerator, *denominator;
+  size_t reduction_bits;
+  int is_reduced;
+  lazy_fraction_get_components(self, &numerator, &denominator,
+                               &reduction_bits, &is_reduced);
+  int result = _PyLong_Sign(numerator);
+  Py_DECREF(denominator);
+  Py_DECREF(numerator);
+  return result;
+}
+
+static PyObject* lazy_fraction_absolute(LazyFractionObject* self) {
+  return lazy_fraction_sign(self) < 0 ? lazy_fraction_negative(self)
+                                      : lazy_fraction_positive(self);
+}
+
+static int lazy_fraction_bool(LazyFractionObject* self) {
+  return lazy_fraction_sign(self) != 0;
+}
+
+static PyObject* lazy_fraction_float(LazyFractionObject* self) {
+  PyObject *numerator, *denominator;
+  size_t reduction_bits;
+  int is_reduced;
+  lazy_fraction_get_components(self, &numerator, &denominator,
+                               &reduction_bits, &is_reduced);
+  PyObject* result = PyNumber_TrueDivide(numerator, denominator);
+  Py_DECREF(denominator);
+  Py_DECREF(numerator);
+  return result;
+}
+
+/* Rounds the quotient of components without reducing them. */
+static PyObject* lazy_fraction_divide_rounding(LazyFractionObject* self,
+                                               RoundingMode mode) {
+  PyObject *numerator, *denominator;
+  size_t reduction_bits;
+  int is_reduced;
+  lazy_fraction_get_components(self, &numerator, &denominator,
+                               &reduction_bits, &is_reduced);
+  PyObject* result = Longs_divide_rounding(numerator, denominator, mode);
+  Py_DECREF(denominator);
+  Py_DECREF(numerator);
+  return result;
+}
+
+static PyObject* lazy_fraction_ceil(LazyFractionObject* self,
+                                    PyObject* Py_UNUSED(args)) {
+  return lazy_fraction_divide_rounding(self, ROUND_CEILING);
+}
+
+static PyObject* lazy_fraction_floor(LazyFractionObject* self,
+                                     PyObject* Py_UNUSED(args)) {
+  return lazy_fraction_divide_rounding(self, ROUND_FLOOR);
+}
+
+static PyObject* lazy_fraction_int(LazyFractionObject* self) {
+  return lazy_fraction_divide_rounding(self, ROUND_DOWN);
+}
+
+static PyObject* lazy_fraction_trunc(LazyFractionObject* self,
+                                     PyObject* Py_UNUSED(args)) {
+  return lazy_fraction_int(self);
+}
+
+static PyObject* lazy_fraction_round(LazyFractionObject* self, PyObject* args) {
+  PyObject* precision_object = Py_None;
+  if (!PyArg_ParseTuple(args, "|O", &precision_object)) return NULL;
+  if (precision_object == Py_None)
+    return lazy_fraction_divide_rounding(self, ROUND_HALF_EVEN);
+  PyObject* fraction = lazy_fraction_to_fraction(self, NULL);
+  if (fraction == NULL) return NULL;
+  PyObject* result = fraction_round((FractionObject*)fraction, args);
+  Py_DECREF(fraction);
+  return result;
+}
+
+static PyObject* lazy_fraction_limit_denominator(LazyFractionObject* self,
+                                                 PyObject* args) {
+  PyObject* fraction = lazy_fraction_to_fraction(self, NULL);
+  if (fraction == NULL) return NULL;
+  PyObject* result =
+      fraction_limit_denominator((FractionObject*)fraction, args);
+  Py_DECREF(fraction);
+  return result;
+}
+
+static Py_hash_t lazy_fraction_hash(LazyFractionObject* self) {
+  /* should be equal to the hash of the equal fraction */
+  PyObject* fraction = lazy_fraction_to_fraction(self, NULL);
+  if (fraction == NULL) return -1;
+  Py_hash_t result = PyObject_Hash(fraction);
+  Py_DECREF(fraction);
+  return result;
+}
+
+static PyObject* lazy_fraction_richcompare(LazyFractionObject* self,
+                                           PyObject* other, int op) {
+  PyObject *components[4];
+  size_t reduction_bits;
+  int signal = 1;
+  if (op == Py_EQ || op == Py_NE) {
+    /* reduced components are unique, so they are compared directly */
+    if (lazy_fraction_reduce(self, &components[0], &components[1]) < 0)
+      return NULL;
+    if (is_lazy_fraction(other))
+      signal = lazy_fraction_reduce((LazyFractionObject*)other,
+                                    &components[2], &components[3]) < 0
+                   ? -1
+                   : 1;
+    else
+      signal = parse_lazy_fraction_operand(other, &components[2],
+                                           &components[3], &reduction_bits);
+  } else {
+    signal = parse_lazy_fraction_operand((PyObject*)self, &components[0],
+                                         &components[1], &reduction_bits);
+    if (signal > 0)
+      signal = parse_lazy_fraction_operand(other, &components[2],
+                                           &components[3], &reduction_bits);
+  }
+  if (signal <= 0) {
+    Py_DECREF(components[1]);
+    Py_DECREF(components[0]);
+    if (signal < 0) return NULL;
+    PyObject* fraction = lazy_fraction_to_fraction(self, NULL);
+    if (fraction == NULL) return NULL;
+    PyObject* result = PyObject_RichCompare(fraction, other, op);
+    Py_DECREF(fraction);
+    return result;
+  }
+  PyObject* result;
+  if (op == Py_EQ || op == Py_NE) {
+    int is_equal =
+        PyObject_RichCompareBool(components[0], components[2], Py_EQ);
+    if (is_equal > 0)
+      is_equal = PyObject_RichCompareBool(components[1], components[3], Py_EQ);
+    result = is_equal < 0 ? NULL : PyBool_FromLong(is_equal == (op == Py_EQ));
+  } else {
+    /* denominators are positive */
+    PyObject* first = Longs_multiply(components[0], components[3]);
+    PyObject* second =
+        first == NULL ? NULL : Longs_multiply(components[2], components[1]);
+    result = second == NULL ? NULL : PyObject_RichCompare(first, second, op);
+    Py_XDECREF(second);
+    Py_XDECREF(first);
+  }
+  for (size_t index = 0; index < 4; ++index) Py_DECREF(components[index]);
+  return result;
+}
+
+static PyObject* lazy_fraction_numerator(LazyFractionObject* self,
+                                         void* Py_UNUSED(closure)) {
+  PyObject *numerator, *denominator;
+  if (lazy_fraction_reduce(self, &numerator, &denominator) < 0) return NULL;
+  Py_DECREF(denominator);
+  return numerator;
+}
+
+static PyObject* lazy_fraction_denominator(LazyFractionObject* self,
+                                           void* Py_UNUSED(closure)) {
+  PyObject *numerator, *denominator;
+  if (lazy_fraction_reduce(self, &numerator, &denominator) < 0) return NULL;
+  Py_DECREF(numerator);
+  return denominator;
+}
+
+static PyObject* lazy_fraction_copy(LazyFractionObject* self,
+                                    PyObject* Py_UNUSED(args)) {
+  Py_INCREF(self);
+  return (PyObject*)self;
+}
+
+static PyObject* lazy_fraction_as_integer_ratio(LazyFractionObject* self,
+                                                PyObject* Py_UNUSED(args)) {
+  PyObject *numerator, *denominator;
+  if (lazy_fraction_reduce(self, &numerator, &denominator) < 0) return NULL;
+  return Py_BuildValue("NN", numerator, denominator);
+}
+
+static PyObject* lazy_fraction_reduce_method(LazyFractionObject* self,
+                                             PyObject* Py_UNUSED(args)) {
+  PyObject *numerator, *denominator;
+  if (lazy_fraction_reduce(self, &numerator, &denominator) < 0) return NULL;
+  return Py_BuildValue("O(NN)", Py_TYPE(self), numerator, denominator);
+}
+
+static PyObject* lazy_fraction_repr(LazyFractionObject* self) {
+  PyObject *numerator, *denominator;
+  if (lazy_fraction_reduce(self, &numerator, &denominator) < 0) return NULL;
+  PyObject* result =
+      PyUnicode_FromFormat("LazyFraction(%R, %R)", numerator, denominator);
+  Py_DECREF(denominator);
+  Py_DECREF(numerator);
+  return result;
+}
+
+static PyObject* lazy_fraction_str(LazyFractionObject* self) {
+  PyObject* fraction = lazy_fraction_to_fraction(self, NULL);
+  if (fraction == NULL) return NULL;
+  PyObject* result = PyObject_Str(fraction);
+  Py_DECREF(fraction);
+  return result;
+}
+
+static PyObject* lazy_fraction_new(PyTypeObject* cls, PyObject* args,
+                                   PyObject* kwargs) {
+  if (are_kwargs_passed(kwargs)) {
+    PyErr_Format(PyExc_TypeError,
+                 "LazyFraction() takes no keyword arguments");
+    return NULL;
+  }
+  PyObject *numerator = NULL, *denominator = NULL;
+  if (!PyArg_ParseTuple(args, "|OO", &numerator, &denominator)) return NULL;
+  if (denominator != NULL && PyLong_Check(numerator) &&
+      PyLong_Check(denominator)) {
+    if (!_PyLong_Sign(denominator)) {
+      PyErr_SetString(PyExc_ZeroDivisionError,
+                      "Denominator should be non-zero.");
+      return NULL;
+    }
+    Py_INCREF(numerator);
+    Py_INCREF(denominator);
+    if (normalize_fraction_components_signs(&numerator, &denominator) < 0) {
+      Py_DECREF(denominator);
+      Py_DECREF(numerator);
+      return NULL;
+    }
+    return (PyObject*)construct_lazy_fraction(
+        cls, numerator, denominator,
+        to_lazy_fraction_reduction_bits(numerator, denominator), 0);
+  }
+  if (denominator == NULL && numerator != NULL &&
+      is_lazy_fraction(numerator)) {
+    Py_INCREF(numerator);
+    return numerator;
+  }
+  /* everything else is parsed as a fraction */
+  PyObject* fraction =
+      PyObject_Call((PyObject*)get_type_state(cls)->fraction_type, args, NULL);
+  if (fraction == NULL) return NULL;
+  numerator = ((FractionObject*)fraction)->numerator;
+  Py_INCREF(numerator);
+  denominator = ((FractionObject*)fraction)->denominator;
+  Py_INCREF(denominator);
+  Py_DECREF(fraction);
+  return (PyObject*)construct_lazy_fraction(
+      cls, numerator, denominator,
+      to_lazy_fraction_reduction_bits(numerator, denominator), 1);
+}
+
+static PyGetSetDef lazy_fraction_getset[] = {
+    {"numerator", (getter)lazy_fraction_numerator, NULL,
+     "Numerator of the fraction in lowest terms.", NULL},
+    {"denominator", (getter)lazy_fraction_denominator, NULL,
+     "Denominator of the fraction in lowest terms.", NULL},
+    {NULL, NULL, NULL, NULL, NULL} /* sentinel */
+};
+
+static PyMethodDef lazy_fraction_methods[] = {
+    {"__ceil__", (PyCFunction)lazy_fraction_ceil, METH_NOARGS, NULL},
+    {"__copy__", (PyCFunction)lazy_fraction_copy, METH_NOARGS, NULL},
+    {"__deepcopy__", (PyCFunction)lazy_fraction_copy, METH_VARARGS, NULL},
+    {"__floor__", (PyCFunction)lazy_fraction_floor, METH_NOARGS, NULL},
+    {"__reduce__", (PyCFunction)lazy_fraction_reduce_method, METH_NOARGS,
+     NULL},
+    {"__round__", (PyCFunction)lazy_fraction_round, METH_VARARGS, NULL},
+    {"__trunc__", (PyCFunction)lazy_fraction_trunc, METH_NOARGS, NULL},
+    {"as_integer_ratio", (PyCFunction)lazy_fraction_as_integer_ratio,
+     METH_NOARGS, NULL},
+    {"limit_denominator", (PyCFunction)lazy_fraction_limit_denominator,
+     METH_VARARGS, NULL},
+    {"to_fraction", (PyCFunction)lazy_fraction_to_fraction, METH_NOARGS,
+     NULL},
+    {NULL, NULL, 0, NULL} /* sentinel */
+};
+
+static PyType_Slot lazy_fraction_slots[] = {
+    {Py_nb_absolute, (void*)lazy_fraction_absolute},
+    {Py_nb_add, (void*)lazy_fraction_add},
+    {Py_nb_bool, (void*)lazy_fraction_bool},
+    {Py_nb_divmod, (void*)lazy_fraction_divmod},
+    {Py_nb_float, (void*)lazy_fraction_float},
+    {Py_nb_floor_divide, (void*)lazy_fraction_floor_divide},
+    {Py_nb_int, (void*)lazy_fraction_int},
+    {Py_nb_multiply, (void*)lazy_fraction_multiply},
+    {Py_nb_negative, (void*)lazy_fraction_negative},
+    {Py_nb_positive, (void*)lazy_fraction_positive},
+    {Py_nb_power, (void*)lazy_fraction_power},
+    {Py_nb_remainder, (void*)lazy_fraction_remainder},
+    {Py_nb_subtract, (void*)lazy_fraction_subtract},
+    {Py_nb_true_divide, (void*)lazy_fraction_true_divide},
+    {Py_tp_dealloc, (void*)lazy_fraction_dealloc},
+    {Py_tp_doc,
+     (void*)PyDoc_STR("Represents rational numbers with components reduced "
+                      "only when they are observed.")},
+    {Py_tp_getset, lazy_fraction_getset},
+    {Py_tp_hash, (void*)lazy_fraction_hash},
+    {Py_tp_methods, lazy_fraction_methods},
+    {Py_tp_new, (void*)lazy_fraction_new},
+    {Py_tp_repr, (void*)lazy_fraction_repr},
+    {Py_tp_richcompare, (void*)lazy_fraction_richcompare},
+    {Py_tp_str, (void*)lazy_fraction_str},
+    {0, NULL},
+};
+
+static PyType_Spec lazy_fraction_spec = {
+    .basicsize = sizeof(LazyFractionObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE,
+    .name = "cfractions.LazyFraction",
+    .slots = lazy_fraction_slots,
+};
+
+static PyObject* dumps_many(PyObject* Py_UNUSED(module), PyObject* values) {
+  PyObject* sequence =
+      sequence_fast_snapshot(values,
+                             "Values should be an iterable of fractions.");
+  if (sequence == NULL) return NULL;
+  Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
+  PyObject** items = PySequence_Fast_ITEMS(sequence);
+  BytesWriter writer = {NULL, 0, 0};
+  if (bytes_writer_reserve(&writer, MAX_VARINT_SIZE) < 0) goto error;
+  bytes_writer_write_varint(&writer, (unsigned long long)size);
+  for (Py_ssize_t index = 0; index < size; ++index) {
+    PyObject* item = items[index];
+    if (is_fraction(item)) {
+      if (bytes_writer_write_fraction(&writer, (FractionObject*)item) < 0)
+        goto error;
+    } else if (PyLong_Check(item)) {
+      if (bytes_writer_write_term(&writer, item) < 0 ||
+          bytes_writer_reserve(&writer, 1) < 0)
+        goto error;
+      bytes_writer_write_varint(&writer, 1ULL << 2);
+    } else {
+      PyErr_Format(PyExc_TypeError,
+                   "Values should be fractions or integers, but got %R.",
+                   item);
+      goto error;
+    }
+  }
+  Py_DECREF(sequence);
+  PyObject* result =
+      PyBytes_FromStringAndSize((const char*)writer.data, writer.size);
+  PyMem_Free(writer.data);
+  return result;
+error:
+  PyMem_Free(writer.data);
+  Py_DECREF(sequence);
+  return NULL;
+}
+
+static PyObject* loads_many(PyObject* module, PyObject* data) {
+  Py_buffer buffer;
+  if (PyObject_GetBuffer(data, &buffer, PyBUF_SIMPLE) < 0) return NULL;
+  BytesReader reader = {buffer.buf, 0, buffer.len};
+  unsigned long long size;
+  if (bytes_reader_read_varint(&reader, &size) < 0) {
+    PyBuffer_Release(&buffer);
+    return NULL;
+  }
+  /* each fraction takes at least two bytes */
+  if (size > (unsigned long long)(reader.size - reader.position) / 2) {
+    PyBuffer_Release(&buffer);
+    PyErr_SetString(PyExc_ValueError, "Data is truncated.");
+    return NULL;
+  }
+  PyObject* result = PyList_New((Py_ssize_t)size);
+  if (result == NULL) {
+    PyBuffer_Release(&buffer);
+    return NULL;
+  }
+  for (Py_ssize_t index = 0; index < (Py_ssize_t)size; ++index) {
+    FractionObject* item = bytes_reader_read_fraction(
+        &reader, get_module_state(module)->fraction_type);
+    if (item == NULL) {
+      Py_DECREF(result);
+      PyBuffer_Release(&buffer);
+      return NULL;
+    }
+    PyList_SET_ITEM(result, index, (PyObject*)item);
+  }
+  if (reader.position != reader.size) {
+    Py_DECREF(result);
+    PyBuffer_Release(&buffer);
+    PyErr_SetString(PyExc_ValueError, "Data has trailing bytes.");
+    return NULL;
+  }
+  PyBuffer_Release(&buffer);
+  return result;
+}
+
+static PyObject* quantize_many(PyObject* module, PyObject* args,
+                               PyObject* kwargs) {
+  static char* keywords[] = {"", "", "rounding", NULL};
+  PyObject *values, *step, *rounding_object = NULL;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|O:quantize_many",
+                                   keywords, &values, &step, &rounding_object))
+    return NULL;
+  RoundingMode mode = ROUND_HALF_EVEN;
+  if (rounding_object != NULL &&
+      parse_rounding_mode(rounding_object, &mode) < 0)
+    return NULL;
+  PyTypeObject* cls = get_module_state(module)->fraction_type;
+  PyObject *step_numerator, *step_denominator;
+  if (parse_quantization_step(cls, step, &step_numerator, &step_denominator) <
+      0)
+    return NULL;
+  PyObject *sequence = NULL, *result = NULL,
+           *one = PyLong_FromLong(1);
+  if (one == NULL) goto error;
+  sequence =
+      sequence_fast_snapshot(values,
+                             "Values should be an iterable of fractions.");
+  if (sequence == NULL) goto error;
+  Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
+  PyObject** items = PySequence_Fast_ITEMS(sequence);
+  result = PyList_New(size);
+  if (result == NULL) goto error;
+  for (Py_ssize_t index = 0; index < size; ++index) {
+    PyObject* item = items[index];
+    FractionObject* element;
+    if (is_fraction(item))
+      element = Fractions_components_quantize(
+          cls, ((FractionObject*)item)->numerator,
+          ((FractionObject*)item)->denominator, step_numerator,
+          step_denominator, mode);
+    else if (PyLong_Check(item))
+      element = Fractions_components_quantize(cls, item, one, step_numerator,
+                                              step_denominator, mode);
+    else {
+      PyErr_Format(PyExc_TypeError,
+                   "Values should be fractions or integers, but got %R.",
+                   item);
+      goto error;
+    }
+    if (element == NULL) goto error;
+    PyList_SET_ITEM(result, index, (PyObject*)element);
+  }
+  Py_DECREF(sequence);
+  Py_DECREF(one);
+  Py_DECREF(step_denominator);
+  Py_DECREF(step_numerator);
+  return result;
+error:
+  Py_XDECREF(result);
+  Py_XDECREF(sequence);
+  Py_XDECREF(one);
+  Py_DECREF(step_denominator);
+  Py_DECREF(step_numerator);
+  return NULL;
+}
+
+static PyObject* limit_denominators(PyObject* module,
+                                    PyObject* args) {
+  PyObject *values, *max_denominator = NULL;
+  if (!PyArg_ParseTuple(args, "O|O:limit_denominators", &values,
+                        &max_denominator))
+    return NULL;
+  if (max_denominator == NULL) {
+    max_denominator = PyLong_FromLong(1000000);
+    if (max_denominator == NULL) return NULL;
+  } else if (validate_max_denominator(max_denominator) < 0)
+    return NULL;
+  else
+    Py_INCREF(max_denominator);
+  PyObject* result = NULL;
+  PyObject* sequence =
+      sequence_fast_snapshot(values,
+                             "Values should be an iterable of fractions.");
+  if (sequence == NULL) goto error;
+  Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
+  PyObject** items = PySequence_Fast_ITEMS(sequence);
+  result = PyList_New(size);
+  if (result == NULL) goto error;
+  for (Py_ssize_t index = 0; index < size; ++index) {
+    PyObject* item = items[index];
+    FractionObject* element;
+    if (is_fraction(item))
+      element = fraction_limit_denominator_impl((FractionObject*)item,
+                                                max_denominator);
+    else if (PyLong_Check(item)) {
+      PyObject* denominator = PyLong_FromLong(1);
+      if (denominator == NULL) goto error;
+      Py_INCREF(item);
+      element = construct_fraction(get_module_state(module)->fraction_type,
+                                   item, denominator);
+    } else {
+      PyErr_Format(PyExc_TypeError,
+                   "Values should be fractions or integers, but got %R.",
+                   item);
+      goto error;
+    }
+    if (element == NULL) goto error;
+    PyList_SET_ITEM(result, index, (PyObject*)element);
+  }
+  Py_DECREF(sequence);
+  Py_DECREF(max_denominator);
+  return result;
+error:
+  Py_XDECREF(result);
+  Py_XDECREF(sequence);
+  Py_DECREF(max_denominator);
+  return NULL;
+}
+
+static PyObject* farey(PyObject* module, PyObject* order) {
+  if (!PyLong_Check(order)) {
+    PyErr_Format(PyExc_TypeError, "Order should be an integer, but got %R.",
+                 order);
+    return NULL;
+  }
+  if (_PyLong_Sign(order) <= 0) {
+    PyErr_SetString(PyExc_ValueError, "Order should be positive.");
+    return NULL;
+  }
+  long long small_order;
+  int signal = Long_to_int64(order, &small_order);
+  if (signal < 0) return NULL;
+  if (!signal || small_order > MAX_FAREY_ORDER) {
+    PyErr_SetString(PyExc_OverflowError, "Order is too large.");
+    return NULL;
+  }
+  FareyIteratorObject* result = PyObject_New(
+      FareyIteratorObject, get_module_state(module)->farey_iterator_type);
+  if (result == NULL) return NULL;
+  result->order = small_order;
+  result->terms[0] = 0;
+  result->terms[1] = 1;
+  result->terms[2] = 1;
+  result->terms[3] = small_order;
+  return (PyObject*)result;
+}
+
+static PyObject* mediants(PyObject* module, PyObject* args) {
+  PyObject* bounds[2];
+  Py_ssize_t depth;
+  if (!PyArg_ParseTuple(args, "OOn:mediants", &bounds[0], &bounds[1], &depth))
+    return NULL;
+  if (depth < 0) {
+    PyErr_SetString(PyExc_ValueError, "Depth should be non-negative.");
+    return NULL;
+  }
+  ModuleState* state = get_module_state(module);
+  PyObject *components[4] = {NULL, NULL, NULL, NULL}, *determinant = NULL;
+  for (size_t index = 0; index < 2; ++index) {
+    int signal = parse_rational_components(state->fraction_type, bounds[index],
+                                           &components[2 * index],
+                                           &components[2 * index + 1]);
+    if (signal < 0) goto error;
+    if (!signal) {
+      PyErr_Format(PyExc_TypeError,
+                   "Bounds should be rational numbers, but got %R.",
+                   bounds[index]);
+      goto error;
+    }
+  }
+  PyObject* left = PyNumber_Multiply(components[2], components[1]);
+  if (left == NULL) goto error;
+  PyObject* right = PyNumber_Multiply(components[0], components[3]);
+  if (right == NULL) {
+    Py_DECREF(left);
+    goto error;
+  }
+  determinant = PyNumber_Subtract(left, right);
+  Py_DECREF(right);
+  Py_DECREF(left);
+  if (determinant == NULL) goto error;
+  if (_PyLong_Sign(determinant) <= 0) {
+    PyErr_SetString(PyExc_ValueError,
+                    "Lower bound should be less than the upper one.");
+    goto error;
+  }
+  int is_reduced = is_unit_py_object_bool(determinant);
+  if (is_reduced < 0) goto error;
+  MediantsIteratorObject* result =
+      PyObject_New(MediantsIteratorObject, state->mediants_iterator_type);
+  if (result == NULL) goto error;
+  result->depth = depth;
+  result->size = result->capacity = 0;
+  result->stack = NULL;
+  result->is_reduced = is_reduced;
+  result->current.level = 1;
+  int signal = 1;
+  for (size_t index = 0; index < 4 && signal > 0; ++index)
+    signal = Long_to_int64(components[index],
+                           &result->current.small_bounds[index]);
+  if (signal < 0) {
+    for (size_t index = 0; index < 4; ++index)
+      result->current.bounds[index] = NULL;
+    Py_DECREF(result);
+    goto error;
+  }
+  result->is_small =
+      signal && mediants_fit_int64(result->current.small_bounds, depth);
+  for (size_t index = 0; index < 4; ++index) {
+    result->current.bounds[index] =
+        result->is_small ? NULL : components[index];
+    if (result->is_small) Py_DECREF(components[index]);
+  }
+  Py_DECREF(determinant);
+  return (PyObject*)result;
+error:
+  for (size_t index = 0; index < 4; ++index) Py_XDECREF(components[index]);
+  Py_XDECREF(determinant);
+  return NULL;
+}
+
+static PyObject* simplest_between(PyObject* module, PyObject* args,
+                                  PyObject* kwargs) {
+  static char* keywords[] = {"", "", "inclusive", NULL};
+  PyTypeObject* cls = get_module_state(module)->fraction_type;
+  PyObject *bounds[2], *components[4] = {NULL, NULL, NULL, NULL};
+  int inclusive = 1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|$p:simplest_between",
+                                   keywords, &bounds[0], &bounds[1],
+                                   &inclusive))
+    return NULL;
+  for (size_t index = 0; index < 2; ++index) {
+    int signal = parse_rational_components(
+        cls, bounds[index], &components[2 * index], &components[2 * index + 1]);
+    if (signal < 0) goto error;
+    if (!signal) {
+      PyErr_Format(PyExc_TypeError,
+                   "Bounds should be rational numbers, but got %R.",
+                   bounds[index]);
+      goto error;
+    }
+  }
+  PyObject* comparison = Fractions_components_richcompare(
+      components[0], components[1], components[2], components[3],
+      inclusive ? Py_LE : Py_LT);
+  if (comparison == NULL) goto error;
+  int is_non_empty = PyObject_IsTrue(comparison);
+  Py_DECREF(comparison);
+  if (is_non_empty < 0) goto error;
+  if (!is_non_empty) {
+    PyErr_SetString(PyExc_ValueError, "Interval should not be empty.");
+    goto error;
+  }
+  int lower_sign = _PyLong_Sign(components[0]),
+      upper_sign = _PyLong_Sign(components[2]);
+  if (inclusive ? lower_sign <= 0 && upper_sign >= 0
+                : lower_sign < 0 && upper_sign > 0) {
+    for (size_t index = 0; index < 4; ++index) Py_DECREF(components[index]);
+    return (PyObject*)construct_fraction_from_small_components(cls, 0, 1);
+  }
+  int is_negative = upper_sign <= 0;
+  if (is_negative) {
+    /* search between negated bounds */
+    PyObject* tmp = components[0];
+    components[0] = PyNumber_Negative(components[2]);
+    Py_SETREF(components[2], PyNumber_Negative(tmp));
+    Py_DECREF(tmp);
+    tmp = components[1];
+    components[1] = components[3];
+    components[3] = tmp;
+    if (components[0] == NULL || components[2] == NULL) goto error;
+  }
+  PyObject *numerator, *denominator;
+  int signal = simplest_between_components(components, inclusive, &numerator,
+                                           &denominator);
+  for (size_t index = 0; index < 4; ++index) Py_DECREF(components[index]);
+  if (signal < 0) return NULL;
+  if (is_negative) {
+    Py_SETREF(numerator, PyNumber_Negative(numerator));
+    if (numerator == NULL) {
+      Py_DECREF(denominator);
+      return NULL;
+    }
+  }
+  return (PyObject*)construct_fraction(cls, numerator, denominator);
+error:
+  for (size_t index = 0; index < 4; ++index) Py_XDECREF(components[index]);
+  return NULL;
+}
+
+static PyObject* powers(PyObject* module, PyObject* args) {
+  PyTypeObject* cls = get_module_state(module)->fraction_type;
+  PyObject *base, *components[2], *power[2] = {NULL, NULL}, *result = NULL;
+  Py_ssize_t count;
+  if (!PyArg_ParseTuple(args, "On:powers", &base, &count)) return NULL;
+  if (count < 0) {
+    PyErr_SetString(PyExc_ValueError, "Count should be non-negative.");
+    return NULL;
+  }
+  int signal =
+      parse_rational_components(cls, base, &components[0], &components[1]);
+  if (signal < 0) return NULL;
+  if (!signal) {
+    PyErr_Format(PyExc_TypeError,
+                 "Base should be a rational number, but got %R.", base);
     return NULL;
   }
-  PyObject* tmp = PyNumber_Multiply(remainder, scalar);
-  Py_DECREF(remainder);
-  if (tmp == NULL) {
-    Py_DECREF(scalar);
-    Py_DECREF(quotient);
-    return NULL;
+  result = PyList_New(count);
+  if (result == NULL) goto error;
+  long long small_components[2], small_power[2] = {1, 1};
+  for (size_t index = 0; index < 2 && signal > 0; ++index)
+    signal = Long_to_int64(components[index], &small_components[index]);
+  if (signal < 0) goto error;
+  /* each power is built from the previous one,
+     no normalization is needed as powers of coprime integers stay coprime */
+  Py_ssize_t index = 0;
+  if (signal)
+    for (; index < count; ++index) {
+      FractionObject* item = construct_fraction_from_small_components(
+          cls, small_power[0], small_power[1]);
+      if (item == NULL) goto error;
+      PyList_SET_ITEM(result, index, (PyObject*)item);
+      long long next_power[2];
+      if (!int64_multiply(small_power[0], small_components[0],
+                          &next_power[0]) ||
+          !int64_multiply(small_power[1], small_components[1],
+                          &next_power[1])) {
+        ++index;
+        break;
+      }
+      small_power[0] = next_power[0];
+      small_power[1] = next_power[1];
+    }
+  if (index < count) {
+    for (size_t component_index = 0; component_index < 2; ++component_index) {
+      power[component_index] =
+          PyLong_FromLongLong(small_power[component_index]);
+      if (power[component_index] == NULL) goto error;
+    }
+    for (; index < count; ++index) {
+      if (index > 0)
+        for (size_t component_index = 0; component_index < 2;
+             ++component_index) {
+          Py_SETREF(power[component_index],
+                    PyNumber_Multiply(power[component_index],
+                                      components[component_index]));
+          if (power[component_index] == NULL) goto error;
+        }
+      Py_INCREF(power[0]);
+      Py_INCREF(power[1]);
+      FractionObject* item = construct_fraction(cls, power[0], power[1]);
+      if (item == NULL) goto error;
+      PyList_SET_ITEM(result, index, (PyObject*)item);
+    }
+  }
+  Py_XDECREF(power[1]);
+  Py_XDECREF(power[0]);
+  Py_DECREF(components[1]);
+  Py_DECREF(components[0]);
+  return result;
+error:
+  Py_XDECREF(power[1]);
+  Py_XDECREF(power[0]);
+  Py_DECREF(components[1]);
+  Py_DECREF(components[0]);
+  Py_XDECREF(result);
+  return NULL;
+}
+
+/* Signed integer of fixed width for reductions without the interpreter,
+   wide enough to hold sums of products of machine words. */
+#define WIDE_INTEGER_LIMBS 8
+
+typedef struct {
+  uint32_t limbs[WIDE_INTEGER_LIMBS]; /* modulus, least significant first */
+  int is_negative;
+} WideInteger;
+
+static void wide_integer_from_int64(long long value, WideInteger* result) {
+  unsigned long long modulus = value < 0 ? 0ULL - (unsigned long long)value
+                                         : (unsigned long long)value;
+  memset(result->limbs, 0, sizeof(result->limbs));
+  result->limbs[0] = (uint32_t)modulus;
+  result->limbs[1] = (uint32_t)(modulus >> 32);
+  result->is_negative = value < 0;
+}
+
+/* Multiplies in place, returns 0 leaving the value intact on overflow. */
+static int wide_integer_multiply(WideInteger* self, unsigned long long factor) {
+  uint32_t factor_limbs[2] = {(uint32_t)factor, (uint32_t)(factor >> 32)},
+           result[WIDE_INTEGER_LIMBS] = {0};
+  for (size_t offset = 0; offset < 2; ++offset) {
+    if (!factor_limbs[offset]) continue;
+    unsigned long long carry = 0;
+    for (size_t index = 0; index < WIDE_INTEGER_LIMBS; ++index) {
+      if (index + offset >= WIDE_INTEGER_LIMBS) {
+        if (self->limbs[index]) return 0;
+        continue;
+      }
+      unsigned long long product =
+          (unsigned long long)self->limbs[index] * factor_limbs[offset] +
+          result[index + offset] + carry;
+      result[index + offset] = (uint32_t)product;
+      carry = product >> 32;
+    }
+    if (carry) return 0;
+  }
+  memcpy(self->limbs, result, sizeof(result));
+  return 1;
+}
+
+static int wide_integers_compare_moduli(const WideInteger* first,
+                                        const WideInteger* second) {
+  for (size_t index = WIDE_INTEGER_LIMBS; index-- > 0;)
+    if (first->limbs[index] != second->limbs[index])
+      return first->limbs[index] < second->limbs[index] ? -1 : 1;
+  return 0;
+}
+
+/* Adds in place, returns 0 leaving the value intact on overflow. */
+static int wide_integer_add(WideInteger* self, const WideInteger* other) {
+  uint32_t result[WIDE_INTEGER_LIMBS];
+  if (self->is_negative == other->is_negative) {
+    unsigned long long carry = 0;
+    for (size_t index = 0; index < WIDE_INTEGER_LIMBS; ++index) {
+      unsigned long long sum = (unsigned long long)self->limbs[index] +
+                               other->limbs[index] + carry;
+      result[index] = (uint32_t)sum;
+      carry = sum >> 32;
+    }
+    if (carry) return 0;
+  } else {
+    const WideInteger *minuend = self, *subtrahend = other;
+    if (wide_integers_compare_moduli(self, other) < 0) {
+      minuend = other;
+      subtrahend = self;
+    }
+    unsigned long long borrow = 0;
+    for (size_t index = 0; index < WIDE_INTEGER_LIMBS; ++index) {
+      unsigned long long difference =
+          (unsigned long long)minuend->limbs[index] -
+          subtrahend->limbs[index] - borrow;
+      result[index] = (uint32_t)difference;
+      borrow = (difference >> 32) & 1;
+    }
+    self->is_negative = minuend->is_negative;
+  }
+  memcpy(self->limbs, result, sizeof(result));
+  return 1;
+}
+
+static PyObject* WideInteger_to_Long(const WideInteger* value) {
+  unsigned char bytes[4 * WIDE_INTEGER_LIMBS];
+  for (size_t index = 0; index < WIDE_INTEGER_LIMBS; ++index)
+    for (size_t shift = 0; shift < 4; ++shift)
+      bytes[4 * index + shift] =
+          (unsigned char)(value->limbs[index] >> (8 * shift));
+  PyObject* result = _PyLong_FromByteArray(bytes, sizeof(bytes), 1, 0);
+  if (result != NULL && value->is_negative)
+    Py_SETREF(result, PyNumber_Negative(result));
+  return result;
+}
+
+/* Sum of consecutive terms over the least common multiple
+   of their denominators, not reduced by the gcd with the numerator. */
+typedef struct {
+  WideInteger numerator;
+  unsigned long long denominator;
+} WidePartialSum;
+
+/* Terms which fit in machine words are summed without the interpreter,
+   each term is a product of `arity` factors. */
+#define PARALLEL_MIN_CHUNK_SIZE 4096
+
+typedef struct {
+  Py_ssize_t arity;
+  const long long* small_numerators;
+  const unsigned long long* small_denominators; /* products of factors' */
+  Py_ssize_t small_size;
+  PyObject* const* components; /* numerator & denominator of each factor */
+  Py_ssize_t size;
+  WidePartialSum* partial_sums;
+  Py_ssize_t partial_sums_size;
+  Py_ssize_t partial_sums_capacity;
+  int is_out_of_memory;
+  PyObject* numerator; /* `NULL` until the task is reduced */
+  PyObject* denominator;
+  PyThread_type_lock finished; /* `NULL` for tasks of the calling thread */
+#ifdef Py_GIL_DISABLED
+  PyInterpreterState* interpreter;
+  PyObject* error;
+#endif
+} ReductionTask;
+
+static int reduction_task_append_small(ReductionTask* self,
+                                       const WideInteger* numerator,
+                                       unsigned long long denominator) {
+  if (self->partial_sums_size) {
+    WidePartialSum* last = &self->partial_sums[self->partial_sums_size - 1];
+    if (last->denominator == denominator) {
+      if (wide_integer_add(&last->numerator, numerator)) return 0;
+    } else {
+      unsigned long long gcd = uint64_gcd(last->denominator, denominator),
+                         last_scale = denominator / gcd,
+                         scale = last->denominator / gcd;
+      WideInteger sum = last->numerator, term = *numerator;
+      if (scale <= ULLONG_MAX / denominator &&
+          wide_integer_multiply(&sum, last_scale) &&
+          wide_integer_multiply(&term, scale) &&
+          wide_integer_add(&sum, &term)) {
+        last->numerator = sum;
+        last->denominator = scale * denominator;
+        return 0;
+      }
+    }
+  }
+  if (self->partial_sums_size == self->partial_sums_capacity) {
+    Py_ssize_t capacity =
+        self->partial_sums_capacity ? 2 * self->partial_sums_capacity : 16;
+    WidePartialSum* partial_sums = PyMem_RawRealloc(
+        self->partial_sums, (size_t)capacity * sizeof(WidePartialSum));
+    if (partial_sums == NULL) return -1;
+    self->partial_sums = partial_sums;
+    self->partial_sums_capacity = capacity;
+  }
+  WidePartialSum* partial_sum = &self->partial_sums[self->partial_sums_size++];
+  partial_sum->numerator = *numerator;
+  partial_sum->denominator = denominator;
+  return 0;
+}
+
+/* Sums small terms into partial sums, does not touch Python objects. */
+static void reduction_task_sum_small(ReductionTask* self) {
+  for (Py_ssize_t index = 0; index < self->small_size; ++index) {
+    const long long* factors = &self->small_numerators[index * self->arity];
+    WideInteger numerator;
+    wide_integer_from_int64(factors[0], &numerator);
+    for (Py_ssize_t offset = 1; offset < self->arity; ++offset) {
+      long long factor = factors[offset];
+      /* product of two machine words always fits */
+      wide_integer_multiply(&numerator,
+                            factor < 0 ? 0ULL - (unsigned long long)factor
+                                       : (unsigned long long)factor);
+      numerator.is_negative ^= factor < 0;
+    }
+    if (reduction_task_append_small(self, &numerator,
+                                    self->small_denominators[index]) < 0) {
+      self->is_out_of_memory = 1;
+      return;
+    }
+  }
+}
+
+/* Adds fractions' components over the least common multiple
+   of their denominators, the sum is not reduced otherwise. */
+static int Longs_components_add(PyObject* first_numerator,
+                                PyObject* first_denominator,
+                                PyObject* second_numerator,
+                                PyObject* second_denominator,
+                                PyObject** result_numerator,
+                                PyObject** result_denominator) {
+  PyObject* gcd = Longs_gcd(first_denominator, second_denominator);
+  if (gcd == NULL) return -1;
+  PyObject* first_scale = Longs_floor_divide(second_denominator, gcd);
+  PyObject* second_scale = first_scale == NULL
+                               ? NULL
+                               : Longs_floor_divide(first_denominator, gcd);
+  Py_DECREF(gcd);
+  if (second_scale == NULL) {
+    Py_XDECREF(first_scale);
+    return -1;
+  }
+  int result = -1;
+  PyObject* first_term = Longs_multiply(first_numerator, first_scale);
+  PyObject* second_term = first_term == NULL
+                               ? NULL
+                               : Longs_multiply(second_numerator, second_scale);
+  if (second_term != NULL &&
+      (*result_numerator = PyNumber_Add(first_term, second_term)) != NULL) {
+    *result_denominator = Longs_multiply(first_denominator, first_scale);
+    if (*result_denominator == NULL)
+      Py_DECREF(*result_numerator);
+    else
+      result = 0;
+  }
+  Py_XDECREF(second_term);
+  Py_XDECREF(first_term);
+  Py_DECREF(second_scale);
+  Py_DECREF(first_scale);
+  return result;
+}
+
+/* Adds up fractions' components pairwise in a balanced tree,
+   steals references to the components. */
+static int Longs_components_sum(PyObject** numerators, PyObject** denominators,
+                                Py_ssize_t size, PyObject** result_numerator,
+                                PyObject** result_denominator) {
+  for (; size > 1; size = (size + 1) / 2) {
+    Py_ssize_t index = 0;
+    for (; 2 * index + 1 < size; ++index) {
+      PyObject *numerator, *denominator;
+      if (Longs_components_add(numerators[2 * index], denominators[2 * index],
+                               numerators[2 * index + 1],
+                               denominators[2 * index + 1], &numerator,
+                               &denominator) < 0) {
+        /* sums of the pass precede the components left to add */
+        for (Py_ssize_t offset = 0; offset < size; ++offset)
+          if (offset < index || offset >= 2 * index) {
+            Py_DECREF(numerators[offset]);
+            Py_DECREF(denominators[offset]);
+          }
+        return -1;
+      }
+      for (Py_ssize_t offset = 2 * index; offset < 2 * index + 2; ++offset) {
+        Py_DECREF(numerators[offset]);
+        Py_DECREF(denominators[offset]);
+      }
+      numerators[index] = numerator;
+      denominators[index] = denominator;
+    }
+    if (size % 2) {
+      numerators[index] = numerators[size - 1];
+      denominators[index] = denominators[size - 1];
+    }
+  }
+  if (size) {
+    *result_numerator = numerators[0];
+    *result_denominator = denominators[0];
+    return 0;
+  }
+  *result_numerator = PyLong_FromLong(0);
+  if (*result_numerator == NULL) return -1;
+  *result_denominator = PyLong_FromLong(1);
+  if (*result_denominator == NULL) {
+    Py_DECREF(*result_numerator);
+    return -1;
+  }
+  return 0;
+}
+
+/* Reduces partial sums and terms of the task to a single pair
+   of components. */
+static int reduction_task_reduce(ReductionTask* self) {
+  Py_ssize_t size = self->partial_sums_size + self->size, count = 0;
+  PyObject** numerators =
+      PyMem_Malloc((size_t)(2 * size + 1) * sizeof(PyObject*));
+  if (numerators == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  PyObject** denominators = numerators + size;
+  for (Py_ssize_t index = 0; index < self->partial_sums_size; ++index) {
+    numerators[count] =
+        WideInteger_to_Long(&self->partial_sums[index].numerator);
+    if (numerators[count] == NULL) goto error;
+    denominators[count] =
+        PyLong_FromUnsignedLongLong(self->partial_sums[index].denominator);
+    if (denominators[count] == NULL) {
+      Py_DECREF(numerators[count]);
+      goto error;
+    }
+    ++count;
+  }
+  for (Py_ssize_t index = 0; index < self->size; ++index) {
+    PyObject* const* factors = &self->components[2 * self->arity * index];
+    PyObject *numerator = factors[0], *denominator = factors[1];
+    Py_INCREF(numerator);
+    Py_INCREF(denominator);
+    for (Py_ssize_t offset = 1; offset < self->arity; ++offset) {
+      Py_SETREF(numerator, Longs_multiply(numerator, factors[2 * offset]));
+      if (numerator == NULL) {
+        Py_DECREF(denominator);
+        goto error;
+      }
+      Py_SETREF(denominator,
+                Longs_multiply(denominator, factors[2 * offset + 1]));
+      if (denominator == NULL) {
+        Py_DECREF(numerator);
+        goto error;
+      }
+    }
+    numerators[count] = numerator;
+    denominators[count] = denominator;
+    ++count;
+  }
+  int result = Longs_components_sum(numerators, denominators, count,
+                                     &self->numerator, &self->denominator);
+  PyMem_Free(numerators);
+  return result;
+error:
+  for (Py_ssize_t index = 0; index < count; ++index) {
+    Py_DECREF(numerators[index]);
+    Py_DECREF(denominators[index]);
+  }
+  PyMem_Free(numerators);
+  return -1;
+}
+
+static void reduction_task_run(void* argument) {
+  ReductionTask* self = (ReductionTask*)argument;
+  reduction_task_sum_small(self);
+#ifdef Py_GIL_DISABLED
+  /* without the GIL terms held by Python objects are reduced
+     in parallel as well */
+  PyThreadState* thread_state = PyThreadState_New(self->interpreter);
+  if (thread_state != NULL) {
+    PyEval_RestoreThread(thread_state);
+    if (!self->is_out_of_memory && reduction_task_reduce(self) < 0)
+      self->error = PyErr_GetRaisedException();
+    PyThreadState_Clear(thread_state);
+    PyThreadState_DeleteCurrent();
+  }
+#endif
+  PyThread_release_lock(self->finished);
+}
+
+static int parse_workers_count(PyObject* workers, Py_ssize_t* result) {
+  if (workers == NULL || workers == Py_None) {
+    PyObject* os_module = PyImport_ImportModule("os");
+    if (os_module == NULL) return -1;
+    PyObject* cpu_count = PyObject_CallMethod(os_module, "cpu_count", NULL);
+    Py_DECREF(os_module);
+    if (cpu_count == NULL) return -1;
+    *result = cpu_count == Py_None
+                  ? 1
+                  : PyNumber_AsSsize_t(cpu_count, PyExc_OverflowError);
+    Py_DECREF(cpu_count);
+    return *result == -1 && PyErr_Occurred() ? -1 : 0;
+  }
+  *result = PyNumber_AsSsize_t(workers, PyExc_OverflowError);
+  if (*result == -1 && PyErr_Occurred()) return -1;
+  if (*result < 1) {
+    PyErr_SetString(PyExc_ValueError, "Workers count should be positive.");
+    return -1;
+  }
+  return 0;
+}
+
+/* Offset of a chunk when `size` elements are split into `count` chunks
+   of sizes which differ by at most one. */
+static Py_ssize_t chunk_start(Py_ssize_t size, Py_ssize_t count,
+                              Py_ssize_t index) {
+  return size / count * index + Py_MIN(index, size % count);
+}
+
+/* Sums products of `arity` corresponding elements of `values`,
+   split into chunks which are reduced by worker threads,
+   since the arithmetic is exact the result does not depend on
+   the order of additions and equals the one of sequential summation. */
+static PyObject* Fractions_sum_in_parallel(PyTypeObject* cls,
+                                           PyObject* const* values,
+                                           Py_ssize_t arity,
+                                           PyObject* workers) {
+  Py_ssize_t workers_count;
+  if (parse_workers_count(workers, &workers_count) < 0) return NULL;
+  PyObject *sequences[2] = {NULL, NULL}, *result = NULL,
+           **components = NULL;
+  long long* small_numerators = NULL;
+  unsigned long long* small_denominators = NULL;
+  ReductionTask* tasks = NULL;
+  Py_ssize_t components_size = 0, small_size = 0, tasks_count = 0;
+  for (Py_ssize_t offset = 0; offset < arity; ++offset) {
+    sequences[offset] = sequence_fast_snapshot(
+        values[offset], "Values should be an iterable of rational numbers.");
+    if (sequences[offset] == NULL) goto exit;
+  }
+  Py_ssize_t size = PySequence_Fast_GET_SIZE(sequences[0]);
+  if (arity == 2 && PySequence_Fast_GET_SIZE(sequences[1]) != size) {
+    PyErr_SetString(PyExc_ValueError,
+                    "Sequences should have the same length.");
+    goto exit;
+  }
+  small_numerators =
+      PyMem_Malloc((size_t)(arity * size + 1) * sizeof(long long));
+  small_denominators =
+      PyMem_Malloc((size_t)(size + 1) * sizeof(unsigned long long));
+  components =
+      PyMem_Malloc((size_t)(2 * arity * size + 1) * sizeof(PyObject*));
+  if (small_numerators == NULL || small_denominators == NULL ||
+      components == NULL) {
+    PyErr_NoMemory();
+    goto exit;
+  }
+  for (Py_ssize_t index = 0; index < size; ++index) {
+    PyObject* term[4];
+    long long small_term[4];
+    int is_small = 1;
+    for (Py_ssize_t offset = 0; offset < arity; ++offset) {
+      PyObject* item = PySequence_Fast_ITEMS(sequences[offset])[index];
+      int signal = parse_rational_components(cls, item, &term[2 * offset],
+                                             &term[2 * offset + 1]);
+      if (signal <= 0) {
+        if (!signal)
+          PyErr_Format(PyExc_TypeError,
+                       "Values should be rational numbers, but got %R.",
+                       item);
+        for (Py_ssize_t component = 0; component < 2 * offset; ++component)
+          Py_DECREF(term[component]);
+        goto exit;
+      }
+      for (Py_ssize_t component = 2 * offset;
+           component < 2 * offset + 2 && is_small > 0; ++component)
+        is_small = Long_to_int64(term[component], &small_term[component]);
+    }
+    unsigned long long small_denominator = 1;
+    for (Py_ssize_t offset = 0; offset < arity && is_small > 0; ++offset) {
+      long long denominator = small_term[2 * offset + 1];
+      if (denominator <= 0 ||
+          (unsigned long long)denominator > ULLONG_MAX / small_denominator)
+        is_small = 0;
+      else
+        small_denominator *= (unsigned long long)denominator;
+    }
+    if (is_small > 0) {
+      for (Py_ssize_t offset = 0; offset < arity; ++offset)
+        small_numerators[arity * small_size + offset] =
+            small_term[2 * offset];
+      small_denominators[small_size++] = small_denominator;
+    } else if (!is_small) {
+      memcpy(&components[2 * arity * components_size++], term,
+             (size_t)(2 * arity) * sizeof(PyObject*));
+      continue;
+    }
+    for (Py_ssize_t component = 0; component < 2 * arity; ++component)
+      Py_DECREF(term[component]);
+    if (is_small < 0) goto exit;
+  }
+  tasks_count = Py_MIN(
+      workers_count,
+      Py_MAX((size + PARALLEL_MIN_CHUNK_SIZE - 1) / PARALLEL_MIN_CHUNK_SIZE,
+             1));
+  tasks = PyMem_Calloc((size_t)tasks_count, sizeof(ReductionTask));
+  if (tasks == NULL) {
+    tasks_count = 0;
+    PyErr_NoMemory();
+    goto exit;
+  }
+  for (Py_ssize_t index = 0; index < tasks_count; ++index) {
+    ReductionTask* task = &tasks[index];
+    Py_ssize_t small_start = chunk_start(small_size, tasks_count, index),
+               start = chunk_start(components_size, tasks_count, index);
+    task->arity = arity;
+    task->small_numerators = &small_numerators[arity * small_start];
+    task->small_denominators = &small_denominators[small_start];
+    task->small_size =
+        chunk_start(small_size, tasks_count, index + 1) - small_start;
+    task->components = &components[2 * arity * start];
+    task->size = chunk_start(components_size, tasks_count, index + 1) - start;
+#ifdef Py_GIL_DISABLED
+    task->interpreter = PyInterpreterState_Get();
+#endif
+    if (index == 0) continue;
+    task->finished = PyThread_allocate_lock();
+    if (task->finished == NULL) continue;
+    PyThread_acquire_lock(task->finished, WAIT_LOCK);
+    if (PyThread_start_new_thread(reduction_task_run, task) ==
+        PYTHREAD_INVALID_THREAD_ID) {
+      PyThread_free_lock(task->finished);
+      task->finished = NULL;
+    }
+  }
+  Py_BEGIN_ALLOW_THREADS
+  for (Py_ssize_t index = 0; index < tasks_count; ++index)
+    if (tasks[index].finished == NULL) reduction_task_sum_small(&tasks[index]);
+  Py_END_ALLOW_THREADS
+  /* with the GIL workers only sum small terms,
+     so the rest of the first task is reduced meanwhile */
+  int signal = tasks[0].is_out_of_memory
+                   ? (PyErr_NoMemory(), -1)
+                   : reduction_task_reduce(&tasks[0]);
+  Py_BEGIN_ALLOW_THREADS
+  for (Py_ssize_t index = 1; index < tasks_count; ++index)
+    if (tasks[index].finished != NULL) {
+      PyThread_acquire_lock(tasks[index].finished, WAIT_LOCK);
+      PyThread_free_lock(tasks[index].finished);
+      tasks[index].finished = NULL;
+    }
+  Py_END_ALLOW_THREADS
+  if (signal < 0) goto exit;
+  PyObject **numerators = PyMem_Malloc((size_t)(2 * tasks_count) *
+                                       sizeof(PyObject*)),
+           **denominators = numerators + tasks_count;
+  if (numerators == NULL) {
+    PyErr_NoMemory();
+    goto exit;
+  }
+  Py_ssize_t count = 0;
+  for (; count < tasks_count; ++count) {
+    ReductionTask* task = &tasks[count];
+#ifdef Py_GIL_DISABLED
+    if (task->error != NULL) {
+      PyErr_SetRaisedException(task->error);
+      task->error = NULL;
+      break;
+    }
+#endif
+    if (task->is_out_of_memory) {
+      PyErr_NoMemory();
+      break;
+    }
+    if (task->numerator == NULL && reduction_task_reduce(task) < 0) break;
+    numerators[count] = task->numerator;
+    denominators[count] = task->denominator;
+    task->numerator = task->denominator = NULL;
   }
-  int comparison_signal =
-      PyObject_RichCompareBool(tmp, self->denominator, Py_LT);
-  if (comparison_signal < 0) {
-    Py_DECREF(tmp);
-    Py_DECREF(scalar);
-    Py_DECREF(quotient);
-    return NULL;
-  } else if (comparison_signal) {
-    Py_DECREF(tmp);
-    Py_DECREF(scalar);
-    return quotient;
+  PyObject *numerator, *denominator;
+  if (count < tasks_count) {
+    for (Py_ssize_t index = 0; index < count; ++index) {
+      Py_DECREF(numerators[index]);
+      Py_DECREF(denominators[index]);
+    }
+  } else if (Longs_components_sum(numerators, denominators, count,
+                                  &numerator, &denominator) >= 0) {
+    if (normalize_fraction_components_moduli(&numerator, &denominator) < 0) {
+      Py_DECREF(denominator);
+      Py_DECREF(numerator);
+    } else
+      result = (PyObject*)construct_fraction(cls, numerator, denominator);
   }
-  comparison_signal = PyObject_RichCompareBool(tmp, self->denominator, Py_EQ);
-  Py_DECREF(tmp);
-  if (comparison_signal < 0) {
-    Py_DECREF(scalar);
-    Py_DECREF(quotient);
+  PyMem_Free(numerators);
+exit:
+  for (Py_ssize_t index = 0; index < tasks_count; ++index) {
+    Py_XDECREF(tasks[index].denominator);
+    Py_XDECREF(tasks[index].numerator);
+#ifdef Py_GIL_DISABLED
+    Py_XDECREF(tasks[index].error);
+#endif
+    PyMem_RawFree(tasks[index].partial_sums);
+  }
+  PyMem_Free(tasks);
+  for (Py_ssize_t index = 0; index < 2 * arity * components_size; ++index)
+    Py_DECREF(components[index]);
+  PyMem_Free(components);
+  PyMem_Free(small_denominators);
+  PyMem_Free(small_numerators);
+  Py_XDECREF(sequences[1]);
+  Py_XDECREF(sequences[0]);
+  return result;
+}
+
+static PyObject* parallel_dot(PyObject* module, PyObject* args,
+                              PyObject* kwargs) {
+  static char* keywords[] = {"", "", "workers", NULL};
+  PyObject *values[2], *workers = NULL;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|$O:parallel_dot",
+                                   keywords, &values[0], &values[1],
+                                   &workers))
+    return NULL;
+  return Fractions_sum_in_parallel(get_module_state(module)->fraction_type,
+                                   values, 2, workers);
+}
+
+static PyObject* parallel_sum(PyObject* module, PyObject* args,
+                              PyObject* kwargs) {
+  static char* keywords[] = {"", "workers", NULL};
+  PyObject *values, *workers = NULL;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|$O:parallel_sum",
+                                   keywords, &values, &workers))
+    return NULL;
+  return Fractions_sum_in_parallel(get_module_state(module)->fraction_type,
+                                   &values, 1, workers);
+}
+
+static PyObject* set_growth_hook(PyObject* module, PyObject* args) {
+  ModuleState* state = get_module_state(module);
+  PyObject* hook;
+  Py_ssize_t threshold_bits;
+  if (!PyArg_ParseTuple(args, "nO:set_growth_hook", &threshold_bits, &hook))
+    return NULL;
+  if (threshold_bits < 0) {
+    PyErr_SetString(PyExc_ValueError, "Threshold should be non-negative.");
     return NULL;
-  } else if (comparison_signal) {
-    tmp = PyNumber_Remainder(quotient, scalar);
-    Py_DECREF(scalar);
-    if (PyObject_Not(tmp)) {
-      Py_DECREF(tmp);
-      return quotient;
-    }
-    Py_DECREF(tmp);
   }
-  Py_DECREF(scalar);
-  scalar = PyLong_FromLong(1);
-  if (scalar == NULL) {
-    Py_DECREF(quotient);
+  if (hook == Py_None)
+    hook = NULL;
+  else if (!PyCallable_Check(hook)) {
+    PyErr_Format(PyExc_TypeError,
+                 "Hook should be a callable or None, but got %R.", hook);
     return NULL;
   }
-  tmp = quotient;
-  quotient = PyNumber_Add(quotient, scalar);
-  Py_DECREF(tmp);
-  Py_DECREF(scalar);
-  return quotient;
+  Py_XINCREF(hook);
+  LOCK_GROWTH_HOOK(state);
+  PyObject* previous_hook = state->growth_hook;
+  STORE_GROWTH_THRESHOLD_BITS(state, threshold_bits);
+  STORE_GROWTH_HOOK(state, hook);
+  UNLOCK_GROWTH_HOOK(state);
+  /* released after unlocking since finalizers may construct fractions */
+  Py_XDECREF(previous_hook);
+  Py_RETURN_NONE;
 }
 
-static PyObject* fraction_round(FractionObject* self, PyObject* args) {
-  PyObject* precision = NULL;
-  if (!PyArg_ParseTuple(args, "|O", &precision)) return NULL;
-  if (precision == NULL) return fraction_round_plain(self);
-  int comparison_signal = is_negative_py_object(precision);
-  if (comparison_signal < 0) return NULL;
-  PyObject *result_denominator, *result_numerator;
-  if (comparison_signal) {
-    PyObject* tmp = PyLong_FromLong(10);
-    if (tmp == NULL) return NULL;
-    PyObject* positive_precision = PyNumber_Negative(precision);
-    if (positive_precision == NULL) {
-      Py_DECREF(tmp);
-      return NULL;
+/* Straight-line programs over integers compiled by `cfractions.compile`:
+   registers hold components of inputs, then constants,
+   then results of instructions in order,
+   divisions are checked for zero divisors in order of evaluation. */
+typedef enum {
+  INSTRUCTION_ADD,
+  INSTRUCTION_SUBTRACT,
+  INSTRUCTION_MULTIPLY,
+  INSTRUCTIONS_OPCODES_COUNT
+} InstructionOpcode;
+
+typedef struct {
+  InstructionOpcode opcode;
+  Py_ssize_t first, second;
+} Instruction;
+
+typedef struct {
+  Py_ssize_t dividend_numerator, dividend_denominator, divisor_numerator;
+} Division;
+
+typedef struct {
+  Py_ssize_t inputs_count, constants_count, instructions_count,
+      divisions_count, numerator_register, denominator_register;
+  PyObject* constants;
+  Instruction* instructions;
+  Division* divisions;
+} Program;
+
+static void Program_free(Program* program) {
+  PyMem_Free(program->divisions);
+  PyMem_Free(program->instructions);
+}
+
+static int parse_program(PyObject* object, Program* result) {
+  PyObject *instructions, *divisions;
+  if (!PyArg_ParseTuple(object, "nO!O!O!nn;Program is malformed.",
+                        &result->inputs_count, &PyTuple_Type,
+                        &result->constants, &PyTuple_Type, &instructions,
+                        &PyTuple_Type, &divisions,
+                        &result->numerator_register,
+                        &result->denominator_register))
+    return -1;
+  result->constants_count = PyTuple_GET_SIZE(result->constants);
+  result->instructions_count = PyTuple_GET_SIZE(instructions);
+  result->divisions_count = PyTuple_GET_SIZE(divisions);
+  Py_ssize_t registers_count = result->inputs_count +
+                               result->constants_count +
+                               result->instructions_count;
+  if (result->inputs_count < 0 || result->inputs_count % 2 ||
+      result->numerator_register < 0 ||
+      result->numerator_register >= registers_count ||
+      result->denominator_register < 0 ||
+      result->denominator_register >= registers_count)
+    goto malformed;
+  for (Py_ssize_t index = 0; index < result->constants_count; ++index)
+    if (!PyLong_CheckExact(PyTuple_GET_ITEM(result->constants, index)))
+      goto malformed;
+  result->instructions =
+      PyMem_Malloc((size_t)(result->instructions_count + 1) *
+                   sizeof(Instruction));
+  result->divisions =
+      PyMem_Malloc((size_t)(result->divisions_count + 1) * sizeof(Division));
+  if (result->instructions == NULL || result->divisions == NULL) {
+    Program_free(result);
+    PyErr_NoMemory();
+    return -1;
+  }
+  for (Py_ssize_t index = 0; index < result->instructions_count; ++index) {
+    Instruction* instruction = &result->instructions[index];
+    int opcode;
+    /* operands precede the instruction's own register */
+    Py_ssize_t register_index =
+        result->inputs_count + result->constants_count + index;
+    if (!PyArg_ParseTuple(PyTuple_GET_ITEM(instructions, index),
+                          "inn;Program is malformed.", &opcode,
+                          &instruction->first, &instruction->second)) {
+      Program_free(result);
+      return -1;
     }
-    PyObject* shift = PyNumber_Power(tmp, positive_precision, Py_None);
-    Py_DECREF(tmp);
-    if (shift == NULL) return NULL;
-    tmp = PyNumber_TrueDivide((PyObject*)self, shift);
-    if (tmp == NULL) {
-      Py_DECREF(shift);
-      return NULL;
+    if (opcode < 0 || opcode >= INSTRUCTIONS_OPCODES_COUNT ||
+        instruction->first < 0 || instruction->first >= register_index ||
+        instruction->second < 0 || instruction->second >= register_index) {
+      Program_free(result);
+      goto malformed;
     }
-    result_numerator = round_py_object(tmp);
-    Py_DECREF(tmp);
-    if (result_numerator == NULL) {
-      Py_DECREF(shift);
-      return NULL;
+    instruction->opcode = (InstructionOpcode)opcode;
+  }
+  for (Py_ssize_t index = 0; index < result->divisions_count; ++index) {
+    Division* division = &result->divisions[index];
+    if (!PyArg_ParseTuple(PyTuple_GET_ITEM(divisions, index),
+                          "nnn;Program is malformed.",
+                          &division->dividend_numerator,
+                          &division->dividend_denominator,
+                          &division->divisor_numerator)) {
+      Program_free(result);
+      return -1;
     }
-    tmp = result_numerator;
-    result_numerator = PyNumber_Multiply(result_numerator, shift);
-    Py_DECREF(tmp);
-    Py_DECREF(shift);
-    if (result_numerator == NULL) return NULL;
-    result_denominator = PyLong_FromLong(1);
-    if (result_denominator == NULL) {
-      Py_DECREF(result_numerator);
-      return NULL;
+    if (division->dividend_numerator < 0 ||
+        division->dividend_numerator >= registers_count ||
+        division->dividend_denominator < 0 ||
+        division->dividend_denominator >= registers_count ||
+        division->divisor_numerator < 0 ||
+        division->divisor_numerator >= registers_count) {
+      Program_free(result);
+      goto malformed;
     }
-  } else {
-    PyObject* tmp = PyLong_FromLong(10);
-    if (tmp == NULL) return NULL;
-    result_denominator = PyNumber_Power(tmp, precision, Py_None);
-    Py_DECREF(tmp);
-    if (result_denominator == NULL) return NULL;
-    tmp = PyNumber_Multiply((PyObject*)self, result_denominator);
-    if (tmp == NULL) {
-      Py_DECREF(result_denominator);
-      return NULL;
+  }
+  return 0;
+malformed:
+  PyErr_SetString(PyExc_ValueError, "Program is malformed.");
+  return -1;
+}
+
+/* Sets the error of dividing the fraction with given components by zero
+   with the message of the division operator. */
+static void Longs_components_set_zero_division(PyObject* numerator,
+                                               PyObject* denominator) {
+  Py_INCREF(numerator);
+  Py_INCREF(denominator);
+  if (normalize_fraction_components_signs(&numerator, &denominator) >= 0 &&
+      normalize_fraction_components_moduli(&numerator, &denominator) >= 0)
+    PyErr_Format(PyExc_ZeroDivisionError, "Fraction(%S, 0)", numerator);
+  Py_DECREF(denominator);
+  Py_DECREF(numerator);
+}
+
+/* Evaluates instructions over registers with filled inputs & constants,
+   returns new references to the normalized result components. */
+static int Program_evaluate(const Program* program, PyObject** registers,
+                            PyObject** result_numerator,
+                            PyObject** result_denominator) {
+  Py_ssize_t start = program->inputs_count + program->constants_count,
+             stop = start;
+  int signal = 0;
+  for (; stop < start + program->instructions_count; ++stop) {
+    const Instruction* instruction = &program->instructions[stop - start];
+    PyObject *first = registers[instruction->first],
+             *second = registers[instruction->second];
+    switch (instruction->opcode) {
+      case INSTRUCTION_ADD:
+        registers[stop] = PyNumber_Add(first, second);
+        break;
+      case INSTRUCTION_SUBTRACT:
+        registers[stop] = PyNumber_Subtract(first, second);
+        break;
+      default:
+        registers[stop] = Longs_multiply(first, second);
     }
-    result_numerator = round_py_object(tmp);
-    Py_DECREF(tmp);
-    if (result_numerator == NULL) {
-      Py_DECREF(result_denominator);
-      return NULL;
+    if (registers[stop] == NULL) {
+      signal = -1;
+      goto finally;
     }
-    if (normalize_fraction_components_moduli(&result_numerator,
-                                             &result_denominator) < 0) {
-      Py_DECREF(result_numerator);
-      Py_DECREF(result_denominator);
-      return NULL;
+  }
+  for (Py_ssize_t index = 0; index < program->divisions_count; ++index) {
+    const Division* division = &program->divisions[index];
+    if (!_PyLong_Sign(registers[division->divisor_numerator])) {
+      Longs_components_set_zero_division(
+          registers[division->dividend_numerator],
+          registers[division->dividend_denominator]);
+      signal = -1;
+      goto finally;
     }
   }
-  return (PyObject*)construct_fraction(&FractionType, result_numerator,
-                                       result_denominator);
+  PyObject *numerator = registers[program->numerator_register],
+           *denominator = registers[program->denominator_register];
+  if (!_PyLong_Sign(denominator)) {
+    PyErr_Format(PyExc_ZeroDivisionError, "Fraction(%S, 0)", numerator);
+    signal = -1;
+    goto finally;
+  }
+  Py_INCREF(numerator);
+  Py_INCREF(denominator);
+  if (normalize_fraction_components_signs(&numerator, &denominator) < 0 ||
+      normalize_fraction_components_moduli(&numerator, &denominator) < 0) {
+    Py_DECREF(denominator);
+    Py_DECREF(numerator);
+    signal = -1;
+    goto finally;
+  }
+  *result_numerator = numerator;
+  *result_denominator = denominator;
+finally:
+  for (Py_ssize_t index = start; index < stop; ++index)
+    Py_DECREF(registers[index]);
+  return signal;
 }
 
-static PyObject* fraction_repr(FractionObject* self) {
-  return PyUnicode_FromFormat("Fraction(%R, %R)", self->numerator,
-                              self->denominator);
+/* Buffers are unpacked to integers, other columns are iterated over. */
+static PyObject* column_fast_snapshot(PyObject* column) {
+  if (!PyObject_CheckBuffer(column) || PyBytes_Check(column))
+    return sequence_fast_snapshot(
+        column, "Columns should be iterables of fractions or buffers.");
+  PyObject* view = PyMemoryView_FromObject(column);
+  if (view == NULL) return NULL;
+  PyObject* result = PySequence_Fast(view, "Columns should be 1-D buffers.");
+  Py_DECREF(view);
+  return result;
 }
 
-static PyObject* fraction_str(FractionObject* self) {
-  PyObject* tmp = PyLong_FromLong(1);
-  int comparison_signal =
-      PyObject_RichCompareBool(self->denominator, tmp, Py_EQ);
-  Py_DECREF(tmp);
-  if (comparison_signal < 0)
+static PyObject* _evaluate_many(PyObject* module, PyObject* args) {
+  PyObject *program_object, *columns_object;
+  if (!PyArg_ParseTuple(args, "OO:_evaluate_many", &program_object,
+                        &columns_object))
     return NULL;
-  else
-    return comparison_signal ? PyUnicode_FromFormat("%S", self->numerator)
-                             : PyUnicode_FromFormat("%S/%S", self->numerator,
-                                                    self->denominator);
+  Program program;
+  if (parse_program(program_object, &program) < 0) return NULL;
+  PyObject *columns = NULL, **snapshots = NULL, **registers = NULL,
+           *one = NULL, *result = NULL;
+  Py_ssize_t columns_count = 0, size = 0;
+  columns = sequence_fast_snapshot(columns_object,
+                                   "Columns should be a sequence.");
+  if (columns == NULL) goto error;
+  columns_count = PySequence_Fast_GET_SIZE(columns);
+  if (2 * columns_count != program.inputs_count) {
+    PyErr_Format(PyExc_ValueError, "Expected %zd columns, but got %zd.",
+                 program.inputs_count / 2, columns_count);
+    goto error;
+  }
+  snapshots = PyMem_Calloc((size_t)columns_count + 1, sizeof(PyObject*));
+  registers =
+      PyMem_Malloc((size_t)(program.inputs_count + program.constants_count +
+                            program.instructions_count + 1) *
+                   sizeof(PyObject*));
+  if (snapshots == NULL || registers == NULL) {
+    PyErr_NoMemory();
+    goto error;
+  }
+  for (Py_ssize_t index = 0; index < columns_count; ++index) {
+    snapshots[index] =
+        column_fast_snapshot(PySequence_Fast_GET_ITEM(columns, index));
+    if (snapshots[index] == NULL) goto error;
+    Py_ssize_t column_size = PySequence_Fast_GET_SIZE(snapshots[index]);
+    if (index && column_size != size) {
+      PyErr_SetString(PyExc_ValueError,
+                      "Columns should have the same length.");
+      goto error;
+    }
+    size = column_size;
+  }
+  one = PyLong_FromLong(1);
+  if (one == NULL) goto error;
+  for (Py_ssize_t index = 0; index < program.constants_count; ++index)
+    registers[program.inputs_count + index] =
+        PyTuple_GET_ITEM(program.constants, index);
+  result = PyList_New(size);
+  if (result == NULL) goto error;
+  PyTypeObject* cls = get_module_state(module)->fraction_type;
+  for (Py_ssize_t row = 0; row < size; ++row) {
+    for (Py_ssize_t index = 0; index < columns_count; ++index) {
+      PyObject* item = PySequence_Fast_GET_ITEM(snapshots[index], row);
+      if (is_fraction(item)) {
+        registers[2 * index] = ((FractionObject*)item)->numerator;
+        registers[2 * index + 1] = ((FractionObject*)item)->denominator;
+      } else if (PyLong_Check(item)) {
+        registers[2 * index] = item;
+        registers[2 * index + 1] = one;
+      } else {
+        PyErr_Format(PyExc_TypeError,
+                     "Values should be fractions or integers, but got %R.",
+                     item);
+        goto error;
+      }
+    }
+    PyObject *numerator, *denominator;
+    if (Program_evaluate(&program, registers, &numerator, &denominator) < 0)
+      goto error;
+    FractionObject* element = construct_fraction(cls, numerator, denominator);
+    if (element == NULL) goto error;
+    PyList_SET_ITEM(result, row, (PyObject*)element);
+  }
+  goto finally;
+error:
+  Py_CLEAR(result);
+finally:
+  if (snapshots != NULL)
+    for (Py_ssize_t index = 0; index < columns_count; ++index)
+      Py_XDECREF(snapshots[index]);
+  PyMem_Free(snapshots);
+  PyMem_Free(registers);
+  Py_XDECREF(one);
+  Py_XDECREF(columns);
+  Program_free(&program);
+  return result;
 }
 
-static PyObject* fraction_int(FractionObject* self) {
-  int is_negative = is_negative_fraction(self);
-  if (is_negative < 0)
-    return NULL;
-  else
-    return is_negative ? fraction_ceil_impl(self) : fraction_floor_impl(self);
+static PyObject* _enter_precision_context(PyObject* module,
+                                          PyObject* Py_UNUSED(args)) {
+  counter_store(&get_module_state(module)->is_precision_used, 1);
+  Py_RETURN_NONE;
 }
 
-static PyObject* fraction_trunc(FractionObject* self,
+static PyObject* _reset_stats(PyObject* Py_UNUSED(module),
+                              PyObject* Py_UNUSED(args)) {
+#ifndef CFRACTIONS_NO_STATS
+  /* all fields are counters */
+  unsigned long long* counters = (unsigned long long*)&stats;
+  for (size_t index = 0; index < sizeof(stats) / sizeof(*counters); ++index)
+    counter_store(&counters[index], 0);
+#endif
+  Py_RETURN_NONE;
+}
+
+static PyObject* _disable_stats(PyObject* Py_UNUSED(module),
                                 PyObject* Py_UNUSED(args)) {
-  return fraction_int(self);
+#ifndef CFRACTIONS_NO_STATS
+  counter_store(&stats_are_enabled, 0);
+#endif
+  Py_RETURN_NONE;
 }
 
-static PyMemberDef fraction_members[] = {
-    {"numerator", T_OBJECT_EX, offsetof(FractionObject, numerator), READONLY,
-     "Numerator of the fraction."},
-    {"denominator", T_OBJECT_EX, offsetof(FractionObject, denominator),
-     READONLY, "Denominator of the fraction."},
-    {NULL, 0, 0, 0, NULL} /* sentinel */
-};
+static PyObject* _enable_stats(PyObject* Py_UNUSED(module),
+                               PyObject* Py_UNUSED(args)) {
+#ifdef CFRACTIONS_NO_STATS
+  PyErr_SetString(PyExc_RuntimeError, "Statistics are compiled out.");
+  return NULL;
+#else
+  counter_store(&stats_are_enabled, 1);
+  Py_RETURN_NONE;
+#endif
+}
 
-static PyMethodDef fraction_methods[] = {
-    {"as_integer_ratio", (PyCFunction)fraction_as_integer_ratio, METH_NOARGS,
-     NULL},
-    {"is_integer", (PyCFunction)fraction_is_integer, METH_NOARGS, NULL},
-    {"limit_denominator", (PyCFunction)fraction_limit_denominator, METH_VARARGS,
-     NULL},
-    {"__ceil__", (PyCFunction)fraction_ceil, METH_NOARGS, NULL},
-    {"__copy__", (PyCFunction)fraction_copy, METH_NOARGS, NULL},
-    {"__deepcopy__", (PyCFunction)fraction_copy, METH_VARARGS, NULL},
-    {"__floor__", (PyCFunction)fraction_floor, METH_NOARGS, NULL},
-    {"__reduce__", (PyCFunction)fraction_reduce, METH_NOARGS, NULL},
-    {"__round__", (PyCFunction)fraction_round, METH_VARARGS, NULL},
-    {"__trunc__", (PyCFunction)fraction_trunc, METH_NOARGS, NULL},
-    {NULL, NULL, 0, NULL} /* sentinel */
-};
+static int stats_dict_set_counter(PyObject* dict, const char* key,
+                                  unsigned long long value) {
+  PyObject* item = PyLong_FromUnsignedLongLong(value);
+  if (item == NULL) return -1;
+  int result = PyDict_SetItemString(dict, key, item);
+  Py_DECREF(item);
+  return result;
+}
 
-static PyNumberMethods fraction_as_number = {
-    .nb_absolute = (unaryfunc)fraction_absolute,
-    .nb_add = fraction_add,
-    .nb_bool = (inquiry)fraction_bool,
-    .nb_divmod = fraction_divmod,
-    .nb_float = (unaryfunc)fraction_float,
-    .nb_floor_divide = fraction_floor_divide,
-    .nb_int = (unaryfunc)fraction_int,
-    .nb_multiply = fraction_multiply,
-    .nb_negative = (unaryfunc)fraction_negative,
-    .nb_positive = (unaryfunc)fraction_positive,
-    .nb_power = fraction_power,
-    .nb_remainder = fraction_remainder,
-    .nb_subtract = fraction_subtract,
-    .nb_true_divide = fraction_true_divide,
-};
+/* Snapshot of counters, operations are keyed by triplets of
+   operation & operands' kinds names, GCDs' bit lengths are keyed by
+   upper bounds of their buckets, zero counts are omitted. */
+static PyObject* _stats(PyObject* Py_UNUSED(module),
+                        PyObject* Py_UNUSED(args)) {
+  Stats snapshot;
+#ifdef CFRACTIONS_NO_STATS
+  int is_enabled = 0;
+  memset(&snapshot, 0, sizeof(snapshot));
+#else
+  int is_enabled = counter_load(&stats_are_enabled) != 0;
+  unsigned long long *counters = (unsigned long long*)&stats,
+                     *snapshot_counters = (unsigned long long*)&snapshot;
+  for (size_t index = 0; index < sizeof(stats) / sizeof(*counters); ++index)
+    snapshot_counters[index] = counter_load(&counters[index]);
+#endif
+  PyObject *result = PyDict_New(), *operations = NULL, *gcd_bits = NULL;
+  if (result == NULL) return NULL;
+  operations = PyDict_New();
+  if (operations == NULL) goto error;
+  for (size_t operation = 0; operation < OPERATIONS_COUNT; ++operation)
+    for (size_t first = 0; first < OPERAND_KINDS_COUNT; ++first)
+      for (size_t second = 0; second < OPERAND_KINDS_COUNT; ++second) {
+        unsigned long long count =
+            snapshot.operations[operation][first][second];
+        if (!count) continue;
+        PyObject* key = Py_BuildValue("(sss)", operations_names[operation],
+                                      operand_kinds_names[first],
+                                      operand_kinds_names[second]);
+        if (key == NULL) goto error;
+        PyObject* value = PyLong_FromUnsignedLongLong(count);
+        int signal =
+            value == NULL ? -1 : PyDict_SetItem(operations, key, value);
+        Py_XDECREF(value);
+        Py_DECREF(key);
+        if (signal < 0) goto error;
+      }
+  gcd_bits = PyDict_New();
+  if (gcd_bits == NULL) goto error;
+  for (size_t bucket = 0; bucket < GCD_BITS_BUCKETS_COUNT; ++bucket) {
+    if (!snapshot.gcd_bits[bucket]) continue;
+    PyObject* key =
+        PyLong_FromSize_t((size_t)1 << (GCD_BITS_MIN_EXPONENT + bucket));
+    if (key == NULL) goto error;
+    PyObject* value = PyLong_FromUnsignedLongLong(snapshot.gcd_bits[bucket]);
+    int signal = value == NULL ? -1 : PyDict_SetItem(gcd_bits, key, value);
+    Py_XDECREF(value);
+    Py_DECREF(key);
+    if (signal < 0) goto error;
+  }
+  if (PyDict_SetItemString(result, "enabled",
+                           is_enabled ? Py_True : Py_False) < 0 ||
+      PyDict_SetItemString(result, "operations", operations) < 0 ||
+      stats_dict_set_counter(result, "rational_checks",
+                             snapshot.rational_checks) < 0 ||
+      stats_dict_set_counter(result, "rational_matches",
+                             snapshot.rational_matches) < 0 ||
+      stats_dict_set_counter(result, "gcd_calls", snapshot.gcd_calls) < 0 ||
+      PyDict_SetItemString(result, "gcd_bits", gcd_bits) < 0 ||
+      stats_dict_set_counter(result, "word_gcd_calls",
+                             snapshot.word_gcd_calls) < 0 ||
+      stats_dict_set_counter(result, "fractions_allocated",
+                             snapshot.fractions_allocated) < 0 ||
+      stats_dict_set_counter(result, "powers_of_ten_cache_hits",
+                             snapshot.powers_of_ten_cache_hits) < 0 ||
+      stats_dict_set_counter(result, "powers_of_ten_cache_misses",
+                             snapshot.powers_of_ten_cache_misses) < 0)
+    goto error;
+  Py_DECREF(gcd_bits);
+  Py_DECREF(operations);
+  return result;
+error:
+  Py_XDECREF(gcd_bits);
+  Py_XDECREF(operations);
+  Py_DECREF(result);
+  return NULL;
+}
 
-static PyTypeObject FractionType = {
-    PyVarObject_HEAD_INIT(NULL, 0).tp_as_number = &fraction_as_number,
-    .tp_basicsize = sizeof(FractionObject),
-    .tp_dealloc = (destructor)fraction_dealloc,
-    .tp_doc = PyDoc_STR("Represents rational numbers in the exact form."),
-    .tp_flags = Py_TPFLAGS_DEFAULT,
-    .tp_hash = (hashfunc)fraction_hash,
-    .tp_itemsize = 0,
-    .tp_members = fraction_members,
-    .tp_methods = fraction_methods,
-    .tp_name = "cfractions.Fraction",
-    .tp_new = fraction_new,
-    .tp_repr = (reprfunc)fraction_repr,
-    .tp_richcompare = (richcmpfunc)fraction_richcompare,
-    .tp_str = (reprfunc)fraction_str,
+static PyMethodDef _cfractions_methods[] = {
+    {"_disable_stats", _disable_stats, METH_NOARGS, NULL},
+    {"_enable_stats", _enable_stats, METH_NOARGS, NULL},
+    {"_enter_precision_context", _enter_precision_context, METH_NOARGS,
+     NULL},
+    {"_evaluate_many", _evaluate_many, METH_VARARGS, NULL},
+    {"_reset_stats", _reset_stats, METH_NOARGS, NULL},
+    {"_stats", _stats, METH_NOARGS, NULL},
+    {"dumps_many", dumps_many, METH_O, NULL},
+    {"farey", farey, METH_O, NULL},
+    {"limit_denominators", limit_denominators, METH_VARARGS, NULL},
+    {"loads_many", loads_many, METH_O, NULL},
+    {"mediants", mediants, METH_VARARGS, NULL},
+    {"parallel_dot", (PyCFunction)(void (*)(void))parallel_dot,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"parallel_sum", (PyCFunction)(void (*)(void))parallel_sum,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"powers", powers, METH_VARARGS, NULL},
+    {"quantize_many", (PyCFunction)(void (*)(void))quantize_many,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"set_growth_hook", set_growth_hook, METH_VARARGS, NULL},
+    {"simplest_between", (PyCFunction)(void (*)(void))simplest_between,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {NULL, NULL, 0, NULL} /* sentinel */
 };
 
-static PyModuleDef _cfractions_module = {
-    PyModuleDef_HEAD_INIT,
-    .m_doc = PyDoc_STR("Python C API alternative to `fractions` module."),
-    .m_name = "cfractions",
-    .m_size = -1,
-};
+static int load_precision(PyObject* module, ModuleState* state) {
+  state->is_precision_used = 0;
+  state->precision = PyContextVar_New("cfractions.precision", NULL);
+  if (state->precision == NULL) return -1;
+  return PyModule_AddObjectRef(module, "_precision", state->precision);
+}
 
-static int load_rational() {
+static int load_rational(ModuleState* state) {
   PyObject* numbers_module = PyImport_ImportModule("numbers");
   if (numbers_module == NULL) return -1;
-  Rational = PyObject_GetAttrString(numbers_module, "Rational");
+  state->rational = PyObject_GetAttrString(numbers_module, "Rational");
   Py_DECREF(numbers_module);
-  return !Rational ? -1 : 0;
+  return !state->rational ? -1 : 0;
 }
 
-static int mark_as_rational(PyObject* python_type) {
+static int mark_as_rational(ModuleState* state, PyObject* python_type) {
   PyObject* register_method_name = PyUnicode_FromString("register");
   if (register_method_name == NULL) return -1;
   PyObject* tmp =
 #if PY3_9_OR_MORE
-      PyObject_CallMethodOneArg(Rational, register_method_name, python_type);
+      PyObject_CallMethodOneArg(state->rational, register_method_name,
+                                python_type);
 #else
-      PyObject_CallMethodObjArgs(Rational, register_method_name, python_type,
-                                 NULL)
+      PyObject_CallMethodObjArgs(state->rational, register_method_name,
+                                 python_type, NULL)
 #endif
   ;
   Py_DECREF(register_method_name);
@@ -2576,25 +7990,179 @@ static int mark_as_rational(PyObject* python_type) {
   return 0;
 }
 
-PyMODINIT_FUNC PyInit__cfractions(void) {
-  PyObject* result;
-  if (PyType_Ready(&FractionType) < 0) return NULL;
-  result = PyModule_Create(&_cfractions_module);
-  if (result == NULL) return NULL;
-  Py_INCREF(&FractionType);
-  if (PyModule_AddObject(result, "Fraction", (PyObject*)&FractionType) < 0) {
-    Py_DECREF(&FractionType);
-    Py_DECREF(result);
+static PyObject* api_from_terms(PyTypeObject* cls, PyObject* numerator,
+                                PyObject* denominator) {
+  PyObject *result_numerator, *result_denominator;
+  if (parse_fraction_components_from_terms(numerator, denominator,
+                                           &result_numerator,
+                                           &result_denominator) < 0)
     return NULL;
-  }
-  if (load_rational() < 0) {
+  return (PyObject*)construct_fraction(cls, result_numerator,
+                                       result_denominator);
+}
+
+static PyObject* api_from_terms_trusted(PyTypeObject* cls,
+                                        PyObject* numerator,
+                                        PyObject* denominator) {
+  Py_INCREF(numerator);
+  Py_INCREF(denominator);
+  return (PyObject*)construct_fraction(cls, numerator, denominator);
+}
+
+static PyObject* api_numerator(PyObject* fraction) {
+  return ((FractionObject*)fraction)->numerator;
+}
+
+static PyObject* api_denominator(PyObject* fraction) {
+  return ((FractionObject*)fraction)->denominator;
+}
+
+static int api_rich_compare_bool(PyObject* first, PyObject* second, int op) {
+  if (!is_fraction(first)) return PyObject_RichCompareBool(first, second, op);
+  PyObject* result = fraction_richcompare((FractionObject*)first, second, op);
+  if (result == Py_NotImplemented) {
     Py_DECREF(result);
-    return NULL;
+    return PyObject_RichCompareBool(first, second, op);
   }
-  if (mark_as_rational((PyObject*)&FractionType) < 0) {
-    Py_DECREF(Rational);
-    Py_DECREF(result);
-    return NULL;
+  if (result == NULL) return -1;
+  int is_true = PyObject_IsTrue(result);
+  Py_DECREF(result);
+  return is_true;
+}
+
+/* Arithmetic entries skip the number protocol dispatch
+   only while slots of fractions support operands,
+   so results are the same as of the corresponding operators. */
+#define DEFINE_API_BINARY_FUNCTION(name, number_function)          \
+  static PyObject* api_##name(PyObject* first, PyObject* second) { \
+    if (is_fraction(first) || is_fraction(second)) {               \
+      PyObject* result = fraction_##name(first, second);           \
+      if (result != Py_NotImplemented) return result;              \
+      Py_DECREF(result);                                           \
+    }                                                              \
+    return number_function(first, second);                         \
   }
+
+DEFINE_API_BINARY_FUNCTION(add, PyNumber_Add)
+DEFINE_API_BINARY_FUNCTION(multiply, PyNumber_Multiply)
+DEFINE_API_BINARY_FUNCTION(subtract, PyNumber_Subtract)
+DEFINE_API_BINARY_FUNCTION(true_divide, PyNumber_TrueDivide)
+
+static Py_hash_t api_hash(PyObject* fraction) {
+  return fraction_hash((FractionObject*)fraction);
+}
+
+static int load_api(PyObject* module, ModuleState* state) {
+  state->api = (CFractionsAPI){
+      .version = CFRACTIONS_API_VERSION,
+      .fraction_type = state->fraction_type,
+      .check = is_fraction,
+      .from_terms = api_from_terms,
+      .from_terms_trusted = api_from_terms_trusted,
+      .numerator = api_numerator,
+      .denominator = api_denominator,
+      .add = api_add,
+      .subtract = api_subtract,
+      .multiply = api_multiply,
+      .true_divide = api_true_divide,
+      .rich_compare_bool = api_rich_compare_bool,
+      .hash = api_hash,
+  };
+  PyObject* capsule =
+      PyCapsule_New(&state->api, CFRACTIONS_API_CAPSULE_NAME, NULL);
+  if (capsule == NULL) return -1;
+  int result = PyModule_AddObjectRef(module, "_C_API", capsule);
+  Py_DECREF(capsule);
   return result;
 }
+
+static int load_type(PyObject* module, PyType_Spec* spec,
+                     PyTypeObject** result) {
+  *result = (PyTypeObject*)PyType_FromModuleAndSpec(module, spec, NULL);
+  return *result == NULL ? -1 : 0;
+}
+
+static int _cfractions_exec(PyObject* module) {
+  ModuleState* state = get_module_state(module);
+  if (load_type(module, &fraction_spec, &state->fraction_type) < 0 ||
+      load_type(module, &continued_fraction_iterator_spec,
+                &state->continued_fraction_iterator_type) < 0 ||
+      load_type(module, &convergents_iterator_spec,
+                &state->convergents_iterator_type) < 0 ||
+      load_type(module, &farey_iterator_spec, &state->farey_iterator_type) <
+          0 ||
+      load_type(module, &mediants_iterator_spec,
+                &state->mediants_iterator_type) < 0 ||
+      load_type(module, &lazy_fraction_spec, &state->lazy_fraction_type) <
+          0 ||
+      load_powers_of_ten(state) < 0 || load_precision(module, state) < 0 ||
+      load_rational(state) < 0 ||
+      PyModule_AddType(module, state->fraction_type) < 0 ||
+      load_api(module, state) < 0 ||
+      mark_as_rational(state, (PyObject*)state->fraction_type) < 0 ||
+      PyModule_AddType(module, state->lazy_fraction_type) < 0 ||
+      mark_as_rational(state, (PyObject*)state->lazy_fraction_type) < 0)
+    return -1;
+  return 0;
+}
+
+static int _cfractions_traverse(PyObject* module, visitproc visit, void* arg) {
+  ModuleState* state = get_module_state(module);
+  Py_VISIT(state->fraction_type);
+  Py_VISIT(state->continued_fraction_iterator_type);
+  Py_VISIT(state->convergents_iterator_type);
+  Py_VISIT(state->farey_iterator_type);
+  Py_VISIT(state->mediants_iterator_type);
+  Py_VISIT(state->lazy_fraction_type);
+  Py_VISIT(state->rational);
+  Py_VISIT(state->growth_hook);
+  Py_VISIT(state->precision);
+  return 0;
+}
+
+static int _cfractions_clear(PyObject* module) {
+  ModuleState* state = get_module_state(module);
+  Py_CLEAR(state->fraction_type);
+  Py_CLEAR(state->continued_fraction_iterator_type);
+  Py_CLEAR(state->convergents_iterator_type);
+  Py_CLEAR(state->farey_iterator_type);
+  Py_CLEAR(state->mediants_iterator_type);
+  Py_CLEAR(state->lazy_fraction_type);
+  Py_CLEAR(state->rational);
+  Py_CLEAR(state->growth_hook);
+  Py_CLEAR(state->precision);
+  for (size_t index = 0; index < POWERS_OF_TEN_CACHE_SIZE; ++index)
+    Py_CLEAR(state->powers_of_ten[index]);
+  return 0;
+}
+
+static void _cfractions_free(void* module) {
+  _cfractions_clear((PyObject*)module);
+}
+
+static PyModuleDef_Slot _cfractions_slots[] = {
+    {Py_mod_exec, (void*)_cfractions_exec},
+#if PY3_12_OR_MORE
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+#endif
+#if PY3_13_OR_MORE
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL},
+};
+
+static PyModuleDef _cfractions_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_doc = PyDoc_STR("Python C API alternative to `fractions` module."),
+    .m_methods = _cfractions_methods,
+    .m_name = "cfractions",
+    .m_size = sizeof(ModuleState),
+    .m_slots = _cfractions_slots,
+    .m_traverse = _cfractions_traverse,
+    .m_clear = _cfractions_clear,
+    .m_free = _cfractions_free,
+};
+
+PyMODINIT_FUNC PyInit__cfractions(void) {
+  return PyModuleDef_Init(&_cfractions_module);
+}
@@ -0,0 +1,60 @@
+/* Extension using the C API the way third-party ones do,
+   built by tests against the installed header. */
+#define PY_SSIZE_T_CLEAN
+#include <cfractions.h>
+
+#define DEFINE_BINARY_FUNCTION(name, api_function)                     \
+  static PyObject* name(PyObject* Py_UNUSED(module), PyObject* args) { \
+    PyObject *first, *second;                                          \
+    if (!PyArg_ParseTuple(args, "OO:" #name, &first, &second))         \
+      return NULL;                                                     \
+    return api_function(first, second);                                \
+  }
+
+DEFINE_BINARY_FUNCTION(add, CFractions_Add)
+DEFINE_BINARY_FUNCTION(multiply, CFractions_Multiply)
+DEFINE_BINARY_FUNCTION(subtract, CFractions_Subtract)
+DEFINE_BINARY_FUNCTION(true_divide, CFractions_TrueDivide)
+
+static PyObject* check(PyObject* Py_UNUSED(module), PyObject* object) {
+  return PyBool_FromLong(CFractions_Check(object));
+}
+
+static PyObject* from_terms(PyObject* Py_UNUSED(module), PyObject* args) {
+  PyObject *numerator, *denominator;
+  if (!PyArg_ParseTuple(args, "OO:from_terms", &numerator, &denominator))
+    return NULL;
+  return CFractions_FromTerms(numerator, denominator);
+}
+
+static PyObject* terms(PyObject* Py_UNUSED(module), PyObject* fraction) {
+  if (!CFractions_Check(fraction)) {
+    PyErr_SetString(PyExc_TypeError, "Expected a fraction.");
+    return NULL;
+  }
+  return PyTuple_Pack(2, CFractions_Numerator(fraction),
+                      CFractions_Denominator(fraction));
+}
+
+static PyMethodDef consumer_methods[] = {
+    {"add", add, METH_VARARGS, NULL},
+    {"check", check, METH_O, NULL},
+    {"from_terms", from_terms, METH_VARARGS, NULL},
+    {"multiply", multiply, METH_VARARGS, NULL},
+    {"subtract", subtract, METH_VARARGS, NULL},
+    {"terms", terms, METH_O, NULL},
+    {"true_divide", true_divide, METH_VARARGS, NULL},
+    {NULL, NULL, 0, NULL} /* sentinel */
+};
+
+static PyModuleDef consumer_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_methods = consumer_methods,
+    .m_name = "cfractions_consumer",
+    .m_size = -1,
+};
+
+PyMODINIT_FUNC PyInit_cfractions_consumer(void) {
+  if (CFractions_ImportAPI() < 0) return NULL;
+  return PyModule_Create(&consumer_module);
+}
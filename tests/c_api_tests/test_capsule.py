@@ -0,0 +1,163 @@
+from __future__ import annotations
+
+import ctypes
+import operator
+import os
+from collections.abc import Callable
+from typing import Any
+
+import pytest
+from hypothesis import given, strategies as st
+
+import cfractions
+from cfractions import Fraction
+from tests.fraction_tests import strategies
+
+if not hasattr(cfractions, '_C_API'):
+    pytest.skip('C API is not available', allow_module_level=True)
+
+_binary_function = ctypes.PYFUNCTYPE(
+    ctypes.py_object, ctypes.py_object, ctypes.py_object
+)
+_constructor = ctypes.PYFUNCTYPE(
+    ctypes.py_object, ctypes.py_object, ctypes.py_object, ctypes.py_object
+)
+_term_accessor = ctypes.PYFUNCTYPE(ctypes.c_void_p, ctypes.py_object)
+
+
+class _CFractionsAPI(ctypes.Structure):
+    _fields_ = (
+        ('version', ctypes.c_uint),
+        ('fraction_type', ctypes.py_object),
+        ('check', ctypes.PYFUNCTYPE(ctypes.c_int, ctypes.py_object)),
+        ('from_terms', _constructor),
+        ('from_terms_trusted', _constructor),
+        ('numerator', _term_accessor),
+        ('denominator', _term_accessor),
+        ('add', _binary_function),
+        ('subtract', _binary_function),
+        ('multiply', _binary_function),
+        ('true_divide', _binary_function),
+        (
+            'rich_compare_bool',
+            ctypes.PYFUNCTYPE(
+                ctypes.c_int, ctypes.py_object, ctypes.py_object, ctypes.c_int
+            ),
+        ),
+        ('hash', ctypes.PYFUNCTYPE(ctypes.c_ssize_t, ctypes.py_object)),
+    )
+
+
+def _load_api() -> Any:
+    get_pointer = ctypes.pythonapi.PyCapsule_GetPointer
+    get_pointer.argtypes = (ctypes.py_object, ctypes.c_char_p)
+    get_pointer.restype = ctypes.c_void_p
+    return ctypes.cast(
+        get_pointer(
+            cfractions._C_API,  # ruff:ignore[private-member-access]
+            b'cfractions._C_API',
+        ),
+        ctypes.POINTER(_CFractionsAPI),
+    ).contents
+
+
+api = _load_api()
+
+
+def _to_object(pointer: int) -> Any:
+    return ctypes.cast(pointer, ctypes.py_object).value
+
+
+def test_header() -> None:
+    assert os.path.isfile(
+        os.path.join(cfractions.get_include(), 'cfractions.h')
+    )
+
+
+def test_basic() -> None:
+    assert api.version >= 1
+    assert api.fraction_type is Fraction
+
+
+@given(strategies.fractions | strategies.integers | st.floats())
+def test_check(value: Any) -> None:
+    assert api.check(value) == isinstance(value, Fraction)
+
+
+@given(strategies.integers, strategies.non_zero_integers)
+def test_from_terms(numerator: int, denominator: int) -> None:
+    result = api.from_terms(Fraction, numerator, denominator)
+
+    assert isinstance(result, Fraction)
+    assert result == Fraction(numerator, denominator)
+
+
+def test_from_terms_invalid() -> None:
+    with pytest.raises(ZeroDivisionError):
+        api.from_terms(Fraction, 1, 0)
+    with pytest.raises(TypeError):
+        api.from_terms(Fraction, 1.0, 1)
+
+
+@given(strategies.fractions)
+def test_terms(fraction: Fraction) -> None:
+    assert (
+        api.from_terms_trusted(
+            Fraction, fraction.numerator, fraction.denominator
+        )
+        == fraction
+    )
+    assert _to_object(api.numerator(fraction)) == fraction.numerator
+    assert _to_object(api.denominator(fraction)) == fraction.denominator
+
+
+@pytest.mark.parametrize(
+    ('name', 'operation'),
+    [
+        ('add', operator.add),
+        ('subtract', operator.sub),
+        ('multiply', operator.mul),
+        ('true_divide', operator.truediv),
+    ],
+)
+@given(
+    strategies.non_zero_fractions,
+    strategies.non_zero_fractions | strategies.non_zero_integers,
+)
+def test_arithmetic(
+    name: str,
+    operation: Callable[[Any, Any], Any],
+    first: Fraction,
+    second: Fraction | int,
+) -> None:
+    function = getattr(api, name)
+
+    assert function(first, second) == operation(first, second)
+    assert function(second, first) == operation(second, first)
+
+
+@pytest.mark.parametrize(
+    ('op', 'operation'),
+    [
+        (0, operator.lt),
+        (1, operator.le),
+        (2, operator.eq),
+        (3, operator.ne),
+        (4, operator.gt),
+        (5, operator.ge),
+    ],
+)
+@given(strategies.fractions, strategies.fractions | strategies.integers)
+def test_rich_compare_bool(
+    op: int,
+    operation: Callable[[Any, Any], bool],
+    first: Fraction,
+    second: Fraction | int,
+) -> None:
+    assert api.rich_compare_bool(first, second, op) == operation(first, second)
+    assert api.rich_compare_bool(second, first, op) == operation(second, first)
+
+
+@given(strategies.fractions)
+def test_hash(fraction: Fraction) -> None:
+    assert api.hash(fraction) == hash(fraction)
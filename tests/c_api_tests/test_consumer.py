@@ -0,0 +1,135 @@
+from __future__ import annotations
+
+import importlib.util
+import operator
+import os
+import re
+from collections.abc import Callable
+from decimal import Decimal
+from pathlib import Path
+from typing import Any
+
+import pytest
+from hypothesis import given
+
+import cfractions
+from cfractions import Fraction
+from tests.fraction_tests import strategies
+
+if not hasattr(cfractions, '_C_API'):
+    pytest.skip('C API is not available', allow_module_level=True)
+
+
+@pytest.fixture(scope='module')
+def consumer(tmp_path_factory: pytest.TempPathFactory) -> Any:
+    setuptools = pytest.importorskip('setuptools')
+    build_ext = pytest.importorskip('setuptools.command.build_ext').build_ext
+
+    directory = tmp_path_factory.mktemp('consumer')
+    distribution = setuptools.Distribution(
+        {
+            'ext_modules': [
+                setuptools.Extension(
+                    'cfractions_consumer',
+                    [os.path.join(os.path.dirname(__file__), 'consumer.c')],
+                    include_dirs=[cfractions.get_include()],
+                )
+            ]
+        }
+    )
+    command = build_ext(distribution)
+    command.build_lib = command.build_temp = str(directory)
+    command.ensure_finalized()
+    command.run()
+    (path,) = Path(directory).glob('cfractions_consumer*')
+    spec = importlib.util.spec_from_file_location('cfractions_consumer', path)
+    assert spec is not None
+    assert spec.loader is not None
+    result = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(result)
+    return result
+
+
+@given(strategies.integers, strategies.non_zero_integers)
+def test_terms(consumer: Any, numerator: int, denominator: int) -> None:
+    result = consumer.from_terms(numerator, denominator)
+
+    assert consumer.check(result)
+    assert result == Fraction(numerator, denominator)
+    assert consumer.terms(result) == (result.numerator, result.denominator)
+
+
+@pytest.mark.parametrize(
+    ('name', 'operation'),
+    [
+        ('add', operator.add),
+        ('subtract', operator.sub),
+        ('multiply', operator.mul),
+        ('true_divide', operator.truediv),
+    ],
+)
+@given(
+    strategies.non_zero_fractions,
+    strategies.non_zero_fractions | strategies.non_zero_integers,
+)
+def test_arithmetic(
+    consumer: Any,
+    name: str,
+    operation: Callable[[Any, Any], Any],
+    first: Fraction,
+    second: Fraction | int,
+) -> None:
+    function = getattr(consumer, name)
+
+    assert function(first, second) == operation(first, second)
+    assert function(second, first) == operation(second, first)
+
+
+@pytest.mark.parametrize(
+    ('name', 'operation'),
+    [
+        ('add', operator.add),
+        ('subtract', operator.sub),
+        ('multiply', operator.mul),
+        ('true_divide', operator.truediv),
+    ],
+)
+def test_non_fraction_operands(
+    consumer: Any, name: str, operation: Callable[[Any, Any], Any]
+) -> None:
+    function = getattr(consumer, name)
+
+    assert function(3, 2) == operation(3, 2)
+    assert function(Decimal(3), 2) == operation(Decimal(3), 2)
+
+
+@pytest.mark.parametrize(
+    ('name', 'operation'),
+    [
+        ('add', operator.add),
+        ('subtract', operator.sub),
+        ('multiply', operator.mul),
+        ('true_divide', operator.truediv),
+    ],
+)
+@pytest.mark.parametrize(
+    ('first', 'second'),
+    [
+        (Fraction(1, 2), 'x'),
+        (Fraction(1, 2), Decimal(1)),
+        ('x', Fraction(1, 2)),
+    ],
+)
+def test_unsupported_operands(
+    consumer: Any,
+    name: str,
+    operation: Callable[[Any, Any], Any],
+    first: Any,
+    second: Any,
+) -> None:
+    function = getattr(consumer, name)
+
+    with pytest.raises(TypeError) as expected:
+        operation(first, second)
+    with pytest.raises(TypeError, match=re.escape(str(expected.value))):
+        function(first, second)
@@ -0,0 +1,117 @@
+from __future__ import annotations
+
+import io
+from multiprocessing import shared_memory
+from pathlib import Path
+
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction
+from cfractions.columnar import FractionsTable, dump, dumps
+from tests.fraction_tests import strategies
+
+values_lists = st.lists(strategies.fractions | strategies.integers)
+
+
+@given(values_lists)
+def test_round_trip(values: list[Fraction | int]) -> None:
+    with FractionsTable(dumps(values)) as result:
+        assert len(result) == len(values)
+        assert all(type(element) is Fraction for element in result)
+        assert list(result) == values
+
+
+@given(values_lists, st.data())
+def test_random_access(
+    values: list[Fraction | int], data: st.DataObject
+) -> None:
+    with FractionsTable(dumps(values)) as result:
+        if values:
+            index = data.draw(st.integers(-len(values), len(values) - 1))
+
+            assert result[index] == values[index]
+
+        item = data.draw(st.slices(len(values)))
+
+        assert result[item] == values[item]
+
+        with pytest.raises(IndexError):
+            result[len(values)]
+
+
+@given(values_lists)
+def test_dump(values: list[Fraction | int]) -> None:
+    stream = io.BytesIO()
+
+    dump(values, stream)
+
+    assert stream.getvalue() == dumps(values)
+
+
+def test_mapped_file(tmp_path: Path) -> None:
+    values: list[Fraction | int] = [
+        Fraction(1, 3),
+        Fraction(-(2**100), 3**50),
+        2**64,
+        0,
+    ]
+    path = tmp_path / 'fractions.bin'
+    path.write_bytes(dumps(values))
+
+    with FractionsTable.open(path) as result:
+        assert list(result) == values
+
+
+def test_shared_memory() -> None:
+    values: list[Fraction | int] = [
+        Fraction(1, 3),
+        Fraction(-(2**100), 3**50),
+        2**64,
+        0,
+    ]
+    data = dumps(values)
+    memory = shared_memory.SharedMemory(create=True, size=len(data))
+    try:
+        assert memory.buf is not None
+        memory.buf[: len(data)] = data
+        attached = shared_memory.SharedMemory(name=memory.name)
+        try:
+            assert attached.buf is not None
+            with FractionsTable(attached.buf) as result:
+                assert list(result) == values
+        finally:
+            attached.close()
+    finally:
+        memory.close()
+        memory.unlink()
+
+
+def test_invalid_values() -> None:
+    with pytest.raises(TypeError):
+        dumps([0.5])  # type: ignore[list-item]
+
+
+@pytest.mark.parametrize(
+    ('data', 'message'),
+    [
+        (b'', 'truncated'),
+        (b'CFRACTNS' + bytes(24), 'version'),
+        (bytes(32), 'not a fractions table'),
+        (dumps([Fraction(1, 3)])[:-1], 'truncated'),
+        (dumps([2**64])[:-1], 'truncated'),
+    ],
+)
+def test_invalid_data(data: bytes, message: str) -> None:
+    with pytest.raises(ValueError, match=message):
+        FractionsTable(data)
+
+
+def test_non_canonical_data() -> None:
+    data = bytearray(dumps([Fraction(1, 2)]))
+    data[32:40] = (2).to_bytes(8, 'little', signed=True)
+    data[40:48] = (4).to_bytes(8, 'little', signed=True)
+    table = FractionsTable(bytes(data))
+
+    with pytest.raises(ValueError, match='coprime'):
+        table[0]
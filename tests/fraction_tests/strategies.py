@@ -7,12 +7,16 @@ from typing import Any
 
 from hypothesis import strategies as st
 
+import cfractions
 from cfractions import Fraction
 from tests.utils import Integral, Rational
 
 zero_integers = st.just(0)
 small_integers = st.integers(1, 5)
 precisions = st.none() | st.integers(-10, 10)
+large_precisions = st.integers(-100, 100)
+bases = st.integers(2, 36)
+max_digits = st.integers(0, 100)
 integers = numerators = st.integers()
 integers_64 = st.integers(min_value=-(2**63), max_value=2**63 - 1)
 negative_integers = st.integers(max_value=-1)
@@ -55,11 +59,39 @@ fractions = st.builds(Fraction, numerators, denominators) | st.builds(
     Fraction, finite_floats
 )
 negative_fractions = st.builds(Fraction, negative_integers, positive_integers)
+small_denominators_fractions = st.builds(
+    Fraction, numerators, st.integers(-1000, -1) | st.integers(1, 1000)
+)
 int64_fractions = st.builds(Fraction, integers_64, denominators)
+continued_fractions_terms = st.builds(
+    lambda first, rest: [first, *rest],
+    integers,
+    st.lists(positive_integers, max_size=100),
+)
+positive_fractions = st.builds(Fraction, positive_integers, positive_integers)
+non_negative_fractions = zero_fractions | positive_fractions
+small_max_denominators = st.integers(1, 30)
+quantization_steps = (
+    positive_integers
+    | positive_fractions
+    | st.builds(Fraction, st.just(1), positive_integers)
+)
+rounding_modes = st.sampled_from(
+    [
+        cfractions.ROUND_CEILING,
+        cfractions.ROUND_DOWN,
+        cfractions.ROUND_FLOOR,
+        cfractions.ROUND_HALF_DOWN,
+        cfractions.ROUND_HALF_EVEN,
+        cfractions.ROUND_HALF_UP,
+        cfractions.ROUND_UP,
+    ]
+)
 non_zero_fractions = st.builds(Fraction, non_zero_integers, denominators)
 ones: st.SearchStrategy[Rational] = st.just(1)
 ones |= st.builds(Fraction, ones)
 small_positive_integral_fractions = st.builds(Fraction, small_integers)
+small_negative_integral_fractions = st.builds(Fraction, st.integers(-5, -1))
 finite_non_zero_reals = (
     non_zero_integers | finite_non_zero_floats | non_zero_fractions
 )
@@ -146,7 +178,14 @@ class CustomObjectWithAnyReturnAsIntegerRatioMethod:
         return f'{type(self).__qualname__}({self.value!r})'
 
 
+class CustomInteger(int):
+    pass
+
+
 custom_rationals = st.builds(CustomRational, numerators, denominators)
+integers_subclasses_instances = st.booleans() | st.builds(
+    CustomInteger, integers
+)
 custom_objects_with_valid_as_integer_ratio_method = st.builds(
     CustomObjectWithValidAsIntegerRatioMethod,
     st.tuples(numerators, denominators),
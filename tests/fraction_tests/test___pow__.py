@@ -70,6 +70,14 @@ def test_integer_argument(base: Fraction, exponent: int) -> None:
     assert result == base ** Fraction(exponent)
 
 
+@given(strategies.integers_subclasses_instances, strategies.small_integers)
+def test_integers_subclasses_components(base: int, exponent: int) -> None:
+    result = Fraction(base) ** exponent
+
+    assert type(result.numerator) is int
+    assert type(result.denominator) is int
+
+
 @given(
     strategies.fractions,
     strategies.rationals,
@@ -133,6 +141,18 @@ def test_rtruediv_operand(
     )
 
 
+@given(
+    strategies.non_negative_fractions,
+    strategies.small_integers,
+    strategies.small_integers,
+)
+def test_exact_root(base: Fraction, root_degree: int, degree: int) -> None:
+    result = (base**root_degree) ** Fraction(degree, root_degree)
+
+    assert isinstance(result, Fraction)
+    assert result == base**degree
+
+
 @given(
     strategies.int64_fractions, strategies.small_non_negative_integral_floats
 )
@@ -35,3 +35,11 @@ def test_value(fraction: Fraction, precision: int | None) -> None:
         if precision is None
         else result == (round(fraction * base**precision) / base**precision)
     )
+
+
+@given(strategies.fractions, strategies.large_precisions)
+def test_large_precision(fraction: Fraction, precision: int) -> None:
+    result = round(fraction, precision)
+
+    base = Fraction(10)
+    assert result == (round(fraction * base**precision) / base**precision)
@@ -2,7 +2,7 @@ import pytest
 from hypothesis import given
 
 from cfractions import Fraction
-from tests.utils import Real
+from tests.utils import Real, is_fraction_valid
 
 from . import strategies
 
@@ -17,6 +17,29 @@ def test_connection_with_pow(first: int, second: Fraction) -> None:
     assert result == Fraction(first) ** second
 
 
+@given(
+    strategies.integers_subclasses_instances,
+    strategies.small_positive_integral_fractions,
+)
+def test_integers_subclasses(first: int, second: Fraction) -> None:
+    result = first**second
+
+    assert isinstance(result, Fraction)
+    assert type(result.numerator) is int
+    assert type(result.denominator) is int
+
+
+@given(
+    strategies.non_zero_integers, strategies.small_negative_integral_fractions
+)
+def test_negative_exponent(first: int, second: Fraction) -> None:
+    result = first**second
+
+    assert isinstance(result, Fraction)
+    assert is_fraction_valid(result)
+    assert result == Fraction(first) ** second
+
+
 @given(strategies.zero_non_fractions, strategies.negative_fractions)
 def test_zero_base(first: Real, second: Fraction) -> None:
     with pytest.raises(ZeroDivisionError):
@@ -0,0 +1,31 @@
+from hypothesis import given
+
+from cfractions import Fraction
+
+from . import strategies
+
+
+@given(strategies.fractions)
+def test_basic(fraction: Fraction) -> None:
+    result = list(fraction.continued_fraction())
+
+    assert all(isinstance(term, int) for term in result)
+    assert all(term > 0 for term in result[1:])
+
+
+@given(strategies.fractions)
+def test_value(fraction: Fraction) -> None:
+    result = list(fraction.continued_fraction())
+
+    value = Fraction(result[-1])
+    for term in reversed(result[:-1]):
+        value = term + 1 / value
+    assert value == fraction
+
+
+@given(strategies.fractions)
+def test_laziness(fraction: Fraction) -> None:
+    result = fraction.continued_fraction()
+
+    assert iter(result) is result
+    assert next(result) == fraction.__floor__()
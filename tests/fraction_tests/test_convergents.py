@@ -0,0 +1,28 @@
+from itertools import pairwise
+
+from hypothesis import given
+
+from cfractions import Fraction
+from tests.utils import is_fraction_valid
+
+from . import strategies
+
+
+@given(strategies.fractions)
+def test_basic(fraction: Fraction) -> None:
+    result = list(fraction.convergents())
+
+    assert all(isinstance(element, Fraction) for element in result)
+    assert all(is_fraction_valid(element) for element in result)
+
+
+@given(strategies.fractions)
+def test_value(fraction: Fraction) -> None:
+    result = list(fraction.convergents())
+
+    assert result[-1] == fraction
+    assert len(result) == len(list(fraction.continued_fraction()))
+    assert all(
+        abs(next_element - fraction) < abs(element - fraction)
+        for element, next_element in pairwise(result)
+    )
@@ -0,0 +1,41 @@
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction
+from tests.utils import is_fraction_valid
+
+from . import strategies
+
+
+@given(strategies.fractions)
+def test_round_trip(fraction: Fraction) -> None:
+    result = Fraction.from_continued_fraction(fraction.continued_fraction())
+
+    assert is_fraction_valid(result)
+    assert result == fraction
+
+
+@given(strategies.continued_fractions_terms)
+def test_value(terms: list[int]) -> None:
+    result = Fraction.from_continued_fraction(terms)
+
+    value = Fraction(terms[-1])
+    for term in reversed(terms[:-1]):
+        value = term + 1 / value
+    assert is_fraction_valid(result)
+    assert result == value
+
+
+@pytest.mark.parametrize(
+    ('terms', 'message'),
+    [([], 'empty'), ([1, 0], 'positive'), ([1, 2, -3], 'positive')],
+)
+def test_invalid_terms(terms: list[int], message: str) -> None:
+    with pytest.raises(ValueError, match=message):
+        Fraction.from_continued_fraction(terms)
+
+
+@given(st.floats())
+def test_non_integer_terms(term: float) -> None:
+    with pytest.raises(TypeError, match='integers'):
+        Fraction.from_continued_fraction([term])  # type: ignore[list-item]
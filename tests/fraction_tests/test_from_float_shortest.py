@@ -0,0 +1,47 @@
+import math
+
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction
+from tests.utils import is_fraction_valid
+
+from . import strategies
+
+
+@given(strategies.finite_floats)
+def test_basic(value: float) -> None:
+    result = Fraction.from_float_shortest(value)
+
+    assert isinstance(result, Fraction)
+    assert is_fraction_valid(result)
+    assert float(result) == value
+
+
+@given(st.integers(-1000, 1000), st.integers(1, 1000))
+def test_minimality(numerator: int, denominator: int) -> None:
+    result = Fraction.from_float_shortest(numerator / denominator)
+
+    assert result == Fraction(numerator, denominator)
+
+
+@given(strategies.finite_floats)
+def test_negation(value: float) -> None:
+    result = Fraction.from_float_shortest(-value)
+
+    assert result == -Fraction.from_float_shortest(value)
+
+
+def test_infinity() -> None:
+    with pytest.raises(OverflowError, match='infinity'):
+        Fraction.from_float_shortest(math.inf)
+
+
+def test_nan() -> None:
+    with pytest.raises(ValueError, match='NaN'):
+        Fraction.from_float_shortest(math.nan)
+
+
+def test_non_float() -> None:
+    with pytest.raises(TypeError, match='float'):
+        Fraction.from_float_shortest(1)
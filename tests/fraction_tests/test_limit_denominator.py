@@ -1,3 +1,5 @@
+import fractions
+
 from hypothesis import given
 
 from cfractions import Fraction
@@ -26,3 +28,12 @@ def test_default(fraction: Fraction) -> None:
     result = fraction.limit_denominator()
 
     assert result.denominator <= 10**6
+
+
+@given(strategies.int64_fractions, strategies.positive_integers)
+def test_reference(fraction: Fraction, denominator: int) -> None:
+    result = fraction.limit_denominator(denominator)
+
+    assert result == fractions.Fraction(
+        fraction.numerator, fraction.denominator
+    ).limit_denominator(denominator)
@@ -1,5 +1,7 @@
 import pickle
+from typing import Any
 
+import pytest
 from hypothesis import given
 
 from cfractions import Fraction
@@ -7,6 +9,35 @@ from cfractions import Fraction
 from . import strategies
 
 
+class LegacyPickle:
+    def __init__(self, fraction: Fraction) -> None:
+        self.fraction = fraction
+
+    def __reduce__(self) -> tuple[Any, tuple[int, int]]:
+        return Fraction, (self.fraction.numerator, self.fraction.denominator)
+
+
 @given(strategies.fractions)
 def test_round_trip(fraction: Fraction) -> None:
-    assert pickle.loads(pickle.dumps(fraction)) == fraction
+    result = pickle.loads(pickle.dumps(fraction))
+
+    assert type(result) is Fraction
+    assert result.as_integer_ratio() == fraction.as_integer_ratio()
+
+
+@given(strategies.fractions)
+def test_legacy_round_trip(fraction: Fraction) -> None:
+    assert pickle.loads(pickle.dumps(LegacyPickle(fraction))) == fraction
+
+
+@given(strategies.fractions)
+def test_reduce(fraction: Fraction) -> None:
+    assert fraction.__reduce__() == (
+        Fraction._unpickle,  # ruff:ignore[private-member-access]
+        (fraction.numerator, fraction.denominator),
+    )
+
+
+def test_unpickle_non_integers() -> None:
+    with pytest.raises(TypeError):
+        Fraction._unpickle(1.5, 2)  # type: ignore[arg-type]  # ruff:ignore[private-member-access]
@@ -0,0 +1,92 @@
+from __future__ import annotations
+
+import math
+
+import pytest
+from hypothesis import given
+
+import cfractions
+from cfractions import Fraction
+
+from . import strategies
+
+
+@given(strategies.fractions, strategies.quantization_steps)
+def test_basic(fraction: Fraction, step: Fraction | int) -> None:
+    result = fraction.quantize(step)
+
+    assert isinstance(result, Fraction)
+    assert (result / step).is_integer()
+
+
+@given(
+    strategies.fractions,
+    strategies.quantization_steps,
+    strategies.rounding_modes,
+)
+def test_value(
+    fraction: Fraction, step: Fraction | int, rounding: str
+) -> None:
+    result = fraction.quantize(step, rounding=rounding)
+
+    quotient = fraction / step
+    floor, ceiling = math.floor(quotient), math.ceil(quotient)
+    assert result / step in (floor, ceiling)
+    assert (floor == ceiling) is (result == fraction)
+
+
+@given(strategies.fractions, strategies.quantization_steps)
+def test_directed_roundings(fraction: Fraction, step: Fraction | int) -> None:
+    quotient = fraction / step
+
+    assert fraction.quantize(step, cfractions.ROUND_FLOOR) == (
+        math.floor(quotient) * step
+    )
+    assert fraction.quantize(step, cfractions.ROUND_CEILING) == (
+        math.ceil(quotient) * step
+    )
+    assert fraction.quantize(step, cfractions.ROUND_DOWN) == (
+        math.trunc(quotient) * step
+    )
+    assert fraction.quantize(step, cfractions.ROUND_UP) == (
+        (math.ceil(quotient) if quotient >= 0 else math.floor(quotient)) * step
+    )
+
+
+@given(strategies.fractions, strategies.quantization_steps)
+def test_half_even(fraction: Fraction, step: Fraction | int) -> None:
+    result = fraction.quantize(step, cfractions.ROUND_HALF_EVEN)
+
+    assert result == round(fraction / step) * step
+
+
+@given(strategies.fractions, strategies.quantization_steps)
+def test_half_roundings(fraction: Fraction, step: Fraction | int) -> None:
+    half_up_result = fraction.quantize(step, cfractions.ROUND_HALF_UP)
+    half_down_result = fraction.quantize(step, cfractions.ROUND_HALF_DOWN)
+
+    assert abs(half_up_result - fraction) <= Fraction(step) / 2
+    assert abs(half_down_result - fraction) <= Fraction(step) / 2
+    assert (half_up_result == half_down_result) is (
+        abs(half_up_result - fraction) != Fraction(step) / 2
+        or half_up_result == fraction
+    )
+    assert abs(half_up_result) >= abs(half_down_result)
+
+
+@given(strategies.fractions, strategies.rounding_modes)
+def test_invalid_steps(fraction: Fraction, rounding: str) -> None:
+    with pytest.raises(ValueError, match='positive'):
+        fraction.quantize(0, rounding)
+    with pytest.raises(ValueError, match='positive'):
+        fraction.quantize(Fraction(-1, 2), rounding)
+    with pytest.raises(TypeError, match='rational'):
+        fraction.quantize(0.5, rounding)  # type: ignore[arg-type]
+
+
+@given(strategies.fractions, strategies.quantization_steps)
+def test_invalid_rounding_modes(
+    fraction: Fraction, step: Fraction | int
+) -> None:
+    with pytest.raises(ValueError, match='rounding mode'):
+        fraction.quantize(step, 'ROUND_05UP')
@@ -0,0 +1,80 @@
+import pytest
+from hypothesis import given
+
+from cfractions import Fraction
+from tests.utils import is_fraction_valid
+
+from . import strategies
+
+
+@given(
+    strategies.non_negative_fractions,
+    strategies.small_integers,
+    strategies.positive_integers,
+)
+def test_basic(value: Fraction, degree: int, max_denominator: int) -> None:
+    result = value.root(degree, max_denominator)
+
+    assert isinstance(result, Fraction)
+    assert is_fraction_valid(result)
+    assert result.denominator <= max_denominator
+
+
+@given(strategies.fractions, strategies.small_integers)
+def test_exact(value: Fraction, degree: int) -> None:
+    if degree % 2 == 0:
+        value = abs(value)
+
+    result = (value**degree).root(degree, max_denominator=value.denominator)
+
+    assert result == value
+
+
+@given(
+    strategies.small_denominators_fractions,
+    strategies.small_integers,
+    strategies.small_max_denominators,
+)
+def test_best_approximation(
+    value: Fraction, degree: int, max_denominator: int
+) -> None:
+    value = abs(value)
+
+    result = value.root(degree, max_denominator)
+
+    # a candidate is closer to the root than the result
+    # iff the root is on its side of their midpoint
+    assert all(
+        (midpoint**degree <= value if candidate < result else True)
+        and (midpoint**degree >= value if candidate > result else True)
+        for denominator in range(1, max_denominator + 1)
+        for numerator in range(
+            max((result * denominator).__floor__() - 1, 0),
+            (result * denominator).__floor__() + 3,
+        )
+        for candidate in [Fraction(numerator, denominator)]
+        for midpoint in [(candidate + result) / 2]
+    )
+
+
+@given(strategies.negative_fractions, strategies.small_integers)
+def test_negative(value: Fraction, degree: int) -> None:
+    if degree % 2 == 0:
+        with pytest.raises(ValueError, match='non-negative'):
+            value.root(degree)
+    else:
+        assert value.root(degree) == -(-value).root(degree)
+
+
+@given(strategies.fractions)
+def test_invalid_degree(value: Fraction) -> None:
+    with pytest.raises(ValueError, match='positive'):
+        value.root(0)
+    with pytest.raises(TypeError, match='integer'):
+        value.root(0.5)  # type: ignore[arg-type]
+
+
+def test_large_degree() -> None:
+    assert Fraction(7, 3).root(10**6, 10) == 1
+    assert (Fraction(3, 2) ** 10**4).root(10**4, 2) == Fraction(3, 2)
+    assert Fraction(2**100_000 * 3).root(10**5, 1_000) == Fraction(2)
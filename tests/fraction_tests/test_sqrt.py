@@ -0,0 +1,37 @@
+import pytest
+from hypothesis import given
+
+from cfractions import Fraction
+from tests.utils import is_fraction_valid
+
+from . import strategies
+
+
+@given(strategies.non_negative_fractions, strategies.positive_integers)
+def test_basic(value: Fraction, max_denominator: int) -> None:
+    result = value.sqrt(max_denominator=max_denominator)
+
+    assert isinstance(result, Fraction)
+    assert is_fraction_valid(result)
+    assert result.denominator <= max_denominator
+
+
+@given(strategies.non_negative_fractions)
+def test_default(value: Fraction) -> None:
+    result = value.sqrt()
+
+    assert result == value.root(2)
+    assert result.denominator <= 10**6
+
+
+@given(strategies.fractions)
+def test_exact(value: Fraction) -> None:
+    result = (value * value).sqrt(max_denominator=value.denominator)
+
+    assert result == abs(value)
+
+
+@given(strategies.negative_fractions)
+def test_negative(value: Fraction) -> None:
+    with pytest.raises(ValueError, match='non-negative'):
+        value.sqrt()
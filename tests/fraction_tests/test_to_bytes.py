@@ -0,0 +1,51 @@
+import pytest
+from hypothesis import given
+
+from cfractions import Fraction
+
+from . import strategies
+
+
+@given(strategies.fractions)
+def test_basic(fraction: Fraction) -> None:
+    result = fraction.to_bytes()
+
+    assert isinstance(result, bytes)
+
+
+@given(strategies.fractions)
+def test_round_trip(fraction: Fraction) -> None:
+    result = Fraction.from_bytes(fraction.to_bytes())
+
+    assert type(result) is Fraction
+    assert result == fraction
+
+
+@given(strategies.fractions)
+def test_buffers(fraction: Fraction) -> None:
+    data = fraction.to_bytes()
+
+    assert Fraction.from_bytes(bytearray(data)) == fraction
+    assert Fraction.from_bytes(memoryview(data)) == fraction
+
+
+def test_normalization() -> None:
+    assert Fraction.from_bytes(bytes([24, 16])) == Fraction(3, 2)
+
+
+@pytest.mark.parametrize(
+    ('data', 'message'),
+    [
+        (b'', 'truncated'),
+        (b'\x04', 'truncated'),
+        (b'\x80', 'truncated'),
+        (b'\x05', 'truncated'),
+        (b'\x04\x00', 'positive'),
+        (b'\x04\x06', 'positive'),
+        (b'\x04\x04\x00', 'trailing'),
+        (b'\xff' * 10, 'too long'),
+    ],
+)
+def test_invalid_data(data: bytes, message: str) -> None:
+    with pytest.raises(ValueError, match=message):
+        Fraction.from_bytes(data)
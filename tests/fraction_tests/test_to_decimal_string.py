@@ -0,0 +1,58 @@
+from hypothesis import given
+
+from cfractions import Fraction
+
+from . import strategies
+
+
+def to_fraction(string: str, base: int) -> Fraction:
+    sign, string = (-1, string[1:]) if string.startswith('-') else (1, string)
+    integral_part, _, fractional_part = string.removesuffix('...').partition(
+        '.'
+    )
+    prefix, _, period = fractional_part.partition('(')
+    period = period.removesuffix(')')
+    result = Fraction(int(integral_part, base))
+    if prefix:
+        result += Fraction(int(prefix, base), base ** len(prefix))
+    if period:
+        result += Fraction(
+            int(period, base), base ** len(prefix) * (base ** len(period) - 1)
+        )
+    return sign * result
+
+
+@given(strategies.small_denominators_fractions)
+def test_basic(fraction: Fraction) -> None:
+    result = fraction.to_decimal_string()
+
+    assert isinstance(result, str)
+
+
+@given(strategies.small_denominators_fractions, strategies.bases)
+def test_round_trip(fraction: Fraction, base: int) -> None:
+    result = fraction.to_decimal_string(base=base)
+
+    assert to_fraction(result, base) == fraction
+
+
+@given(strategies.fractions, strategies.max_digits, strategies.bases)
+def test_max_digits(fraction: Fraction, max_digits: int, base: int) -> None:
+    result = fraction.to_decimal_string(max_digits, base=base)
+
+    value = to_fraction(result, base)
+    assert (
+        abs(value)
+        <= abs(fraction)
+        < abs(value) + Fraction(1, base**max_digits)
+        if result.endswith('...')
+        else value == fraction
+    )
+
+
+@given(strategies.fractions, strategies.max_digits)
+def test_without_period_detection(fraction: Fraction, max_digits: int) -> None:
+    result = fraction.to_decimal_string(max_digits, detect_period=False)
+
+    assert '(' not in result
+    assert to_fraction(result, 10) == fraction or result.endswith('...')
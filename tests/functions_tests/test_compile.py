@@ -0,0 +1,144 @@
+from __future__ import annotations
+
+import array
+import re
+from typing import Any
+
+import pytest
+from hypothesis import example, given, strategies as st
+
+from cfractions import (
+    Expression,
+    Fraction,
+    compile,  # ruff:ignore[builtin-import-shadowing]
+)
+from tests.fraction_tests import strategies
+from tests.utils import is_fraction_valid
+
+symbols = ('a', 'b', 'c')
+expressions_strings = st.recursive(
+    st.sampled_from(symbols) | st.integers(0, 10).map(str),
+    lambda children: (
+        st.tuples(children, st.sampled_from('+-*/'), children).map(
+            lambda parts: f'({parts[0]} {parts[1]} {parts[2]})'
+        )
+        | children.map(lambda child: f'-{child}')
+    ),
+    max_leaves=10,
+)
+values = strategies.fractions | strategies.integers
+rows = st.tuples(values, values, values)
+
+
+def evaluate_reference(expression: str, row: tuple[Any, ...]) -> Any:
+    try:
+        return eval(
+            re.sub(r'(\d+)', r'Fraction(\1)', expression),
+            {'__builtins__': {}, 'Fraction': Fraction},
+            dict(zip(symbols, map(Fraction, row), strict=True)),
+        )
+    except ZeroDivisionError:
+        return None
+
+
+def evaluate(
+    expression: Expression, columns: list[list[Fraction | int]]
+) -> list[Fraction] | None:
+    try:
+        return expression.evaluate_many(columns)
+    except ZeroDivisionError:
+        return None
+
+
+@given(expressions_strings, st.lists(rows, max_size=10))
+@example(expression='(a / (a / b))', rows=[(-1, 0, 0)])
+def test_connection_with_arithmetic(
+    expression: str, rows: list[tuple[Fraction | int, ...]]
+) -> None:
+    compiled = compile(f'a * 0 + b * 0 + c * 0 + {expression}')
+    references = [evaluate_reference(expression, row) for row in rows]
+
+    result = evaluate(
+        compiled,
+        [[row[index] for row in rows] for index in range(len(symbols))],
+    )
+
+    assert compiled.symbols == symbols
+    if None in references:
+        assert result is None
+    else:
+        assert result is not None
+        assert all(isinstance(element, Fraction) for element in result)
+        assert all(is_fraction_valid(element) for element in result)
+        assert result == [Fraction(reference) for reference in references]
+
+
+@given(rows)
+def test_callable(row: tuple[Fraction | int, ...]) -> None:
+    expression = compile(lambda a, b, c: (a * b + c * 2) / Fraction(3, 4))
+
+    result = expression(*row)
+
+    assert expression.symbols == symbols
+    assert result == (Fraction(row[0]) * row[1] + Fraction(row[2]) * 2) / (
+        Fraction(3, 4)
+    )
+
+
+@given(st.lists(strategies.integers_64, min_size=1), strategies.fractions)
+def test_buffers(numerators: list[int], fraction: Fraction) -> None:
+    expression = compile('x / y + z')
+
+    result = expression.evaluate_many(
+        {
+            'x': array.array('q', numerators),
+            'y': memoryview(array.array('q', [3] * len(numerators))),
+            'z': [fraction] * len(numerators),
+        }
+    )
+
+    assert result == [
+        Fraction(numerator, 3) + fraction for numerator in numerators
+    ]
+
+
+@pytest.mark.parametrize(
+    ('expression', 'row'),
+    [
+        ('a / (a / b)', (Fraction(-1), 0)),
+        ('(a / b) * 0', (1, 0)),
+        ('(a / 2) / (b * 0)', (Fraction(3, 2), 1)),
+        ('a / (b - b)', (1, 2)),
+        ('1 / 0', ()),
+    ],
+)
+def test_zero_division(
+    expression: str, row: tuple[Fraction | int, ...]
+) -> None:
+    with pytest.raises(ZeroDivisionError) as expected:
+        eval(
+            re.sub(r'(\d+)', r'Fraction(\1)', expression),
+            {'__builtins__': {}, 'Fraction': Fraction},
+            dict(zip(symbols, map(Fraction, row), strict=False)),
+        )
+    with pytest.raises(
+        ZeroDivisionError, match=re.escape(str(expected.value))
+    ):
+        compile(expression)(*row)
+
+
+def test_invalid_arguments() -> None:
+    with pytest.raises(ValueError, match='Unsupported expression'):
+        compile('a ** 2')
+    with pytest.raises(ValueError, match='Invalid expression'):
+        compile('a +')
+    with pytest.raises(TypeError, match='string or a callable'):
+        compile(1)  # type: ignore[arg-type]
+    with pytest.raises(ValueError, match='same length'):
+        compile('a + b').evaluate_many([[1], [1, 2]])
+    with pytest.raises(ValueError, match='Expected 2 columns'):
+        compile('a + b').evaluate_many([[1]])
+    with pytest.raises(TypeError, match='fractions or integers'):
+        compile('a').evaluate_many([[0.5]])  # type: ignore[list-item]
+    with pytest.raises(ZeroDivisionError):
+        compile('a / (b - b)')(1, 2)
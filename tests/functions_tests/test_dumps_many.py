@@ -0,0 +1,39 @@
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, dumps_many, loads_many
+from tests.fraction_tests import strategies
+
+
+@given(st.lists(strategies.fractions | strategies.integers))
+def test_round_trip(values: list[Fraction | int]) -> None:
+    result = loads_many(dumps_many(values))
+
+    assert all(type(element) is Fraction for element in result)
+    assert result == values
+
+
+@given(st.lists(strategies.fractions))
+def test_consistency(values: list[Fraction]) -> None:
+    result = dumps_many(values)
+
+    assert result.endswith(b''.join(value.to_bytes() for value in values))
+
+
+def test_invalid_values() -> None:
+    with pytest.raises(TypeError):
+        dumps_many([0.5])  # type: ignore[list-item]
+
+
+@pytest.mark.parametrize(
+    ('data', 'message'),
+    [
+        (b'', 'truncated'),
+        (b'\x01', 'truncated'),
+        (b'\x02\x04\x04', 'truncated'),
+        (b'\x01\x04\x04\x00', 'trailing'),
+    ],
+)
+def test_invalid_data(data: bytes, message: str) -> None:
+    with pytest.raises(ValueError, match=message):
+        loads_many(data)
@@ -0,0 +1,65 @@
+from itertools import pairwise
+
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, farey
+from tests.utils import is_fraction_valid
+
+farey_orders = st.integers(1, 50)
+
+
+@given(farey_orders)
+def test_basic(order: int) -> None:
+    result = list(farey(order))
+
+    assert all(isinstance(element, Fraction) for element in result)
+    assert all(is_fraction_valid(element) for element in result)
+    assert result[0] == 0
+    assert result[-1] == 1
+
+
+@given(farey_orders)
+def test_value(order: int) -> None:
+    result = list(farey(order))
+
+    assert result == sorted(
+        {
+            Fraction(numerator, denominator)
+            for denominator in range(1, order + 1)
+            for numerator in range(denominator + 1)
+        }
+    )
+
+
+@given(farey_orders)
+def test_neighbours(order: int) -> None:
+    result = list(farey(order))
+
+    assert all(
+        next_element.numerator * element.denominator
+        - element.numerator * next_element.denominator
+        == 1
+        for element, next_element in pairwise(result)
+    )
+
+
+@given(farey_orders, st.integers(1, 100))
+def test_fill(order: int, chunk_size: int) -> None:
+    iterator = farey(order)
+    chunk: list[Fraction] = [Fraction()] * chunk_size
+
+    result = []
+    while count := iterator.fill(chunk):
+        result.extend(chunk[:count])
+
+    assert result == list(farey(order))
+
+
+def test_invalid_order() -> None:
+    with pytest.raises(ValueError, match='positive'):
+        farey(0)
+    with pytest.raises(OverflowError, match='too large'):
+        farey(1 << 64)
+    with pytest.raises(TypeError, match='integer'):
+        farey(1.5)  # type: ignore[arg-type]
@@ -0,0 +1,35 @@
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, limit_denominators
+from tests.fraction_tests import strategies
+
+
+@given(
+    st.lists(strategies.fractions | strategies.integers),
+    strategies.positive_integers,
+)
+def test_basic(values: list[Fraction | int], max_denominator: int) -> None:
+    result = limit_denominators(values, max_denominator)
+
+    assert all(type(element) is Fraction for element in result)
+    assert result == [
+        Fraction(value).limit_denominator(max_denominator) for value in values
+    ]
+
+
+@given(st.lists(strategies.fractions | strategies.integers))
+def test_default(values: list[Fraction | int]) -> None:
+    result = limit_denominators(values)
+
+    assert result == [Fraction(value).limit_denominator() for value in values]
+
+
+def test_invalid_values() -> None:
+    with pytest.raises(TypeError, match='fractions or integers'):
+        limit_denominators([0.5])  # type: ignore[list-item]
+
+
+def test_invalid_max_denominator() -> None:
+    with pytest.raises(ValueError, match='less than 1'):
+        limit_denominators([Fraction(1, 3)], 0)
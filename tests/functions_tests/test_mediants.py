@@ -0,0 +1,101 @@
+from itertools import islice, pairwise
+
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, mediants
+from tests.fraction_tests import strategies
+from tests.utils import is_fraction_valid
+
+depths = st.integers(0, 8)
+
+
+@given(strategies.fractions, strategies.fractions, depths)
+def test_basic(first: Fraction, second: Fraction, depth: int) -> None:
+    if first == second:
+        second += 1
+    lower_bound, upper_bound = sorted([first, second])
+
+    result = list(mediants(lower_bound, upper_bound, depth))
+
+    assert len(result) == 2**depth - 1
+    assert all(is_fraction_valid(element) for element in result)
+    assert all(
+        element < next_element for element, next_element in pairwise(result)
+    )
+    assert all(lower_bound < element < upper_bound for element in result)
+
+
+@given(strategies.fractions, strategies.fractions, depths)
+def test_value(first: Fraction, second: Fraction, depth: int) -> None:
+    if first == second:
+        second += 1
+    lower_bound, upper_bound = sorted([first, second])
+
+    result = list(mediants(lower_bound, upper_bound, depth))
+
+    assert result == _to_mediants(
+        lower_bound.numerator,
+        lower_bound.denominator,
+        upper_bound.numerator,
+        upper_bound.denominator,
+        depth,
+    )
+
+
+@given(st.integers(0, 100), st.integers(1, 100))
+def test_fill(depth: int, chunk_size: int) -> None:
+    iterator = mediants(0, 1, depth)
+    chunk: list[Fraction] = [Fraction()] * chunk_size
+
+    result = iterator.fill(chunk)
+
+    assert result == min(chunk_size, 2**depth - 1)
+    assert chunk[:result] == list(islice(mediants(0, 1, depth), result))
+    assert next(iterator, None) == next(
+        islice(mediants(0, 1, depth), result, None), None
+    )
+
+
+def test_invalid_bounds() -> None:
+    with pytest.raises(ValueError, match='less than'):
+        mediants(1, 0, 1)
+    with pytest.raises(TypeError, match='rational numbers'):
+        mediants(0.5, 1, 1)  # type: ignore[arg-type]
+
+
+def test_invalid_depth() -> None:
+    with pytest.raises(ValueError, match='non-negative'):
+        mediants(0, 1, -1)
+
+
+def _to_mediants(
+    lower_numerator: int,
+    lower_denominator: int,
+    upper_numerator: int,
+    upper_denominator: int,
+    depth: int,
+) -> list[Fraction]:
+    if not depth:
+        return []
+    mediant_numerator, mediant_denominator = (
+        lower_numerator + upper_numerator,
+        lower_denominator + upper_denominator,
+    )
+    return [
+        *_to_mediants(
+            lower_numerator,
+            lower_denominator,
+            mediant_numerator,
+            mediant_denominator,
+            depth - 1,
+        ),
+        Fraction(mediant_numerator, mediant_denominator),
+        *_to_mediants(
+            mediant_numerator,
+            mediant_denominator,
+            upper_numerator,
+            upper_denominator,
+            depth - 1,
+        ),
+    ]
@@ -0,0 +1,46 @@
+from operator import mul
+
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, parallel_dot
+from tests.fraction_tests import strategies
+from tests.utils import Rational, is_fraction_valid
+
+workers_counts = st.none() | st.integers(1, 8)
+
+
+@given(
+    st.lists(st.tuples(strategies.rationals, strategies.rationals)),
+    workers_counts,
+)
+def test_basic(
+    pairs: list[tuple[Rational, Rational]], workers: int | None
+) -> None:
+    xs, ys = [x for x, _ in pairs], [y for _, y in pairs]
+
+    result = parallel_dot(xs, ys, workers=workers)
+
+    assert isinstance(result, Fraction)
+    assert is_fraction_valid(result)
+
+
+@given(
+    st.lists(st.tuples(strategies.rationals, strategies.rationals)),
+    workers_counts,
+)
+def test_connection_with_sum(
+    pairs: list[tuple[Rational, Rational]], workers: int | None
+) -> None:
+    xs, ys = [x for x, _ in pairs], [y for _, y in pairs]
+
+    result = parallel_dot(xs, ys, workers=workers)
+
+    assert result == sum(map(mul, map(Fraction, xs), ys), Fraction())
+
+
+def test_invalid_arguments() -> None:
+    with pytest.raises(TypeError, match='rational numbers'):
+        parallel_dot([0.5], [1])  # type: ignore[list-item]
+    with pytest.raises(ValueError, match='same length'):
+        parallel_dot([1], [1, 2])
@@ -0,0 +1,44 @@
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, parallel_sum
+from tests.fraction_tests import strategies
+from tests.utils import Rational, is_fraction_valid
+
+workers_counts = st.none() | st.integers(1, 8)
+
+
+@given(st.lists(strategies.rationals), workers_counts)
+def test_basic(values: list[Rational], workers: int | None) -> None:
+    result = parallel_sum(values, workers=workers)
+
+    assert isinstance(result, Fraction)
+    assert is_fraction_valid(result)
+
+
+@given(st.lists(strategies.rationals), workers_counts)
+def test_connection_with_sum(
+    values: list[Rational], workers: int | None
+) -> None:
+    result = parallel_sum(values, workers=workers)
+
+    assert result == sum(map(Fraction, values), Fraction())
+
+
+@given(
+    st.lists(strategies.int64_fractions, min_size=1, max_size=4),
+    st.integers(1, 8),
+)
+def test_chunks(values: list[Fraction], workers: int) -> None:
+    repetitions = 4_096
+
+    result = parallel_sum(values * repetitions, workers=workers)
+
+    assert result == sum(values, Fraction()) * repetitions
+
+
+def test_invalid_arguments() -> None:
+    with pytest.raises(TypeError, match='rational numbers'):
+        parallel_sum([0.5])  # type: ignore[list-item]
+    with pytest.raises(ValueError, match='positive'):
+        parallel_sum([1], workers=0)
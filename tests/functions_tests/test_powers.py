@@ -0,0 +1,30 @@
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, powers
+from tests.fraction_tests import strategies
+from tests.utils import Rational, is_fraction_valid
+
+
+@given(strategies.rationals, st.integers(0, 100))
+def test_basic(base: Rational, count: int) -> None:
+    result = powers(base, count)
+
+    assert isinstance(result, list)
+    assert len(result) == count
+    assert all(isinstance(element, Fraction) for element in result)
+    assert all(is_fraction_valid(element) for element in result)
+
+
+@given(strategies.rationals, st.integers(0, 100))
+def test_connection_with_pow(base: Rational, count: int) -> None:
+    result = powers(base, count)
+
+    assert result == [Fraction(base) ** exponent for exponent in range(count)]
+
+
+def test_invalid_arguments() -> None:
+    with pytest.raises(TypeError, match='rational number'):
+        powers(0.5, 1)  # type: ignore[arg-type]
+    with pytest.raises(ValueError, match='non-negative'):
+        powers(1, -1)
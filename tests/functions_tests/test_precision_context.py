@@ -0,0 +1,147 @@
+from __future__ import annotations
+
+import asyncio
+import contextvars
+import operator
+import threading
+from collections.abc import Callable
+
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, precision_context
+from tests.fraction_tests import strategies
+from tests.utils import is_fraction_valid
+
+operations = st.sampled_from(
+    [operator.add, operator.sub, operator.mul, operator.truediv]
+)
+max_denominators = st.integers(1, 10**6)
+max_bits = st.integers(1, 64)
+
+
+def apply(
+    operation: Callable[[Fraction, Fraction], Fraction],
+    first: Fraction,
+    second: Fraction,
+) -> Fraction | None:
+    try:
+        return operation(first, second)
+    except ZeroDivisionError:
+        return None
+
+
+@given(
+    strategies.fractions, strategies.fractions, operations, max_denominators
+)
+def test_max_denominator(
+    first: Fraction,
+    second: Fraction,
+    operation: Callable[[Fraction, Fraction], Fraction],
+    max_denominator: int,
+) -> None:
+    exact = apply(operation, first, second)
+
+    with precision_context(max_denominator=max_denominator):
+        result = apply(operation, first, second)
+
+    if exact is None:
+        assert result is None
+    else:
+        assert isinstance(result, Fraction)
+        assert is_fraction_valid(result)
+        assert result == exact.limit_denominator(max_denominator)
+
+
+@given(strategies.fractions, strategies.fractions, operations, max_bits)
+def test_max_bits(
+    first: Fraction,
+    second: Fraction,
+    operation: Callable[[Fraction, Fraction], Fraction],
+    max_bits: int,
+) -> None:
+    exact = apply(operation, first, second)
+
+    with precision_context(max_bits=max_bits):
+        result = apply(operation, first, second)
+
+    if exact is None:
+        assert result is None
+    else:
+        assert isinstance(result, Fraction)
+        assert is_fraction_valid(result)
+        assert result.denominator.bit_length() <= max_bits
+        assert abs(result - exact) <= Fraction(
+            exact.denominator + 2 * abs(exact.numerator),
+            exact.denominator << max_bits,
+        )
+
+
+@given(strategies.fractions, strategies.fractions, operations)
+def test_exactness_outside(
+    first: Fraction,
+    second: Fraction,
+    operation: Callable[[Fraction, Fraction], Fraction],
+) -> None:
+    exact = apply(operation, first, second)
+
+    with precision_context(max_denominator=1), precision_context():
+        nested_result = apply(operation, first, second)
+    result = apply(operation, first, second)
+
+    assert nested_result == result == exact
+
+
+def test_after_inner_contexts() -> None:
+    with precision_context(max_denominator=2):
+        with precision_context():
+            pass
+        with pytest.raises(ZeroDivisionError), precision_context():
+            Fraction(1, 3) / 0
+        result = Fraction(1, 3) + Fraction(1, 7)
+
+    assert result == Fraction(1, 2)
+    assert Fraction(1, 3) + Fraction(1, 7) == Fraction(10, 21)
+
+
+def test_outliving_contexts() -> None:
+    async def work() -> Fraction:
+        await asyncio.sleep(0)
+        return Fraction(1, 3) * Fraction(1, 7)
+
+    async def run() -> tuple[Fraction, Fraction]:
+        with precision_context(max_denominator=1):
+            task = asyncio.create_task(work())
+            context = contextvars.copy_context()
+        return await task, context.run(
+            operator.mul, Fraction(1, 3), Fraction(1, 7)
+        )
+
+    task_result, context_result = asyncio.run(run())
+
+    assert task_result == context_result == 0
+    assert Fraction(1, 3) * Fraction(1, 7) == Fraction(1, 21)
+
+
+def test_threads_isolation() -> None:
+    results: list[Fraction] = []
+
+    def work() -> None:
+        results.append(Fraction(1, 3) + Fraction(1, 7))
+
+    with precision_context(max_denominator=2):
+        thread = threading.Thread(target=work)
+        thread.start()
+        thread.join()
+        results.append(Fraction(1, 3) + Fraction(1, 7))
+
+    assert results == [Fraction(10, 21), Fraction(1, 2)]
+
+
+def test_invalid_arguments() -> None:
+    with pytest.raises(ValueError, match='less than 1'):
+        precision_context(max_denominator=0).__enter__()
+    with pytest.raises(ValueError, match='positive'):
+        precision_context(max_bits=0).__enter__()
+    with pytest.raises(TypeError, match='integer or None'):
+        precision_context(max_bits=0.5).__enter__()  # type: ignore[arg-type]
@@ -0,0 +1,28 @@
+from __future__ import annotations
+
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, quantize_many
+from tests.fraction_tests import strategies
+
+
+@given(
+    st.lists(strategies.fractions | strategies.integers),
+    strategies.quantization_steps,
+    strategies.rounding_modes,
+)
+def test_basic(
+    values: list[Fraction | int], step: Fraction | int, rounding: str
+) -> None:
+    result = quantize_many(values, step, rounding=rounding)
+
+    assert all(type(element) is Fraction for element in result)
+    assert result == [
+        Fraction(value).quantize(step, rounding) for value in values
+    ]
+
+
+def test_invalid_values() -> None:
+    with pytest.raises(TypeError, match='fractions or integers'):
+        quantize_many([0.5], 1)  # type: ignore[list-item]
@@ -0,0 +1,100 @@
+import gc
+import threading
+import weakref
+from collections.abc import Iterator
+
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, set_growth_hook
+from tests.fraction_tests import strategies
+
+
+@pytest.fixture(autouse=True)
+def reset_growth_hook() -> Iterator[None]:
+    yield
+    set_growth_hook(0, None)
+
+
+@given(strategies.fractions, strategies.fractions, st.integers(0, 100))
+def test_basic(first: Fraction, second: Fraction, threshold_bits: int) -> None:
+    calls: list[tuple[int, int]] = []
+    set_growth_hook(
+        threshold_bits,
+        lambda numerator_bits, denominator_bits: calls.append(
+            (numerator_bits, denominator_bits)
+        ),
+    )
+
+    result = first * second
+
+    set_growth_hook(0, None)
+    expected_bits = (
+        result.numerator.bit_length(),
+        result.denominator.bit_length(),
+    )
+    assert (expected_bits in calls) is (max(expected_bits) > threshold_bits)
+    assert all(max(bits) > threshold_bits for bits in calls)
+
+
+def test_raising_hook() -> None:
+    def hook(numerator_bits: int, denominator_bits: int) -> None:
+        raise OverflowError(numerator_bits, denominator_bits)
+
+    set_growth_hook(64, hook)
+
+    with pytest.raises(OverflowError) as error:
+        Fraction(2**40, 3) * Fraction(2**40, 7)
+    assert error.value.args == (81, 5)
+    assert Fraction(2**40, 3) * Fraction(1, 7) == Fraction(2**40, 21)
+
+
+def test_replaced_hook() -> None:
+    class Hook:
+        def __call__(self, numerator_bits: int, denominator_bits: int) -> None:
+            pass
+
+    hook = Hook()
+    hook_reference = weakref.ref(hook)
+    set_growth_hook(0, hook)
+    Fraction(2**40, 3)
+    del hook
+
+    set_growth_hook(0, None)
+
+    gc.collect()
+    assert hook_reference() is None
+
+
+def test_concurrent_replacing() -> None:
+    calls: list[tuple[int, int]] = []
+    is_done = threading.Event()
+
+    def construct() -> None:
+        while not is_done.is_set():
+            Fraction(2**40, 3) * Fraction(2**40, 7)
+
+    threads = [threading.Thread(target=construct) for _ in range(4)]
+    for thread in threads:
+        thread.start()
+    try:
+        for threshold_bits in range(1_000):
+            set_growth_hook(
+                threshold_bits % 100,
+                lambda numerator_bits, denominator_bits: calls.append(
+                    (numerator_bits, denominator_bits)
+                ),
+            )
+    finally:
+        is_done.set()
+        for thread in threads:
+            thread.join()
+
+    assert all(bits in {(41, 2), (41, 3), (81, 5)} for bits in calls)
+
+
+def test_invalid_arguments() -> None:
+    with pytest.raises(ValueError, match='non-negative'):
+        set_growth_hook(-1, None)
+    with pytest.raises(TypeError, match='callable'):
+        set_growth_hook(0, 1)  # type: ignore[arg-type]
@@ -0,0 +1,78 @@
+import pytest
+from hypothesis import given
+
+from cfractions import Fraction, simplest_between
+from tests.fraction_tests import strategies
+from tests.utils import is_fraction_valid
+
+
+@given(strategies.fractions, strategies.fractions)
+def test_basic(first: Fraction, second: Fraction) -> None:
+    lower_bound, upper_bound = sorted([first, second])
+
+    result = simplest_between(lower_bound, upper_bound)
+
+    assert isinstance(result, Fraction)
+    assert is_fraction_valid(result)
+    assert lower_bound <= result <= upper_bound
+
+
+@given(strategies.fractions, strategies.fractions)
+def test_exclusive(first: Fraction, second: Fraction) -> None:
+    lower_bound, upper_bound = sorted([first, second])
+    if lower_bound == upper_bound:
+        upper_bound += 1
+
+    result = simplest_between(lower_bound, upper_bound, inclusive=False)
+
+    assert is_fraction_valid(result)
+    assert lower_bound < result < upper_bound
+
+
+@given(
+    strategies.small_denominators_fractions,
+    strategies.small_denominators_fractions,
+)
+def test_minimality(first: Fraction, second: Fraction) -> None:
+    lower_bound, upper_bound = sorted([first, second])
+    if lower_bound == upper_bound:
+        upper_bound += Fraction(1, 1000)
+
+    for inclusive in (True, False):
+        result = simplest_between(
+            lower_bound, upper_bound, inclusive=inclusive
+        )
+
+        assert all(
+            (
+                (-lower_bound * denominator).__floor__()
+                + (upper_bound * denominator).__floor__()
+                < 0
+            )
+            if inclusive
+            else (
+                (lower_bound * denominator).__floor__() + 1
+                >= (upper_bound * denominator).__ceil__()
+            )
+            for denominator in range(1, result.denominator)
+        )
+
+
+@given(strategies.fractions)
+def test_integral_bounds(value: Fraction) -> None:
+    result = simplest_between(value.__floor__(), value.__ceil__())
+
+    assert result == (value.__floor__() if value >= 0 else value.__ceil__())
+
+
+@given(strategies.fractions)
+def test_empty(value: Fraction) -> None:
+    with pytest.raises(ValueError, match='empty'):
+        simplest_between(value, value, inclusive=False)
+    with pytest.raises(ValueError, match='empty'):
+        simplest_between(value + 1, value)
+
+
+def test_invalid_bounds() -> None:
+    with pytest.raises(TypeError, match='rational numbers'):
+        simplest_between(0.5, 1)  # type: ignore[arg-type]
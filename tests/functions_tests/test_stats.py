@@ -0,0 +1,81 @@
+from collections.abc import Iterator
+
+import pytest
+from hypothesis import given
+
+from cfractions import (
+    Fraction,
+    _disable_stats,
+    _enable_stats,
+    _reset_stats,
+    _stats,
+)
+from tests.fraction_tests import strategies
+
+
+@pytest.fixture
+def enabled_stats() -> Iterator[None]:
+    try:
+        _enable_stats()
+    except RuntimeError:
+        pytest.skip('statistics are not collected')
+    _reset_stats()
+    yield
+    _disable_stats()
+
+
+def test_reset() -> None:
+    _reset_stats()
+
+    result = _stats()
+
+    assert result['operations'] == {}
+    assert result['gcd_bits'] == {}
+    assert all(
+        value == 0
+        for key, value in result.items()
+        if key not in ('enabled', 'operations', 'gcd_bits')
+    )
+
+
+@pytest.mark.usefixtures('enabled_stats')
+@given(strategies.fractions, strategies.fractions)
+def test_operations(first: Fraction, second: Fraction) -> None:
+    key = 'add', 'Fraction', 'Fraction'
+    before = _stats()['operations'].get(key, 0)
+
+    first + second
+
+    assert _stats()['operations'][key] == before + 1
+
+
+@pytest.mark.usefixtures('enabled_stats')
+def test_gcd_bits() -> None:
+    Fraction(2**1000 + 1, 3) + Fraction(1, 5)
+
+    result = _stats()
+
+    assert result['enabled']
+    assert result['gcd_calls'] == sum(result['gcd_bits'].values()) > 0
+    assert max(result['gcd_bits']) >= 1000
+
+
+def test_disabled() -> None:
+    _disable_stats()
+    _reset_stats()
+
+    Fraction(1, 2) + Fraction(1, 3)
+
+    result = _stats()
+
+    assert not result['enabled']
+    assert result['operations'] == {}
+
+
+@pytest.mark.usefixtures('enabled_stats')
+def test_word_gcd_calls() -> None:
+    divmod(Fraction(7, 2), Fraction(5, 3))
+
+    result = _stats()
+
+    assert result['word_gcd_calls'] > 0
@@ -0,0 +1,187 @@
+from __future__ import annotations
+
+import copy
+import math
+import operator
+import pickle
+from collections.abc import Callable
+from typing import Any
+
+import pytest
+from hypothesis import given, strategies as st
+
+from cfractions import Fraction, LazyFraction
+from tests.fraction_tests import strategies
+
+operands = strategies.fractions | strategies.integers
+operations = st.sampled_from(
+    [operator.add, operator.sub, operator.mul, operator.truediv]
+)
+operations_chains = st.lists(st.tuples(operations, operands), max_size=20)
+comparisons = st.sampled_from(
+    [
+        operator.eq,
+        operator.ne,
+        operator.lt,
+        operator.le,
+        operator.gt,
+        operator.ge,
+    ]
+)
+
+
+def evaluate_chain(
+    start: Any, chain: list[tuple[Callable[[Any, Any], Any], Any]]
+) -> Any:
+    result = start
+    for operation, operand in chain:
+        if operation is operator.truediv and not operand:
+            continue
+        result = operation(result, operand)
+    return result
+
+
+@given(operands, operations_chains)
+def test_chain(
+    start: Fraction | int,
+    chain: list[tuple[Callable[[Any, Any], Any], Fraction | int]],
+) -> None:
+    result = evaluate_chain(LazyFraction(start), chain)
+
+    assert isinstance(result, LazyFraction)
+    assert (
+        result.as_integer_ratio()
+        == Fraction(evaluate_chain(Fraction(start), chain)).as_integer_ratio()
+    )
+
+
+@given(strategies.integers, strategies.denominators)
+def test_components(numerator: int, denominator: int) -> None:
+    result = LazyFraction(numerator, denominator)
+
+    assert result.denominator > 0
+    assert math.gcd(result.numerator, result.denominator) == 1
+    assert result.to_fraction() == Fraction(numerator, denominator)
+
+
+@given(operands, operands, comparisons)
+def test_comparisons(
+    first: Fraction | int,
+    second: Fraction | int,
+    comparison: Callable[[Any, Any], bool],
+) -> None:
+    assert comparison(LazyFraction(first), second) is comparison(first, second)
+    assert comparison(LazyFraction(first), LazyFraction(second)) is comparison(
+        first, second
+    )
+
+
+@given(operands, operands)
+def test_hash(first: Fraction | int, second: Fraction | int) -> None:
+    result = LazyFraction(first) * second / second if second else None
+
+    assert hash(LazyFraction(first)) == hash(Fraction(first))
+    assert result is None or hash(result) == hash(Fraction(first))
+
+
+@given(strategies.fractions, strategies.finite_floats)
+def test_float(first: Fraction, second: float) -> None:
+    assert float(LazyFraction(first)) == float(first)
+    assert LazyFraction(first) + second == first + second
+
+
+@given(strategies.integers, strategies.denominators, st.integers(1, 10))
+def test_rounding(numerator: int, denominator: int, scale: int) -> None:
+    fraction = Fraction(numerator, denominator)
+    lazy_fraction = LazyFraction(numerator * scale, denominator * scale)
+
+    assert math.floor(lazy_fraction) == math.floor(fraction)
+    assert math.ceil(lazy_fraction) == math.ceil(fraction)
+    assert math.trunc(lazy_fraction) == math.trunc(fraction)
+    assert int(lazy_fraction) == int(fraction)
+    assert round(lazy_fraction) == round(fraction)
+    assert round(lazy_fraction, 2) == round(fraction, 2)
+    assert round(lazy_fraction, -1) == round(fraction, -1)
+
+
+def test_rounding_of_unrepresentable_floats() -> None:
+    value = 10**30 + 1
+    lazy_fraction = LazyFraction(value * 3, 3)
+
+    assert math.floor(lazy_fraction) == value
+    assert math.ceil(lazy_fraction) == value
+    assert math.trunc(-lazy_fraction) == -value
+    assert int(lazy_fraction) == value
+    assert round(lazy_fraction) == value
+
+
+@given(strategies.fractions, strategies.non_zero_fractions)
+def test_integral_division(dividend: Fraction, divisor: Fraction) -> None:
+    lazy_dividend, lazy_divisor = LazyFraction(dividend), LazyFraction(divisor)
+
+    assert lazy_dividend // divisor == dividend // divisor
+    assert dividend // lazy_divisor == dividend // divisor
+    assert lazy_dividend // lazy_divisor == dividend // divisor
+    assert lazy_dividend % divisor == dividend % divisor
+    assert dividend % lazy_divisor == dividend % divisor
+    assert lazy_dividend % lazy_divisor == dividend % divisor
+    assert divmod(lazy_dividend, divisor) == divmod(dividend, divisor)
+    assert divmod(dividend, lazy_divisor) == divmod(dividend, divisor)
+    assert divmod(lazy_dividend, lazy_divisor) == divmod(dividend, divisor)
+
+
+@given(strategies.non_zero_fractions, st.integers(-5, 5))
+def test_power(base: Fraction, exponent: int) -> None:
+    assert LazyFraction(base) ** exponent == base**exponent
+    assert LazyFraction(base) ** LazyFraction(exponent) == base**exponent
+    assert base ** LazyFraction(exponent) == base**exponent
+    assert 2 ** LazyFraction(exponent) == 2 ** Fraction(exponent)
+
+
+@given(strategies.fractions, strategies.positive_integers)
+def test_limit_denominator(fraction: Fraction, max_denominator: int) -> None:
+    assert LazyFraction(fraction).limit_denominator(
+        max_denominator
+    ) == fraction.limit_denominator(max_denominator)
+
+
+@given(strategies.fractions)
+def test_repr_and_str(fraction: Fraction) -> None:
+    lazy_fraction = LazyFraction(
+        fraction.numerator * 3, fraction.denominator * 3
+    )
+
+    assert repr(lazy_fraction) == (
+        f'LazyFraction({fraction.numerator!r}, {fraction.denominator!r})'
+    )
+    assert str(lazy_fraction) == str(fraction)
+
+
+@given(strategies.fractions)
+def test_copies_and_pickle(fraction: Fraction) -> None:
+    lazy_fraction = LazyFraction(fraction) + 1
+
+    assert copy.copy(lazy_fraction) is lazy_fraction
+    assert copy.deepcopy(lazy_fraction) is lazy_fraction
+    assert pickle.loads(pickle.dumps(lazy_fraction)) == lazy_fraction
+
+
+def test_telescoping_sum() -> None:
+    result = LazyFraction(0)
+    for index in range(1, 2_000):
+        result += LazyFraction(1, index * (index + 1))
+
+    assert result == Fraction(1_999, 2_000)
+    assert (
+        max(result.numerator.bit_length(), result.denominator.bit_length())
+        < 16
+    )
+
+
+@given(strategies.fractions)
+def test_zero_division(fraction: Fraction) -> None:
+    with pytest.raises(ZeroDivisionError):
+        LazyFraction(fraction) / 0
+
+    with pytest.raises(ZeroDivisionError):
+        LazyFraction(1, 0)